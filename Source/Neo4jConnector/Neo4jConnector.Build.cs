@@ -46,6 +46,14 @@ public class Neo4jConnector : ModuleRules
 			);
 		
 		
+		//stub servers for the automation tests in Private/Tests
+		if (Target.Configuration != UnrealTargetConfiguration.Shipping)
+		{
+			PrivateDependencyModuleNames.Add("HTTPServer");
+		}
+
+		AddEngineThirdPartyPrivateStaticDependencies(Target, "zlib");
+
 		DynamicallyLoadedModuleNames.AddRange(
 			new string[]
 			{
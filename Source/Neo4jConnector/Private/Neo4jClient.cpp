@@ -0,0 +1,289 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Neo4jClient.h"
+
+#include "Async/Async.h"
+#include "Containers/Ticker.h"
+#include "Http.h"
+#include "Misc/Base64.h"
+#include "Neo4jJsonWriter.h"
+#include "Neo4jUtilities.h"
+
+
+TSharedRef<FNeo4jClient, ESPMode::ThreadSafe> FNeo4jClient::Create(const FString& baseURL, const FString& authorization, int32 maxRequestsInFlight)
+{
+	return _Create(new FNeo4jClient(baseURL, nullptr, authorization, maxRequestsInFlight));
+}
+
+TSharedRef<FNeo4jClient, ESPMode::ThreadSafe> FNeo4jClient::Create(FNeo4jClientRouter router, const FString& authorization, int32 maxRequestsInFlight)
+{
+	return _Create(new FNeo4jClient(FString(), MoveTemp(router), authorization, maxRequestsInFlight));
+}
+
+TSharedRef<FNeo4jClient, ESPMode::ThreadSafe> FNeo4jClient::_Create(FNeo4jClient* newClient)
+{
+	TSharedRef<FNeo4jClient, ESPMode::ThreadSafe> client = MakeShareable(newClient);
+
+	//the ticker isn't thread safe, register the pump from the game thread
+	TWeakPtr<FNeo4jClient, ESPMode::ThreadSafe> weakClient = client;
+	auto registerPump = [weakClient]()
+	{
+		TSharedPtr<FNeo4jClient, ESPMode::ThreadSafe> pinnedClient = weakClient.Pin();
+		if (pinnedClient.IsValid() && !pinnedClient->bShutdown)
+		{
+			pinnedClient->pumpHandle = FTicker::GetCoreTicker().AddTicker(
+				FTickerDelegate::CreateThreadSafeSP(pinnedClient.ToSharedRef(), &FNeo4jClient::_Pump));
+		}
+	};
+
+	if (IsInGameThread())
+		registerPump();
+	else
+		AsyncTask(ENamedThreads::GameThread, registerPump);
+
+	return client;
+}
+
+TSharedRef<FNeo4jClient, ESPMode::ThreadSafe> FNeo4jClient::Create(const FString& IP, const FString& HTTPport, const FString& user,
+	const FString& pass, int32 maxRequestsInFlight)
+{
+	return Create("http://" + IP + ":" + HTTPport, "Basic " + FBase64::Encode(user + ":" + pass), maxRequestsInFlight);
+}
+
+FNeo4jClient::FNeo4jClient(const FString& inBaseURL, FNeo4jClientRouter inRouter, const FString& inAuthorization, int32 inMaxRequestsInFlight)
+	: baseURL(inBaseURL)
+	, router(MoveTemp(inRouter))
+	, authorization(inAuthorization)
+	, maxRequestsInFlight(FMath::Max(1, inMaxRequestsInFlight))
+{
+}
+
+FNeo4jClient::~FNeo4jClient()
+{
+	//the ticker delegate is bound weakly and unregisters itself once the client is gone
+	FSubmissionPtr submission;
+	while (submissions.Dequeue(submission))
+		_Complete(submission, FNeo4jClientResult());
+}
+
+void FNeo4jClient::Query(const TArray<FString>& queryStrings, bool bParseNodes, FNeo4jClientCallback onComplete,
+	ENamedThreads::Type completionThread, bool bReadOnly)
+{
+	FSubmissionPtr submission = MakeShared<FSubmission, ESPMode::ThreadSafe>();
+	submission->bParseNodes = bParseNodes;
+	submission->bReadOnly = bReadOnly;
+	submission->onComplete = MoveTemp(onComplete);
+	submission->completionThread = completionThread;
+
+	_Submit(queryStrings, submission);
+}
+
+TFuture<FNeo4jClientResult> FNeo4jClient::Query(const TArray<FString>& queryStrings, bool bParseNodes, bool bReadOnly)
+{
+	FSubmissionPtr submission = MakeShared<FSubmission, ESPMode::ThreadSafe>();
+	submission->bParseNodes = bParseNodes;
+	submission->bReadOnly = bReadOnly;
+	submission->promise = MakeShared<TPromise<FNeo4jClientResult>, ESPMode::ThreadSafe>();
+
+	TFuture<FNeo4jClientResult> future = submission->promise->GetFuture();
+	_Submit(queryStrings, submission);
+
+	return future;
+}
+
+TFuture<FNeo4jClientResult> FNeo4jClient::GetNodesByID(const TArray<int>& elementIDs)
+{
+	TArray<FString> queryArray;
+	queryArray.Add("unwind " + UNeo4jUtilities::SerializeIDsIntoQuery(elementIDs) + " as n");
+	queryArray.Add("match(m) where id(m) = n");
+	queryArray.Add("return m, labels(m)");
+
+	return Query(queryArray, true, true);
+}
+
+TFuture<FNeo4jClientResult> FNeo4jClient::GetNodesByLabels(const TArray<FString>& labels)
+{
+	TArray<FString> queryArray;
+	queryArray.Add("Match (" + UNeo4jUtilities::SerializeLabelsIntoQuery(labels) + ")");
+	queryArray.Add("return m, labels(m)");
+
+	return Query(queryArray, true, true);
+}
+
+TFuture<FNeo4jClientResult> FNeo4jClient::GetNeighbours(int nodeID, const TArray<FString>& relationTypes, ENeo4jDirection direction)
+{
+	TArray<FString> queryArray;
+	queryArray.Add(FString::Printf(TEXT("Match (p) where id(p) = %d"), nodeID));
+	queryArray.Add("match (p) " + UNeo4jUtilities::SerializeRelationPattern(relationTypes, direction) + " (m)");
+	queryArray.Add("return m, labels(m)");
+
+	return Query(queryArray, true, true);
+}
+
+void FNeo4jClient::Shutdown()
+{
+	bShutdown = true;
+
+	//the queue has a single consumer, which is the game thread
+	TWeakPtr<FNeo4jClient, ESPMode::ThreadSafe> weakClient = AsShared();
+	auto stopPump = [weakClient]()
+	{
+		TSharedPtr<FNeo4jClient, ESPMode::ThreadSafe> pinnedClient = weakClient.Pin();
+		if (!pinnedClient.IsValid())
+			return;
+
+		if (pinnedClient->pumpHandle.IsValid())
+		{
+			FTicker::GetCoreTicker().RemoveTicker(pinnedClient->pumpHandle);
+			pinnedClient->pumpHandle.Reset();
+		}
+
+		pinnedClient->_Drain();
+	};
+
+	if (IsInGameThread())
+		stopPump();
+	else
+		AsyncTask(ENamedThreads::GameThread, stopPump);
+}
+
+void FNeo4jClient::_Submit(const TArray<FString>& queryStrings, FSubmissionPtr submission)
+{
+	FString queryList;
+	for (auto& string : queryStrings)
+		queryList = queryList + "\n" + string;
+
+	FNeo4jJsonWriter writer(submission->body);
+	writer.BeginStatements();
+	writer.WriteStatement(queryList);
+	writer.EndStatements();
+
+	numPending.Increment();
+	submissions.Enqueue(submission);
+
+	//the flag is checked after enqueueing, so either Shutdown set it later and its drain finds the submission, or
+	//this sees it and drains itself. Both are atomic with full barriers, so no lock is needed to close the gap
+	if (bShutdown)
+	{
+		TWeakPtr<FNeo4jClient, ESPMode::ThreadSafe> weakClient = AsShared();
+		auto drain = [weakClient]()
+		{
+			TSharedPtr<FNeo4jClient, ESPMode::ThreadSafe> pinnedClient = weakClient.Pin();
+			if (pinnedClient.IsValid())
+				pinnedClient->_Drain();
+		};
+
+		if (IsInGameThread())
+			drain();
+		else
+			AsyncTask(ENamedThreads::GameThread, drain);
+	}
+}
+
+bool FNeo4jClient::_Pump(float deltaTime)
+{
+	FSubmissionPtr submission;
+	while (numInFlight < maxRequestsInFlight && !bShutdown && submissions.Dequeue(submission))
+		_Send(submission);
+
+	return true;
+}
+
+void FNeo4jClient::_Drain()
+{
+	FSubmissionPtr submission;
+	while (submissions.Dequeue(submission))
+	{
+		numPending.Decrement();
+		_Complete(submission, FNeo4jClientResult());
+	}
+}
+
+void FNeo4jClient::_Send(FSubmissionPtr submission)
+{
+	FString url = baseURL;
+	TFunction<void()> onResponse;
+	if (router)
+		url = router(submission->bReadOnly, onResponse);
+
+	if (url.IsEmpty())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Thread safe client has no endpoint to send to"));
+		numPending.Decrement();
+		_Complete(submission, FNeo4jClientResult());
+		return;
+	}
+
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> httpRequest = FHttpModule::Get().CreateRequest();
+	httpRequest->SetURL(url + "/db/neo4j/tx/commit");
+	httpRequest->SetHeader("Authorization", authorization);
+	httpRequest->SetHeader("Accept", "application/json;charset=UTF-8");
+	httpRequest->SetHeader("Content-Type", "application/json");
+	httpRequest->SetVerb("POST");
+
+	httpRequest->SetContent(MoveTemp(submission->body));
+	submission->body.Empty();
+
+	numInFlight++;
+
+	//the response callback runs on the game thread, the client may be gone by then
+	TWeakPtr<FNeo4jClient, ESPMode::ThreadSafe> weakClient = AsShared();
+	httpRequest->OnProcessRequestComplete().BindLambda([weakClient, submission, onResponse = MoveTemp(onResponse)](FHttpRequestPtr Request,
+		FHttpResponsePtr Response, bool bWasSuccessful)
+	{
+		if (onResponse)
+			onResponse();
+
+		TSharedPtr<FNeo4jClient, ESPMode::ThreadSafe> pinnedClient = weakClient.Pin();
+		if (pinnedClient.IsValid())
+		{
+			pinnedClient->numInFlight--;
+			pinnedClient->numPending.Decrement();
+		}
+
+		FNeo4jClientResult result;
+		if (bWasSuccessful && Response.IsValid())
+		{
+			result.responseCode = Response->GetResponseCode();
+			result.content = Response->GetContentAsString();
+			result.bSucceeded = EHttpResponseCodes::IsOk(result.responseCode);
+		}
+
+		_Complete(submission, MoveTemp(result));
+	});
+
+	httpRequest->ProcessRequest();
+}
+
+void FNeo4jClient::_Complete(FSubmissionPtr submission, FNeo4jClientResult&& result)
+{
+	//parsing never runs on the game thread
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [submission, result = MoveTemp(result)]() mutable
+	{
+		if (result.bSucceeded && UNeo4jUtilities::HasQueryErrors(result.content))
+			result.bSucceeded = false;
+
+		if (result.bSucceeded && submission->bParseNodes)
+			result.nodes = UNeo4jUtilities::DeserializeNodeQueryResult(result.content);
+
+		if (submission->promise.IsValid() || submission->completionThread == ENamedThreads::AnyBackgroundThreadNormalTask)
+		{
+			_Finish(submission, result);
+			return;
+		}
+
+		AsyncTask(submission->completionThread, [submission, result = MoveTemp(result)]() mutable
+		{
+			_Finish(submission, result);
+		});
+	});
+}
+
+void FNeo4jClient::_Finish(FSubmissionPtr submission, FNeo4jClientResult& result)
+{
+	if (submission->promise.IsValid())
+		submission->promise->SetValue(MoveTemp(result));
+	else if (submission->onComplete)
+		submission->onComplete(result);
+}
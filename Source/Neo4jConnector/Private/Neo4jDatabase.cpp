@@ -3,18 +3,191 @@
 
 #include "Neo4jDatabase.h"
 
+#include "Containers/Ticker.h"
+#include "Neo4jJsonWriter.h"
+#include "Neo4jSnapshot.h"
 #include "Neo4jUtilities.h"
 
+//supersede key of debounced searches, a newer one cancels the one in flight
+static const TCHAR* const FULLTEXT_SUPERSEDE_KEY = TEXT("_Neo4jFullTextSearch");
+
 #pragma region GENERAL_FUNCTIONS
 
 void UNeo4jDatabase::InitializeDatabase(FString IP, FString HTTPport, FString user, FString pass)
 {
-	URL = "http://" + IP + ":" + HTTPport + "/db/neo4j/tx";
+	FNeo4jEndpoint endpoint;
+	endpoint.IP = IP;
+	endpoint.HTTPport = HTTPport;
+	endpoint.role = ENeo4jEndpointRole::Writer;
+
+	InitializeCluster({ endpoint }, user, pass);
+}
+
+void UNeo4jDatabase::InitializeCluster(TArray<FNeo4jEndpoint> clusterEndpoints, FString user, FString pass)
+{
+	endpoints.Reset();
+	for (auto& endpoint : clusterEndpoints)
+	{
+		FNeo4jEndpointState& state = endpoints.AddDefaulted_GetRef();
+		state.endpoint = endpoint;
+		state.baseURL = "http://" + endpoint.IP + ":" + endpoint.HTTPport;
+	}
+
+	//requests still in flight belong to the old endpoint list
+	for (auto& pending : pendingRequests)
+		pending.Value.endpoint = INDEX_NONE;
 
+	nextReader = 0;
 
 	b64Auth = FBase64::Encode(user.Append(":").Append(pass));
 	b64Auth = "Basic " + b64Auth;
 
+	if (bEnsureIndexesOnInitialize)
+		EnsureIndexes();
+}
+
+void UNeo4jDatabase::InitializeDatabaseAsync(FString IP, FString HTTPport, FString user, FString pass)
+{
+	FNeo4jEndpoint endpoint;
+	endpoint.IP = IP;
+	endpoint.HTTPport = HTTPport;
+	endpoint.role = ENeo4jEndpointRole::Writer;
+
+	InitializeClusterAsync({ endpoint }, user, pass);
+}
+
+void UNeo4jDatabase::InitializeClusterAsync(TArray<FNeo4jEndpoint> clusterEndpoints, FString user, FString pass)
+{
+	InitializeCluster(clusterEndpoints, user, pass);
+
+	//a newer initialization replaces one still running
+	if (initializeTimeoutHandle.IsValid())
+		FTicker::GetCoreTicker().RemoveTicker(initializeTimeoutHandle);
+
+	initializeSerial++;
+	pendingInitializeSteps = 0;
+	bCredentialsVerified = false;
+	bCatalogFetched = false;
+	bDatabaseReady = false;
+	initializeError.Empty();
+
+	if (endpoints.Num() == 0)
+	{
+		_FinishInitialize(false, TEXT("No endpoints configured"));
+		return;
+	}
+
+	initializeTimeoutHandle = FTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateUObject(this, &UNeo4jDatabase::_OnInitializeTimeout, initializeSerial), initializeTimeoutSeconds);
+
+	//the cheapest possible transaction, sent several times at once so the http layer opens that many connections
+	TArray<uint8> connectionBody;
+	FNeo4jJsonWriter connectionWriter(connectionBody);
+	connectionWriter.BeginStatements();
+	connectionWriter.WriteStatement(TEXT("RETURN 1"), true);
+	connectionWriter.EndStatements();
+
+	//explained queries are planned and cached without running, so writes can be primed too. One transaction each,
+	//a statement that fails to plan rolls its transaction back and the statements after it would never be planned
+	TArray<TArray<uint8>> warmupBodies;
+	for (auto& query : warmupQueries)
+	{
+		FNeo4jJsonWriter warmupWriter(warmupBodies.AddDefaulted_GetRef());
+		warmupWriter.BeginStatements();
+		warmupWriter.WriteStatement("EXPLAIN " + query, true);
+		warmupWriter.EndStatements();
+	}
+
+	for (int32 i = 0; i < endpoints.Num(); i++)
+	{
+		for (int32 connection = 0; connection < FMath::Max(1, warmupConnections); connection++)
+		{
+			TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+			HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnWarmupConnection, initializeSerial, i);
+			pendingInitializeSteps++;
+			_SendToEndpoint(i, connectionBody, HttpRequest);
+		}
+
+		for (int32 query = 0; query < warmupBodies.Num(); query++)
+		{
+			TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+			HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnWarmupQuery, initializeSerial, i, warmupQueries[query]);
+			pendingInitializeSteps++;
+			_SendToEndpoint(i, warmupBodies[query], HttpRequest);
+		}
+	}
+
+	TArray<FString> statements;
+	statements.Add("call db.labels() yield label return collect(label)");
+	statements.Add("call db.relationshipTypes() yield relationshipType return collect(relationshipType)");
+	statements.Add("call db.propertyKeys() yield propertyKey return collect(propertyKey)");
+
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnSchemaCatalog, initializeSerial);
+	pendingInitializeSteps++;
+	_SendStatements(statements, HttpRequest, TEXT("SchemaCatalog"), true);
+}
+
+TSharedRef<FNeo4jClient, ESPMode::ThreadSafe> UNeo4jDatabase::CreateThreadSafeClient()
+{
+	if (endpoints.Num() == 0)
+		UE_LOG(LogTemp, Error, TEXT("Thread safe client created before the database was initialized"));
+
+	//every query is routed when it is sent, so the client follows health changes and counts towards endpoint load
+	TWeakObjectPtr<UNeo4jDatabase> weakThis(this);
+	return FNeo4jClient::Create([weakThis](bool bReadOnly, TFunction<void()>& outOnResponse) -> FString
+	{
+		UNeo4jDatabase* database = weakThis.Get();
+		if (!database)
+			return FString();
+
+		int32 endpoint = database->_PickEndpoint(bReadOnly);
+		if (endpoint == INDEX_NONE)
+			return FString();
+
+		FNeo4jEndpointState& state = database->endpoints[endpoint];
+		state.outstandingRequests++;
+
+		FString baseURL = state.baseURL;
+		outOnResponse = [weakThis, baseURL]()
+		{
+			UNeo4jDatabase* respondingDatabase = weakThis.Get();
+			if (!respondingDatabase)
+				return;
+
+			//endpoints may have been replaced by a new initialization since
+			for (auto& endpointState : respondingDatabase->endpoints)
+			{
+				if (endpointState.baseURL == baseURL && endpointState.outstandingRequests > 0)
+				{
+					endpointState.outstandingRequests--;
+					break;
+				}
+			}
+		};
+
+		return baseURL;
+	}, b64Auth);
+}
+
+void UNeo4jDatabase::CheckEndpointHealth()
+{
+	for (int32 i = 0; i < endpoints.Num(); i++)
+		_ProbeEndpoint(i);
+}
+
+TArray<FNeo4jEndpointStatus> UNeo4jDatabase::GetEndpointStatus() const
+{
+	TArray<FNeo4jEndpointStatus> outStatus;
+	for (auto& state : endpoints)
+	{
+		FNeo4jEndpointStatus& status = outStatus.AddDefaulted_GetRef();
+		status.endpoint = state.endpoint;
+		status.outstandingRequests = state.outstandingRequests;
+		status.bHealthy = state.bHealthy;
+	}
+
+	return outStatus;
 }
 
 
@@ -25,13 +198,225 @@ void UNeo4jDatabase::QueryStrings(TArray<FString> queries)
 	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> httpRequest = FHttpModule::Get().CreateRequest();
 	httpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnStringQueryProcessed);
 	
-	QueryStrings(queries, httpRequest);
+	_QueryStrings(queries, httpRequest, TEXT("QueryStrings"));
+}
+
+
+
+TSharedPtr<const FNeo4jResultSet> UNeo4jDatabase::GetResultSet(ENeo4jResultSlot slot) const
+{
+	return resultSets[(int)slot];
+}
+
+TArray<FNeo4jNode> UNeo4jDatabase::GetResultSetNodes(ENeo4jResultSlot slot) const
+{
+	const TSharedPtr<FNeo4jResultSet>& resultSet = resultSets[(int)slot];
+	return resultSet.IsValid() ? resultSet->ToNodes() : TArray<FNeo4jNode>();
+}
+
+void UNeo4jDatabase::ReleaseResults(ENeo4jResultSlot slot)
+{
+	CancelDelivery(slot);
+	resultSetPool.Release(resultSets[(int)slot]);
+	_GetOutputArray(slot).Empty();
+}
+
+void UNeo4jDatabase::ReleaseAllResults(bool bTrimPool)
+{
+	for (int slot = 0; slot < (int)ENeo4jResultSlot::MAX; slot++)
+		ReleaseResults((ENeo4jResultSlot)slot);
+
+	if (bTrimPool)
+		resultSetPool.Trim();
+}
+
+TArray<FNeo4jQueryPlan> UNeo4jDatabase::GetSlowestPlans(FString operation) const
+{
+	const TArray<FNeo4jQueryPlan>* plans = slowestPlans.Find(operation);
+	return plans ? *plans : TArray<FNeo4jQueryPlan>();
+}
+
+void UNeo4jDatabase::LogSlowestPlans()
+{
+	for (auto& pair : slowestPlans)
+	{
+		for (auto& plan : pair.Value)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s: %.2f ms, %lld db hits\n%s"), *plan.operation, plan.elapsedSeconds * 1000.f, plan.totalDbHits, *plan.query);
+
+			for (auto& planOperator : plan.operators)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("%s%s estimated rows: %.0f rows: %lld db hits: %lld"), *FString::ChrN(planOperator.depth * 2, ' '),
+					*planOperator.operatorType, planOperator.estimatedRows, planOperator.rows, planOperator.dbHits);
+			}
+		}
+	}
+}
+
+void UNeo4jDatabase::ClearQueryPlans()
+{
+	slowestPlans.Empty();
+}
+
+void UNeo4jDatabase::CancelDelivery(ENeo4jResultSlot slot)
+{
+	deliveries.RemoveAll([slot](const FNeo4jNodeDelivery& delivery) { return delivery.slot == slot; });
+}
+
+void UNeo4jDatabase::SetNextRequestOptions(FNeo4jRequestOptions options)
+{
+	nextRequestOptions = options;
+}
+
+bool UNeo4jDatabase::CancelRequest(int requestID)
+{
+	for (auto& pending : pendingRequests)
+	{
+		if (pending.Value.requestID == requestID)
+			return _CancelPendingRequest(pending.Key, false);
+	}
+
+	return false;
 }
 
+int UNeo4jDatabase::CancelRequestsByKey(FString supersedeKey)
+{
+	if (supersedeKey.IsEmpty())
+		return 0;
+
+	//cancelling broadcasts, so the map can change under an iterator
+	TArray<const IHttpRequest*> keys;
+	for (auto& pending : pendingRequests)
+	{
+		if (pending.Value.supersedeKey == supersedeKey)
+			keys.Add(pending.Key);
+	}
+
+	int cancelled = 0;
+	for (auto* key : keys)
+		cancelled += _CancelPendingRequest(key, false) ? 1 : 0;
+
+	return cancelled;
+}
+
+int UNeo4jDatabase::CancelAllRequests()
+{
+	TArray<const IHttpRequest*> keys;
+	pendingRequests.GetKeys(keys);
+
+	int cancelled = 0;
+	for (auto* key : keys)
+		cancelled += _CancelPendingRequest(key, false) ? 1 : 0;
+
+	return cancelled;
+}
+
+int UNeo4jDatabase::GetNumPendingRequests() const
+{
+	return pendingRequests.Num();
+}
+
+void UNeo4jDatabase::BeginDestroy()
+{
+	if (deadlineTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(deadlineTickerHandle);
+		deadlineTickerHandle.Reset();
+	}
+
+	if (fullTextDebounceHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(fullTextDebounceHandle);
+		fullTextDebounceHandle.Reset();
+	}
+
+	if (cancelBroadcastHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(cancelBroadcastHandle);
+		cancelBroadcastHandle.Reset();
+	}
+
+	if (deliveryTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(deliveryTickerHandle);
+		deliveryTickerHandle.Reset();
+	}
 
+	if (initializeTimeoutHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(initializeTimeoutHandle);
+		initializeTimeoutHandle.Reset();
+	}
+
+	Super::BeginDestroy();
+}
 
 #pragma endregion GENERAL_FUNCTIONS
 
+
+#pragma region TEMPLATE_FUNCTIONS
+
+bool UNeo4jDatabase::RegisterQueryTemplate(FString name, FString statement, TArray<FNeo4jParameterDeclaration> parameters)
+{
+	if (name.IsEmpty() || queryTemplates.Contains(name))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Query template name '%s' is empty or already registered"), *name);
+		return false;
+	}
+
+	queryTemplates.Add(name, UNeo4jUtilities::MakeQueryTemplate(name, statement, parameters));
+	return true;
+}
+
+void UNeo4jDatabase::UnregisterQueryTemplate(FString name)
+{
+	queryTemplates.Remove(name);
+}
+
+void UNeo4jDatabase::ExecuteQueryTemplate(FString name, const FNeo4jQueryParameters& parameters)
+{
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> httpRequest = FHttpModule::Get().CreateRequest();
+	httpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnTemplateQuery);
+
+	ExecuteQueryTemplate(name, parameters, httpRequest);
+}
+
+bool UNeo4jDatabase::ExecuteQueryTemplate(const FString& name, const FNeo4jQueryParameters& parameters,
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> httpRequest)
+{
+	const FNeo4jQueryTemplate* queryTemplate = queryTemplates.Find(name);
+	if (!queryTemplate)
+	{
+		UE_LOG(LogTemp, Error, TEXT("No query template named %s"), *name);
+		return false;
+	}
+
+	//the cached body has no room for a prefix, profiled runs build a one off template instead
+	FString statement = queryTemplate->statement;
+	requestBody.Reset();
+	if (profileMode != ENeo4jProfileMode::None)
+	{
+		statement = (profileMode == ENeo4jProfileMode::Explain ? "EXPLAIN " : "PROFILE ") + statement;
+		requestBody.Append(UNeo4jUtilities::MakeQueryTemplate(name, statement, queryTemplate->parameters).bodyPrefix);
+	}
+	else
+	{
+		requestBody.Append(queryTemplate->bodyPrefix);
+	}
+
+	FNeo4jJsonWriter writer(requestBody);
+	if (!UNeo4jUtilities::SerializeTemplateParameters(*queryTemplate, parameters, writer))
+		return false;
+
+	requestBody.Append(queryTemplate->bodySuffix);
+
+	_TrackRequest(httpRequest, "Template:" + name, statement, profileMode != ENeo4jProfileMode::None);
+	_SendQuery(MoveTemp(requestBody), httpRequest);
+	return true;
+}
+
+#pragma endregion TEMPLATE_FUNCTIONS
+
 #pragma region NODE_FUNCTIONS
 
 void UNeo4jDatabase::CreateNode(TArray<FString> labels, TMap<FString, FString> stringProperties, TMap<FString, int> intProperties,
@@ -41,15 +426,17 @@ void UNeo4jDatabase::CreateNode(TArray<FString> labels, TMap<FString, FString> s
 	TArray<FString> queryArray;
 
 	FString query = "Create (" + UNeo4jUtilities::SerializeLabelsIntoQuery(labels) +
-		UNeo4jUtilities::SerializePropertiesIntoQuery(stringProperties, intProperties, boolProperties) + ") return m";
+		UNeo4jUtilities::SerializePropertiesIntoQuery(stringProperties, intProperties, boolProperties) + ")";
 
 	queryArray.Add(query);
+	_AppendChangeMarker(queryArray, "m");
+	queryArray.Add("return m, labels(m)");
 
 	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> httpRequest = FHttpModule::Get().CreateRequest();
 	httpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnCreateNode);
 
 
-	QueryStrings(queryArray, httpRequest);
+	_QueryStrings(queryArray, httpRequest, TEXT("CreateNode"));
 }
 
 void UNeo4jDatabase::MergeNode(TArray<FString> labels, TMap<FString, FString> stringProperties,
@@ -58,14 +445,16 @@ void UNeo4jDatabase::MergeNode(TArray<FString> labels, TMap<FString, FString> st
 	TArray<FString> queryArray;
 
 	FString query = "Merge (" + UNeo4jUtilities::SerializeLabelsIntoQuery(labels) +
-		UNeo4jUtilities::SerializePropertiesIntoQuery(stringProperties, intProperties, boolProperties) + ") return m";
+		UNeo4jUtilities::SerializePropertiesIntoQuery(stringProperties, intProperties, boolProperties) + ")";
 
 	queryArray.Add(query);
+	_AppendChangeMarker(queryArray, "m");
+	queryArray.Add("return m, labels(m)");
 
 	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> httpRequest = FHttpModule::Get().CreateRequest();
 	httpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnMergeNode);
 
-	QueryStrings(queryArray, httpRequest);
+	_QueryStrings(queryArray, httpRequest, TEXT("MergeNode"));
 }
 
 void UNeo4jDatabase::DeleteNodesByProperties(TArray<FString> labels, TMap<FString, FString> stringProperties, TMap<FString, int> intProperties, TMap<FString, bool> boolProperties)
@@ -76,10 +465,11 @@ void UNeo4jDatabase::DeleteNodesByProperties(TArray<FString> labels, TMap<FStrin
 		+ UNeo4jUtilities::SerializePropertiesIntoQuery(stringProperties, intProperties, boolProperties) + ")";
 
 	queryArray.Add(matchQuery);
+	_AppendTombstone(queryArray, "m");
 	queryArray.Add("detach delete m");
 
 	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> httpRequest = FHttpModule::Get().CreateRequest();
-	QueryStrings(queryArray, httpRequest);
+	_QueryStrings(queryArray, httpRequest, TEXT("DeleteNodesByProperties"));
 
 }
 
@@ -109,12 +499,12 @@ void UNeo4jDatabase::GetNodesByID(TArray<int> elementIDs)
 	queryArray.Add(queryString);
 	queryArray.Add("unwind range as n");
 	queryArray.Add("match(m) where id(m) = n");
-	queryArray.Add("return m");
+	queryArray.Add("return m, labels(m)");
 
 	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
 	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnGetNode);
 
-	QueryStrings(queryArray, HttpRequest);
+	_QueryStrings(queryArray, HttpRequest, TEXT("GetNodesByID"), true);
 
 
 
@@ -148,11 +538,12 @@ void UNeo4jDatabase::AddPropertiesToNodes(TArray<int> elementIDs, TMap<FString,
 	queryArray.Add("match(m) where id(m) = n");
 	FString setString = "set m += " + UNeo4jUtilities::SerializePropertiesIntoQuery(stringProperties, intProperties, boolProperties);
 	queryArray.Add(setString);
+	_AppendChangeMarker(queryArray, "m");
 
 	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
 	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnUpdateNode);
 
-	QueryStrings(queryArray, HttpRequest);
+	_QueryStrings(queryArray, HttpRequest, TEXT("AddPropertiesToNodes"));
 }
 
 void UNeo4jDatabase::RemovePropertiesFromNodes(TArray<int> elementIDs, TArray<FString> propertiesToRemove)
@@ -189,12 +580,13 @@ void UNeo4jDatabase::RemovePropertiesFromNodes(TArray<int> elementIDs, TArray<FS
 	{
 		queryArray.Add("remove m." + prop);
 	}
+	_AppendChangeMarker(queryArray, "m");
 
 
 	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
 	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnUpdateNode);
 
-	QueryStrings(queryArray, HttpRequest);
+	_QueryStrings(queryArray, HttpRequest, TEXT("RemovePropertiesFromNodes"));
 }
 
 void UNeo4jDatabase::AddLabelsToNodes(TArray<int> elementIDs, TArray<FString> Labels)
@@ -229,11 +621,12 @@ void UNeo4jDatabase::AddLabelsToNodes(TArray<int> elementIDs, TArray<FString> La
 	{
 		queryArray.Add("set m:" + label);
 	}
+	_AppendChangeMarker(queryArray, "m");
 
 	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
 	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnUpdateNode);
 
-	QueryStrings(queryArray, HttpRequest);
+	_QueryStrings(queryArray, HttpRequest, TEXT("AddLabelsToNodes"));
 
 }
 
@@ -264,16 +657,20 @@ void UNeo4jDatabase::RemoveLabelsFromNodes(TArray<int> elementIDs, TArray<FStrin
 	queryArray.Add(queryString);
 	queryArray.Add("unwind range as n");
 	queryArray.Add("match(m) where id(m) = n");
+	if (bStampChangeMarkers)
+		queryArray.Add("with m, labels(m) as __labelsBefore");
 
 	for (auto& label : Labels)
 	{
 		queryArray.Add("remove m:" + label);
 	}
+	_AppendChangeMarker(queryArray, "m");
+	_AppendLabelRemoval(queryArray, "m", "[label in __labelsBefore where not label in labels(m)]");
 
 	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
 	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnUpdateNode);
 
-	QueryStrings(queryArray, HttpRequest);
+	_QueryStrings(queryArray, HttpRequest, TEXT("RemoveLabelsFromNodes"));
 }
 
 void UNeo4jDatabase::DeleteNodesByID(TArray<int> elementIDs)
@@ -302,24 +699,25 @@ void UNeo4jDatabase::DeleteNodesByID(TArray<int> elementIDs)
 	queryArray.Add(queryString);
 	queryArray.Add("unwind range as n");
 	queryArray.Add("match(m) where id(m) = n");
+	_AppendTombstone(queryArray, "m");
 	queryArray.Add("detach delete m");
 
 	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
 	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnGetNode);
 
-	QueryStrings(queryArray, HttpRequest);
+	_QueryStrings(queryArray, HttpRequest, TEXT("DeleteNodesByID"));
 }
 
 void UNeo4jDatabase::GetNodesByLabels(TArray<FString> Labels)
 {
 	TArray<FString> queryArray;
 	queryArray.Add("Match (" + UNeo4jUtilities::SerializeLabelsIntoQuery(Labels) + ")");
-	queryArray.Add("return m");
+	queryArray.Add("return m, labels(m)");
 
 	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
 	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnGetNeighbour);
 
-	QueryStrings(queryArray, HttpRequest);
+	_QueryStrings(queryArray, HttpRequest, TEXT("GetNodesByLabels"), true);
 }
 
 
@@ -331,12 +729,12 @@ void UNeo4jDatabase::GetNodeNeighbours(int nodeID)
 	matchString.AppendInt(nodeID);
 
 	queryArray.Add(matchString);
-	queryArray.Add("match (m) -- (n) return n");
+	queryArray.Add("match (m) -- (n) return n, labels(n)");
 
 	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
 	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnGetNeighbour);
 
-	QueryStrings(queryArray, HttpRequest);
+	_QueryStrings(queryArray, HttpRequest, TEXT("GetNodeNeighbours"), true);
 
 }
 
@@ -348,12 +746,12 @@ void UNeo4jDatabase::GetNodeNeighboursByTypes(int nodeID, TArray<FString> relati
 	matchString.AppendInt(nodeID);
 
 	queryArray.Add(matchString);
-	queryArray.Add("match (p) -[" + UNeo4jUtilities::SerializeLabelsIntoQuery(relationType) + "]- (n) return n");
+	queryArray.Add("match (p) -[" + UNeo4jUtilities::SerializeLabelsIntoQuery(relationType) + "]- (n) return n, labels(n)");
 
 	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
 	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnGetNeighbour);
 
-	QueryStrings(queryArray, HttpRequest);
+	_QueryStrings(queryArray, HttpRequest, TEXT("GetNodeNeighboursByTypes"), true);
 }
 
 void UNeo4jDatabase::GetIncomingNeighboursFromNode(int nodeID)
@@ -364,12 +762,12 @@ void UNeo4jDatabase::GetIncomingNeighboursFromNode(int nodeID)
 	matchString.AppendInt(nodeID);
 
 	queryArray.Add(matchString);
-	queryArray.Add("match (p) <-- (n) return n");
+	queryArray.Add("match (p) <-- (n) return n, labels(n)");
 
 	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
 	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnGetNeighbour);
 
-	QueryStrings(queryArray, HttpRequest);
+	_QueryStrings(queryArray, HttpRequest, TEXT("GetIncomingNeighboursFromNode"), true);
 }
 
 void UNeo4jDatabase::GetOutgoingNeighboursFromNode(int nodeID)
@@ -380,12 +778,12 @@ void UNeo4jDatabase::GetOutgoingNeighboursFromNode(int nodeID)
 	matchString.AppendInt(nodeID);
 
 	queryArray.Add(matchString);
-	queryArray.Add("match (p) --> (n) return n");
+	queryArray.Add("match (p) --> (n) return n, labels(n)");
 
 	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
 	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnGetNeighbour);
 
-	QueryStrings(queryArray, HttpRequest);
+	_QueryStrings(queryArray, HttpRequest, TEXT("GetOutgoingNeighboursFromNode"), true);
 }
 
 void UNeo4jDatabase::GetIncomingNeighboursByTypes(int nodeID, TArray<FString> relationTypes)
@@ -396,12 +794,12 @@ void UNeo4jDatabase::GetIncomingNeighboursByTypes(int nodeID, TArray<FString> re
 	matchString.AppendInt(nodeID);
 
 	queryArray.Add(matchString);
-	queryArray.Add("match (p) <-[" + UNeo4jUtilities::SerializeLabelsIntoQuery(relationTypes) + "]- (n) return n");
+	queryArray.Add("match (p) <-[" + UNeo4jUtilities::SerializeLabelsIntoQuery(relationTypes) + "]- (n) return n, labels(n)");
 
 	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
 	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnGetNeighbour);
 
-	QueryStrings(queryArray, HttpRequest);
+	_QueryStrings(queryArray, HttpRequest, TEXT("GetIncomingNeighboursByTypes"), true);
 }
 
 
@@ -413,12 +811,76 @@ void UNeo4jDatabase::GetOutgoingNeighboursByTypes(int nodeID, TArray<FString> re
 	matchString.AppendInt(nodeID);
 
 	queryArray.Add(matchString);
-	queryArray.Add("match (p) -[" + UNeo4jUtilities::SerializeLabelsIntoQuery(relationTypes) + "]-> (n) return n");
+	queryArray.Add("match (p) -[" + UNeo4jUtilities::SerializeLabelsIntoQuery(relationTypes) + "]-> (n) return n, labels(n)");
 
 	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
 	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnGetNeighbour);
 
-	QueryStrings(queryArray, HttpRequest);
+	_QueryStrings(queryArray, HttpRequest, TEXT("GetOutgoingNeighboursByTypes"), true);
+}
+
+void UNeo4jDatabase::GetNeighboursBatch(TArray<int> nodeIDs, TArray<FString> relationTypes, ENeo4jDirection direction)
+{
+	//no sources, no neighbours. Still completes so callers waiting on the delegate carry on
+	if (nodeIDs.Num() == 0)
+	{
+		neighbourBatchQueryOutput.Reset();
+		OnNeighbourBatchCompleteDelegate.Broadcast();
+		return;
+	}
+
+	TArray<FString> queryArray;
+	queryArray.Add("unwind " + UNeo4jUtilities::SerializeIDsIntoQuery(nodeIDs) + " as sourceID");
+	queryArray.Add("match (p) where id(p) = sourceID");
+	queryArray.Add("optional match (p) " + UNeo4jUtilities::SerializeRelationPattern(relationTypes, direction, "r") + " (n)");
+
+	//collect skips the null row optional match leaves for sources without neighbours
+	queryArray.Add("return sourceID, collect(case when n is null then null else [id(n), labels(n), properties(n), type(r), id(r), startNode(r) = p] end)");
+
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnNeighbourBatch);
+
+	_QueryStrings(queryArray, HttpRequest, TEXT("GetNeighboursBatch"), true, true);
+}
+
+void UNeo4jDatabase::SaveChanges(TArray<UNeo4jEditableNode*> nodes)
+{
+	TArray<FNeo4jPendingSave> saves;
+	for (auto* node : nodes)
+	{
+		FNeo4jPendingSave save;
+		if (node && node->TakeChanges(save.changes))
+		{
+			save.node = node;
+			saves.Add(MoveTemp(save));
+		}
+	}
+
+	if (saves.Num() == 0)
+	{
+		bLastSaveSucceeded = true;
+		OnSaveChangesCompleteDelegate.Broadcast();
+		return;
+	}
+
+	TArray<FNeo4jNodeChanges> changes;
+	changes.Reserve(saves.Num());
+	for (auto& save : saves)
+		changes.Add(save.changes);
+
+	TArray<FString> queryArray;
+	TArray<uint8> parameters;
+	UNeo4jUtilities::SerializeNodeChanges(changes, "m", queryArray, parameters);
+	_AppendChangeMarker(queryArray, "m");
+	_AppendLabelRemoval(queryArray, "m", "row.removeLabels");
+
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnSaveChanges);
+
+	//the changes are out of the nodes until the response says whether they have to go back
+	pendingSaves.Add(&HttpRequest.Get(), MoveTemp(saves));
+
+	_QueryWithParameters(queryArray, parameters, HttpRequest, TEXT("SaveChanges"));
 }
 
 
@@ -426,6 +888,108 @@ void UNeo4jDatabase::GetOutgoingNeighboursByTypes(int nodeID, TArray<FString> re
 #pragma endregion  NODE_FUNCTIONS
 
 
+#pragma region PROJECTION_FUNCTIONS
+
+void UNeo4jDatabase::GetNodesByIDProjected(TArray<int> elementIDs, FNeo4jProjection projection)
+{
+	if (elementIDs.Num() == 0)
+		return;
+
+	TArray<FString> queryArray;
+	queryArray.Add("with " + UNeo4jUtilities::SerializeIDsIntoQuery(elementIDs) + " as range");
+	queryArray.Add("unwind range as n");
+	queryArray.Add("match(m) where id(m) = n");
+	queryArray.Add(UNeo4jUtilities::SerializeProjectionIntoReturn("m", projection));
+
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnProjectedQuery);
+
+	_QueryStrings(queryArray, HttpRequest, TEXT("GetNodesByIDProjected"), true, true);
+}
+
+void UNeo4jDatabase::GetNodesByLabelsProjected(TArray<FString> Labels, FNeo4jProjection projection)
+{
+	TArray<FString> queryArray;
+	queryArray.Add("Match (" + UNeo4jUtilities::SerializeLabelsIntoQuery(Labels) + ")");
+	queryArray.Add(UNeo4jUtilities::SerializeProjectionIntoReturn("m", projection));
+
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnProjectedQuery);
+
+	_QueryStrings(queryArray, HttpRequest, TEXT("GetNodesByLabelsProjected"), true, true);
+}
+
+void UNeo4jDatabase::GetNeighboursProjected(int nodeID, TArray<FString> relationTypes, ENeo4jDirection direction, FNeo4jProjection projection)
+{
+	TArray<FString> queryArray;
+
+	FString matchString = "Match (p) where id(p) = ";
+	matchString.AppendInt(nodeID);
+
+	queryArray.Add(matchString);
+	queryArray.Add("match (p) " + UNeo4jUtilities::SerializeRelationPattern(relationTypes, direction) + " (n)");
+	queryArray.Add(UNeo4jUtilities::SerializeProjectionIntoReturn("n", projection));
+
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnProjectedQuery);
+
+	_QueryStrings(queryArray, HttpRequest, TEXT("GetNeighboursProjected"), true, true);
+}
+
+#pragma endregion PROJECTION_FUNCTIONS
+
+
+#pragma region AGGREGATE_FUNCTIONS
+
+void UNeo4jDatabase::AggregateByLabels(TArray<FString> labels, FNeo4jAggregation aggregation)
+{
+	TArray<FString> queryArray;
+	queryArray.Add("Match (" + UNeo4jUtilities::SerializeLabelsIntoQuery(labels) + ")");
+	queryArray.Add(UNeo4jUtilities::SerializeAggregationIntoReturn("m", aggregation));
+
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnAggregateQuery);
+
+	_QueryStrings(queryArray, HttpRequest, TEXT("AggregateByLabels"), true, true);
+}
+
+void UNeo4jDatabase::AggregateByProperties(TArray<FString> labels, TMap<FString, FString> stringProperties, TMap<FString, int> intProperties,
+	TMap<FString, bool> boolProperties, FNeo4jAggregation aggregation)
+{
+	TArray<FString> queryArray;
+	queryArray.Add("Match (" + UNeo4jUtilities::SerializeLabelsIntoQuery(labels)
+		+ UNeo4jUtilities::SerializePropertiesIntoQuery(stringProperties, intProperties, boolProperties) + ")");
+	queryArray.Add(UNeo4jUtilities::SerializeAggregationIntoReturn("m", aggregation));
+
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnAggregateQuery);
+
+	_QueryStrings(queryArray, HttpRequest, TEXT("AggregateByProperties"), true, true);
+}
+
+void UNeo4jDatabase::AggregateNeighbours(int nodeID, TArray<FString> relationTypes, ENeo4jDirection direction, FNeo4jAggregation aggregation)
+{
+	TArray<FString> queryArray;
+
+	FString matchString = "Match (p) where id(p) = ";
+	matchString.AppendInt(nodeID);
+
+	queryArray.Add(matchString);
+	queryArray.Add("match (p) " + UNeo4jUtilities::SerializeRelationPattern(relationTypes, direction) + " (n)");
+
+	//parallel relationships would otherwise count a neighbour more than once
+	queryArray.Add("with distinct n");
+	queryArray.Add(UNeo4jUtilities::SerializeAggregationIntoReturn("n", aggregation));
+
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnAggregateQuery);
+
+	_QueryStrings(queryArray, HttpRequest, TEXT("AggregateNeighbours"), true, true);
+}
+
+#pragma endregion AGGREGATE_FUNCTIONS
+
+
 
 
 #pragma region RELATION_FUNCTIONS
@@ -460,10 +1024,13 @@ void UNeo4jDatabase::CreateRelations(int nodeID, TMap<FString, int> relationship
 		queryString.AppendInt(nodeArray[i]);
 
 		//create (n) - [: *relationships] -> (ni)
-		queryString = queryString + " Create (n) - [:" + stringArray[i] + "] -> (n";
+		queryString = queryString + " Create (n) - [r:" + stringArray[i] + "] -> (n";
 		queryString.AppendInt(i);
 		queryString = queryString + ")";
 
+		if (bStampChangeMarkers)
+			queryString = queryString + " " + UNeo4jUtilities::SerializeChangeMarkerStamp("r");
+
 
 		//allows us to string these queries together
 		if (i != relationships.Num() - 1)
@@ -477,7 +1044,7 @@ void UNeo4jDatabase::CreateRelations(int nodeID, TMap<FString, int> relationship
 	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> httpRequest = FHttpModule::Get().CreateRequest();
 	//httpRequest->OnProcessRequestComplete().BindUObject(this,&UNeo4jDatabase::_OnCreateRelation);
 
-	QueryStrings(queryArray, httpRequest);
+	_QueryStrings(queryArray, httpRequest, TEXT("CreateRelations"));
 
 }
 
@@ -509,10 +1076,13 @@ void UNeo4jDatabase::MergeRelations(int relationID, TMap<FString, int> relations
 		queryString.AppendInt(nodeArray[i]);
 
 		//create (n) - [: *relationships] -> (ni)
-		queryString = queryString + " Merge (n) - [:" + stringArray[i] + "] -> (n";
+		queryString = queryString + " Merge (n) - [r:" + stringArray[i] + "] -> (n";
 		queryString.AppendInt(i);
 		queryString = queryString + ")";
 
+		if (bStampChangeMarkers)
+			queryString = queryString + " " + UNeo4jUtilities::SerializeChangeMarkerStamp("r");
+
 
 		//allows us to string these queries together
 		if (i != relationships.Num() - 1)
@@ -525,7 +1095,7 @@ void UNeo4jDatabase::MergeRelations(int relationID, TMap<FString, int> relations
 	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> httpRequest = FHttpModule::Get().CreateRequest();
 	//httpRequest->OnProcessRequestComplete().BindUObject(this,&UNeo4jDatabase::_OnMergeRelation);
 
-	QueryStrings(queryArray, httpRequest);
+	_QueryStrings(queryArray, httpRequest, TEXT("MergeRelations"));
 }
 
 
@@ -534,173 +1104,1761 @@ void UNeo4jDatabase::MergeRelations(int relationID, TMap<FString, int> relations
 
 
 
-#pragma region HELPERS
+#pragma region SCHEMA_FUNCTIONS
 
-//set up your delegate before calling this!
-void UNeo4jDatabase::QueryStrings(TArray<FString> inStrings, TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> httpRequest)
+void UNeo4jDatabase::CreateIndex(FString label, FString property, ENeo4jIndexType type)
 {
+	FNeo4jIndexDefinition definition;
+	definition.label = label;
+	definition.property = property;
+	definition.type = type;
 
-	FString queryList;
+	TArray<FString> statements;
+	statements.Add(UNeo4jUtilities::SerializeIndexCreation(definition));
 
-	for (auto& string : inStrings)
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnIndexQuery, false);
+
+	_SendStatements(statements, HttpRequest, TEXT("CreateIndex"));
+}
+
+void UNeo4jDatabase::ListIndexes()
+{
+	TArray<FString> statements;
+	statements.Add("show indexes yield name, type, labelsOrTypes, properties, state, owningConstraint "
+		"return name, type, labelsOrTypes, properties, state, owningConstraint");
+
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnIndexQuery, true);
+
+	_SendStatements(statements, HttpRequest, TEXT("ListIndexes"));
+}
+
+void UNeo4jDatabase::DropIndex(FString name, bool bIsConstraint)
+{
+	TArray<FString> statements;
+	statements.Add(FString(bIsConstraint ? "drop constraint " : "drop index ") + UNeo4jUtilities::EscapeIdentifier(name) + " if exists");
+
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnIndexQuery, false);
+
+	_SendStatements(statements, HttpRequest, TEXT("DropIndex"));
+}
+
+void UNeo4jDatabase::EnsureIndexes()
+{
+	TArray<FString> statements;
+
+	for (auto& definition : declaredSchema)
 	{
-		queryList = queryList + "\n" + string;
+		if (definition.label.IsEmpty() || definition.property.IsEmpty())
+			continue;
+
+		statements.Add(UNeo4jUtilities::SerializeIndexCreation(definition));
+	}
+
+	for (auto& definition : declaredFullTextIndexes)
+	{
+		FString statement = UNeo4jUtilities::SerializeFullTextIndexCreation(definition);
+		if (!statement.IsEmpty())
+			statements.Add(statement);
+	}
+
+	if (bStampChangeMarkers)
+	{
+		UNeo4jUtilities::SerializeSyncIndexCreation(syncView.labels, statements);
+
+		TArray<FString> queryArray;
+		queryArray.Add(UNeo4jUtilities::SerializeClockAdoption());
+
+		TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> adoptRequest = FHttpModule::Get().CreateRequest();
+		_QueryStrings(queryArray, adoptRequest, TEXT("AdoptSyncClock"));
 	}
 
-	FString query = UNeo4jUtilities::_ConstructJSONQueryString(queryList);
+	if (statements.Num() == 0)
+		return;
+
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnIndexQuery, false);
+
+	_SendStatements(statements, HttpRequest, TEXT("EnsureIndexes"));
+}
 
-	UE_LOG(LogTemp, Warning, TEXT("Query Strings input: %s"), *query);
+void UNeo4jDatabase::CreateFullTextIndex(FString name, TArray<FString> labels, TArray<FString> properties)
+{
+	FNeo4jFullTextIndexDefinition definition;
+	definition.name = name;
+	definition.labels = labels;
+	definition.properties = properties;
 
-	_SendQuery(query, httpRequest);
+	FString statement = UNeo4jUtilities::SerializeFullTextIndexCreation(definition);
+	if (statement.IsEmpty())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Full-text index '%s' needs a name, labels and properties"), *name);
+		return;
+	}
 
+	TArray<FString> statements;
+	statements.Add(statement);
 
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnIndexQuery, false);
 
+	_SendStatements(statements, HttpRequest, TEXT("CreateFullTextIndex"));
 }
 
+#pragma endregion SCHEMA_FUNCTIONS
+
 
+#pragma region SEARCH_FUNCTIONS
 
-void UNeo4jDatabase::_SendQuery(FString query, TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> httpRequest)
+void UNeo4jDatabase::SearchFullText(FString index, FString text, ENeo4jFullTextMode mode, int offset, int limit)
 {
-	httpRequest->SetURL(URL + "/commit");
-	httpRequest->SetHeader("Authorization", b64Auth);
-	httpRequest->SetHeader("Accept", "application/json;charset=UTF-8");
-	httpRequest->SetHeader("Content-Type", "application/json");
-	httpRequest->SetVerb("POST");
-	httpRequest->SetContentAsString(query);
-	httpRequest->ProcessRequest();
+	FString luceneQuery = UNeo4jUtilities::MakeFullTextQuery(text, mode);
+
+	//lucene rejects an empty query, and nothing typed means nothing found
+	if (luceneQuery.IsEmpty())
+	{
+		fullTextQueryOutput = FNeo4jFullTextResult();
+		fullTextQueryOutput.text = text;
+		OnFullTextQueryCompleteDelegate.Broadcast();
+		return;
+	}
+
+	offset = FMath::Max(0, offset);
+
+	TArray<FString> queryArray;
+	queryArray.Add("call db.index.fulltext.queryNodes($index, $query) yield node, score");
+	queryArray.Add("return id(node), labels(node), properties(node), score");
+	queryArray.Add("skip $offset");
+
+	//one extra row tells whether there is another page
+	if (limit > 0)
+		queryArray.Add("limit $limit");
+
+	//the text travels as a parameter so it can't break out of the statement
+	TArray<uint8> parameters;
+	FNeo4jJsonWriter writer(parameters);
+	writer.BeginObject();
+	writer.WriteKey(TEXT("index"));
+	writer.WriteString(index);
+	writer.WriteKey(TEXT("query"));
+	writer.WriteString(luceneQuery);
+	writer.WriteKey(TEXT("offset"));
+	writer.WriteInt(offset);
+	writer.WriteKey(TEXT("limit"));
+	writer.WriteInt(limit > 0 ? (int64)limit + 1 : 0);
+	writer.EndObject();
+
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnFullTextQuery, text, offset, limit);
+
+	_QueryWithParameters(queryArray, parameters, HttpRequest, TEXT("SearchFullText"), true);
 }
 
+void UNeo4jDatabase::SearchFullTextDebounced(FString index, FString text, ENeo4jFullTextMode mode, int offset, int limit)
+{
+	//whatever is waiting or in flight answers text that was typed past
+	CancelFullTextSearch();
 
+	debouncedSearch.index = index;
+	debouncedSearch.text = text;
+	debouncedSearch.mode = mode;
+	debouncedSearch.offset = offset;
+	debouncedSearch.limit = limit;
 
-#pragma endregion HELPERS
+	fullTextDebounceHandle = FTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateUObject(this, &UNeo4jDatabase::_OnFullTextDebounce), FMath::Max(0.f, fullTextDebounceSeconds));
+}
 
+void UNeo4jDatabase::CancelFullTextSearch()
+{
+	if (fullTextDebounceHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(fullTextDebounceHandle);
+		fullTextDebounceHandle.Reset();
+	}
+
+	CancelRequestsByKey(FULLTEXT_SUPERSEDE_KEY);
+}
 
+#pragma endregion SEARCH_FUNCTIONS
 
 
-#pragma region DELEGATE_FUNCTIONS
+#pragma region SYNC_FUNCTIONS
 
-void UNeo4jDatabase::_OnStringQueryProcessed(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+void UNeo4jDatabase::StartSync(TArray<FString> labels)
+{
+	syncView.labels = labels;
+	syncView.marker = 0;
+	syncView.nodes.Empty();
+
+	_EnsureSyncIndexes();
+	SyncSince(0);
+}
+
+void UNeo4jDatabase::Sync()
+{
+	SyncSince(syncView.marker);
+}
+
+void UNeo4jDatabase::SyncSince(int64 marker)
+{
+	TArray<FString> queryArray;
+
+	FString markerString = FString::Printf(TEXT("%lld"), marker);
+
+	TArray<uint8> parameters;
+	FNeo4jJsonWriter writer(parameters);
+	writer.BeginObject();
+	writer.WriteKey(TEXT("labels"));
+	writer.BeginArray();
+	for (auto& label : syncView.labels)
+		writer.WriteString(label);
+	writer.EndArray();
+	writer.EndObject();
+
+	//marker 0 is a full load, which also picks up nodes written before stamping was turned on
+	queryArray.Add("match (" + UNeo4jUtilities::SerializeLabelsIntoQuery(syncView.labels) + ")");
+	queryArray.Add("where (" + markerString + " = 0 or m." + SYNC_MARKER_PROPERTY + " > " + markerString + ")");
+	queryArray.Add(FString("and not m:") + SYNC_TOMBSTONE_LABEL + " and not m:" + SYNC_CLOCK_LABEL);
+	queryArray.Add(FString("return m, labels(m) as labels, m.") + SYNC_MARKER_PROPERTY + " as marker, null as deletedId");
+	queryArray.Add("union all");
+
+	//deleted nodes, and nodes that lost a label the view needs and so left it. Both are found through the tombstone
+	//marker index instead of scanning every node stamped since the marker
+	queryArray.Add(FString("match (t:") + SYNC_TOMBSTONE_LABEL + ") where t." + SYNC_MARKER_PROPERTY + " > " + markerString + " and t.nodeId is not null");
+	queryArray.Add("and (t.removedLabels is null or any(label in t.removedLabels where label in $labels))");
+	queryArray.Add(FString("return null as m, null as labels, t.") + SYNC_MARKER_PROPERTY + " as marker, t.nodeId as deletedId");
+
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnSync);
+
+	_QueryWithParameters(queryArray, parameters, HttpRequest, TEXT("SyncSince"), true);
+}
+
+void UNeo4jDatabase::PurgeTombstones(int64 olderThanMarker)
+{
+	TArray<FString> queryArray;
+	queryArray.Add(FString("match (t:") + SYNC_TOMBSTONE_LABEL + ") where t." + SYNC_MARKER_PROPERTY + " < " + FString::Printf(TEXT("%lld"), olderThanMarker));
+	queryArray.Add("delete t");
+
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	_QueryStrings(queryArray, HttpRequest, TEXT("PurgeTombstones"));
+}
+
+#pragma endregion SYNC_FUNCTIONS
+
+
+#pragma region SNAPSHOT_FUNCTIONS
+
+void UNeo4jDatabase::GetSubgraphByLabels(TArray<FString> labels)
+{
+	FString startPattern = UNeo4jUtilities::SerializeLabelsIntoQuery(labels);
+	FString endPattern = "n" + startPattern.Mid(1);
+
+	//separate statements of one transaction so nodes, relationships and the clock are read consistently
+	TArray<FString> statements;
+	statements.Add("match (" + startPattern + ") return m, labels(m)");
+	statements.Add("match (" + startPattern + ")-[r]->(" + endPattern + ") return id(r), type(r), id(m), id(n), properties(r)");
+	statements.Add(FString("optional match (c:") + SYNC_CLOCK_LABEL + ") return coalesce(max(c.value), 0)");
+
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnSubgraphQuery);
+
+	_SendStatements(statements, HttpRequest, TEXT("GetSubgraphByLabels"), true);
+}
+
+void UNeo4jDatabase::LoadSnapshotAsync(FString filePath, bool bValidateAfterLoad)
 {
+	bSnapshotLoaded = false;
+	bSnapshotCurrent = false;
+	snapshotState = ENeo4jSnapshotState::Unknown;
 
-	if (bWasSuccessful)
+	TWeakObjectPtr<UNeo4jDatabase> weakThis(this);
+	UNeo4jSnapshot::LoadSnapshotAsync(filePath, [weakThis, bValidateAfterLoad](bool bLoaded, FNeo4jSubgraph& subgraph)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("String Query Result: %s"), *Response->GetContentAsString());
+		UNeo4jDatabase* database = weakThis.Get();
+		if (!database)
+			return;
+
+		database->snapshotOutput = MoveTemp(subgraph);
+		database->bSnapshotLoaded = bLoaded;
+		database->OnSnapshotLoadedDelegate.Broadcast();
+
+		if (bLoaded && bValidateAfterLoad)
+			database->ValidateSnapshot();
+	});
+}
+
+void UNeo4jDatabase::ValidateSnapshot()
+{
+	TArray<FString> statements;
+	statements.Add(FString("optional match (c:") + SYNC_CLOCK_LABEL + ") return coalesce(max(c.value), 0)");
+
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnValidateSnapshot);
+
+	_SendStatements(statements, HttpRequest, TEXT("ValidateSnapshot"));
+}
+
+void UNeo4jDatabase::ApplySnapshotToSyncView(TArray<FString> labels)
+{
+	syncView.labels = labels;
+	syncView.marker = snapshotOutput.dataVersion;
+	syncView.nodes.Empty(snapshotOutput.nodes.Num());
 
-		stringQueryOutput = UNeo4jUtilities::DeserializeNodeQueryResult(Response->GetContentAsString());
+	for (auto& node : snapshotOutput.nodes)
+		syncView.nodes.Add(node.id, node);
 
+	_EnsureSyncIndexes();
+}
 
-		OnStringQueryCompleteDelegate.Broadcast();
+void UNeo4jDatabase::ExportMappedGraphByLabels(TArray<FString> labels, FString filePath, int pageSize)
+{
+	if (mappedGraphBuilder.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("ExportMappedGraphByLabels is already running"));
+		return;
 	}
-	else
+
+	if (pageSize <= 0)
 	{
-		UE_LOG(LogTemp, Error, TEXT("Response was invalid!"));
+		UE_LOG(LogTemp, Error, TEXT("ExportMappedGraphByLabels needs a page size above 0"));
+		bMappedGraphExported = false;
+		OnMappedGraphExportedDelegate.Broadcast();
 		return;
 	}
 
+	mappedGraphBuilder = MakeShared<FNeo4jMappedGraphBuilder>();
+	_RequestMappedGraphPage(labels, filePath, pageSize, -1);
 }
 
-#pragma region NODE_DELEGATE_FUNCTIONS
+#pragma endregion SNAPSHOT_FUNCTIONS
 
-void UNeo4jDatabase::_OnCreateNode(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+
+#pragma region PATH_FUNCTIONS
+
+void UNeo4jDatabase::ShortestPath(int startNodeID, int endNodeID, TArray<FString> relationTypes, ENeo4jDirection direction, int maxDepth)
 {
+	_QueryPaths(TEXT("shortestPath"), startNodeID, endNodeID, relationTypes, direction, maxDepth);
+}
 
-	if (bWasSuccessful)
-	{
-		FString temp = Response->GetContentAsString();
-		UE_LOG(LogTemp, Warning, TEXT("OnCreateNodeResponse: %s"), *temp);
+void UNeo4jDatabase::AllShortestPaths(int startNodeID, int endNodeID, TArray<FString> relationTypes, ENeo4jDirection direction, int maxDepth)
+{
+	_QueryPaths(TEXT("allShortestPaths"), startNodeID, endNodeID, relationTypes, direction, maxDepth);
+}
 
-		createNodeQueryOutput = UNeo4jUtilities::DeserializeNodeQueryResult(temp);
+#pragma endregion PATH_FUNCTIONS
 
-		OnCreateNodeCompleteDelegate.Broadcast();
-	}
-	else
-	{
-		UE_LOG(LogTemp, Error, TEXT("Response was invalid!"));
+
+#pragma region SPATIAL_FUNCTIONS
+
+void UNeo4jDatabase::CreateNodeWithSpatialProperties(TArray<FString> labels, TMap<FString, FString> stringProperties, TMap<FString, int> intProperties,
+	TMap<FString, bool> boolProperties, TMap<FString, float> floatProperties, TMap<FString, FNeo4jPoint> pointProperties)
+{
+	TArray<FString> queryArray;
+
+	queryArray.Add("Create (" + UNeo4jUtilities::SerializeLabelsIntoQuery(labels) +
+		UNeo4jUtilities::SerializePropertiesIntoQuery(stringProperties, intProperties, boolProperties) + ")");
+
+	FString spatialProperties = UNeo4jUtilities::SerializeSpatialPropertiesIntoQuery(floatProperties, pointProperties);
+	if (!spatialProperties.IsEmpty())
+		queryArray.Add("set m += " + spatialProperties);
+
+	_AppendChangeMarker(queryArray, "m");
+	queryArray.Add("return m, labels(m)");
+
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> httpRequest = FHttpModule::Get().CreateRequest();
+	httpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnCreateNode);
+
+	_QueryStrings(queryArray, httpRequest, TEXT("CreateNodeWithSpatialProperties"));
+}
+
+void UNeo4jDatabase::AddSpatialPropertiesToNodes(TArray<int> elementIDs, TMap<FString, float> floatProperties, TMap<FString, FNeo4jPoint> pointProperties)
+{
+	FString spatialProperties = UNeo4jUtilities::SerializeSpatialPropertiesIntoQuery(floatProperties, pointProperties);
+	if (elementIDs.Num() == 0 || spatialProperties.IsEmpty())
 		return;
-	}
 
+	TArray<FString> queryArray;
+	queryArray.Add("unwind " + UNeo4jUtilities::SerializeIDsIntoQuery(elementIDs) + " as n");
+	queryArray.Add("match(m) where id(m) = n");
+	queryArray.Add("set m += " + spatialProperties);
+	_AppendChangeMarker(queryArray, "m");
 
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnUpdateNode);
 
+	_QueryStrings(queryArray, HttpRequest, TEXT("AddSpatialPropertiesToNodes"));
 }
 
-void UNeo4jDatabase::_OnGetNode(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+void UNeo4jDatabase::GetNodesWithinRadius(FString label, FString property, FNeo4jPoint center, float radius)
 {
-	if (bWasSuccessful)
-	{
-		FString temp = Response->GetContentAsString();
-		UE_LOG(LogTemp, Warning, TEXT("OnGetNodeResponse: %s"), *temp);
+	//point indexes serve distance predicates of the form distance(property, fixed point) <= radius
+	FString distance = "point.distance(m." + UNeo4jUtilities::EscapeIdentifier(property) + ", " + UNeo4jUtilities::SerializePoint(center) + ")";
+
+	_QuerySpatial(label, distance + " <= " + UNeo4jUtilities::SerializeNumber(radius), distance, 0, TEXT("GetNodesWithinRadius"));
+}
 
-		getNodeQueryOutput = UNeo4jUtilities::DeserializeNodeQueryResult(temp);
+void UNeo4jDatabase::GetNodesWithinBox(FString label, FString property, FNeo4jPoint corner, FNeo4jPoint oppositeCorner)
+{
+	//withinBBox wants the lower left and upper right corners
+	FNeo4jPoint lowerCorner = corner;
+	FNeo4jPoint upperCorner = corner;
+	lowerCorner.location = corner.location.ComponentMin(oppositeCorner.location);
+	upperCorner.location = corner.location.ComponentMax(oppositeCorner.location);
 
-		OnGetNodeCompleteDelegate.Broadcast();
-	}
-	else
+	FString whereClause = "point.withinBBox(m." + UNeo4jUtilities::EscapeIdentifier(property) + ", " + UNeo4jUtilities::SerializePoint(lowerCorner)
+		+ ", " + UNeo4jUtilities::SerializePoint(upperCorner) + ")";
+
+	_QuerySpatial(label, whereClause, TEXT("null"), 0, TEXT("GetNodesWithinBox"));
+}
+
+void UNeo4jDatabase::GetNearestNodes(FString label, FString property, FNeo4jPoint center, int count, float maxRadius)
+{
+	//there is no nearest neighbour index lookup, the radius bounds what the index hands to the sort. Without one
+	//every node with the label would be read and sorted
+	if (maxRadius <= 0.f)
+		UE_LOG(LogTemp, Error, TEXT("GetNearestNodes needs a maxRadius > 0 so the point index can serve it"));
+
+	if (count <= 0 || maxRadius <= 0.f)
 	{
-		UE_LOG(LogTemp, Error, TEXT("Response was invalid!"));
+		spatialQueryOutput.Reset();
+		OnSpatialQueryCompleteDelegate.Broadcast();
 		return;
 	}
 
+	FString distance = "point.distance(m." + UNeo4jUtilities::EscapeIdentifier(property) + ", " + UNeo4jUtilities::SerializePoint(center) + ")";
+
+	_QuerySpatial(label, distance + " <= " + UNeo4jUtilities::SerializeNumber(maxRadius), distance, count, TEXT("GetNearestNodes"));
 }
 
-void UNeo4jDatabase::_OnMergeNode(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+#pragma endregion SPATIAL_FUNCTIONS
+
+
+#pragma region STRUCT_FUNCTIONS
+
+void UNeo4jDatabase::_CreateStructNodes(const TArray<FString>& labels, const FNeo4jStructBinder& binder, const void* structs, int32 num,
+	int32 stride, TFunction<void(bool, const FString&)> onResponse)
 {
-	if (bWasSuccessful)
+	if (num == 0)
 	{
-		FString temp = Response->GetContentAsString();
-		UE_LOG(LogTemp, Warning, TEXT("OnMergeNodeResponse: %s"), *temp);
+		if (onResponse)
+			onResponse(true, FString());
+		return;
+	}
 
-		mergeNodeQueryOutput = UNeo4jUtilities::DeserializeNodeQueryResult(temp);
+	TArray<uint8> parameters;
+	FNeo4jJsonWriter writer(parameters);
+	writer.BeginObject();
+	writer.WriteKey(TEXT("rows"));
+	binder.WriteArray(structs, num, stride, writer);
+	writer.EndObject();
 
-		OnMergeNodeCompleteDelegate.Broadcast();
-	}
-	else
+	TArray<FString> queryArray;
+	queryArray.Add("unwind $rows as row");
+	queryArray.Add("create (" + UNeo4jUtilities::SerializeLabelsIntoQuery(labels) + ")");
+	queryArray.Add("set m = row");
+	_AppendChangeMarker(queryArray, "m");
+	queryArray.Add("return m");
+
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnStructQuery, MoveTemp(onResponse));
+
+	_QueryWithParameters(queryArray, parameters, HttpRequest, TEXT("CreateNodes:") + binder.GetStruct()->GetName());
+}
+
+void UNeo4jDatabase::_GetStructNodesByID(const TArray<int>& elementIDs, TFunction<void(bool, const FString&)> onResponse)
+{
+	if (elementIDs.Num() == 0)
 	{
-		UE_LOG(LogTemp, Error, TEXT("Response was invalid!"));
+		if (onResponse)
+			onResponse(true, FString());
 		return;
 	}
+
+	TArray<FString> queryArray;
+	queryArray.Add("match (m) where id(m) in " + UNeo4jUtilities::SerializeIDsIntoQuery(elementIDs));
+	queryArray.Add("return m");
+
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnStructQuery, MoveTemp(onResponse));
+
+	_QueryStrings(queryArray, HttpRequest, TEXT("GetNodesByID"), true);
 }
 
-void UNeo4jDatabase::_OnUpdateNode(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+void UNeo4jDatabase::_GetStructNodesByLabels(const TArray<FString>& labels, TFunction<void(bool, const FString&)> onResponse)
+{
+	TArray<FString> queryArray;
+	queryArray.Add("match (" + UNeo4jUtilities::SerializeLabelsIntoQuery(labels) + ")");
+	queryArray.Add("return m");
+
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnStructQuery, MoveTemp(onResponse));
+
+	_QueryStrings(queryArray, HttpRequest, TEXT("GetNodesByLabels"), true);
+}
+
+#pragma endregion STRUCT_FUNCTIONS
+
+
+
+#pragma region HELPERS
+
+//set up your delegate before calling this!
+void UNeo4jDatabase::QueryStrings(TArray<FString> inStrings, TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> httpRequest)
 {
-	if (bWasSuccessful)
+	_QueryStrings(inStrings, httpRequest, TEXT("QueryStrings"));
+}
+
+void UNeo4jDatabase::_QueryStrings(const TArray<FString>& inStrings, TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> httpRequest, const FString& operation,
+	bool bReadOnly, bool bRowsOnly)
+{
+
+	FString queryList;
+
+	switch (profileMode)
 	{
-		FString temp = Response->GetContentAsString();
-		UE_LOG(LogTemp, Warning, TEXT("OnUpdateNodeResponse: %s"), *temp);
-		updateNodeQueryOutput = UNeo4jUtilities::DeserializeNodeQueryResult(temp);
-		OnUpdateNodeCompleteDelegate.Broadcast();
+	case ENeo4jProfileMode::Explain:
+		queryList = "EXPLAIN";
+		break;
+	case ENeo4jProfileMode::Profile:
+		queryList = "PROFILE";
+		break;
+	default:
+		break;
 	}
-	else
+
+	for (auto& string : inStrings)
 	{
-		UE_LOG(LogTemp, Error, TEXT("Response was invalid!"));
-		return;
+		queryList = queryList + "\n" + string;
 	}
-}
 
+	requestBody.Reset();
+	FNeo4jJsonWriter writer(requestBody);
+	writer.BeginStatements();
+	writer.WriteStatement(queryList, bRowsOnly);
+	writer.EndStatements();
 
-#pragma endregion NODE_DELEGATE_FUNCTIONS
+	UE_LOG(LogTemp, Warning, TEXT("Query Strings input: %s"), *queryList);
 
+	_TrackRequest(httpRequest, operation, queryList, profileMode != ENeo4jProfileMode::None, bReadOnly);
+	_SendQuery(MoveTemp(requestBody), httpRequest);
 
-#pragma region RELATION_DELEGATE_FUNCTIONS
 
-void UNeo4jDatabase::_OnGetNeighbour(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+
+}
+
+
+
+void UNeo4jDatabase::_QueryWithParameters(const TArray<FString>& inStrings, const TArray<uint8>& parameters,
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> httpRequest, const FString& operation, bool bReadOnly)
 {
-	if (bWasSuccessful)
+	FString queryList;
+
+	switch (profileMode)
 	{
-		FString temp = Response->GetContentAsString();
-		UE_LOG(LogTemp, Warning, TEXT("OnGetNeighbour Response: %s"), *temp);
-		getNeighboursQueryOutput = UNeo4jUtilities::DeserializeNodeQueryResult(temp);
-		OnGetNeighbourCompleteDelegate.Broadcast();
+	case ENeo4jProfileMode::Explain:
+		queryList = "EXPLAIN";
+		break;
+	case ENeo4jProfileMode::Profile:
+		queryList = "PROFILE";
+		break;
+	default:
+		break;
 	}
-	else
+
+	for (auto& string : inStrings)
 	{
-		UE_LOG(LogTemp, Error, TEXT("Response was invalid!"));
-		return;
+		queryList = queryList + "\n" + string;
 	}
+
+	requestBody.Reset();
+	FNeo4jJsonWriter writer(requestBody);
+	writer.BeginStatements();
+	writer.BeginStatement(queryList);
+	writer.WriteKey(TEXT("parameters"));
+	writer.WriteRawValue(parameters);
+	writer.EndStatement();
+	writer.EndStatements();
+
+	UE_LOG(LogTemp, Warning, TEXT("Query With Parameters input: %s"), *queryList);
+
+	_TrackRequest(httpRequest, operation, queryList, profileMode != ENeo4jProfileMode::None, bReadOnly);
+	_SendQuery(MoveTemp(requestBody), httpRequest);
+}
+
+void UNeo4jDatabase::_SendStatements(const TArray<FString>& statements, TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> httpRequest,
+	const FString& operation, bool bReadOnly)
+{
+	requestBody.Reset();
+	FNeo4jJsonWriter writer(requestBody);
+	writer.BeginStatements();
+	for (auto& statement : statements)
+		writer.WriteStatement(statement);
+	writer.EndStatements();
+
+	FString joinedStatements = FString::Join(statements, TEXT(";\n"));
+	UE_LOG(LogTemp, Warning, TEXT("Statements input: %s"), *joinedStatements);
+
+	//schema statements can't be explained or profiled
+	_TrackRequest(httpRequest, operation, joinedStatements, false, bReadOnly);
+	_SendQuery(MoveTemp(requestBody), httpRequest);
 }
 
+void UNeo4jDatabase::_TrackRequest(TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> httpRequest, const FString& operation,
+	const FString& query, bool bProfiled, bool bReadOnly)
+{
+	//fire and forget writes still need a callback to be untracked
+	if (!httpRequest->OnProcessRequestComplete().IsBound())
+		httpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnUntrackedResponse);
+
+	//options apply to one request only
+	FNeo4jRequestOptions options = MoveTemp(nextRequestOptions);
+	nextRequestOptions = FNeo4jRequestOptions();
+
+	//an agent that moved on doesn't want the old answer parsed or written to the outputs. The body of this request is
+	//already in requestBody and not sent yet, so listeners hear about the cancellation on the next tick, where
+	//issuing a query of their own can't overwrite it
+	if (!options.supersedeKey.IsEmpty())
+	{
+		TArray<const IHttpRequest*> superseded;
+		for (auto& other : pendingRequests)
+		{
+			if (other.Value.supersedeKey == options.supersedeKey)
+				superseded.Add(other.Key);
+		}
+
+		for (auto* key : superseded)
+			_CancelPendingRequest(key, false, true);
+	}
+
+	FNeo4jPendingRequest& pending = pendingRequests.Add(&httpRequest.Get());
+	pending.operation = operation;
+	pending.query = query;
+	pending.startTime = FPlatformTime::Seconds();
+	pending.bProfiled = bProfiled;
+	pending.request = httpRequest;
+	pending.requestID = ++nextRequestID;
+	pending.supersedeKey = options.supersedeKey;
+	lastRequestID = pending.requestID;
+
+	float timeout = options.timeoutSeconds > 0.f ? options.timeoutSeconds : requestTimeoutSeconds;
+	if (timeout > 0.f)
+	{
+		pending.deadline = pending.startTime + timeout;
 
+		//cancelling on the client closes the connection but an auto-commit transaction keeps running on the server
+		if (bServerSideTimeouts)
+			httpRequest->SetHeader("max-execution-time", FString::FromInt(FMath::Max(1, FMath::CeilToInt(timeout * 1000.f))));
 
-#pragma endregion RELATION_DELEGATE_FUNCTIONS
+		if (!deadlineTickerHandle.IsValid())
+			deadlineTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UNeo4jDatabase::_TickDeadlines));
+	}
+
+	pending.endpoint = _PickEndpoint(bReadOnly);
+	if (pending.endpoint == INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s sent before the database was initialized"), *operation);
+		return;
+	}
+
+	FNeo4jEndpointState& state = endpoints[pending.endpoint];
+	state.outstandingRequests++;
+	httpRequest->SetURL(state.baseURL + "/db/neo4j/tx/commit");
+}
+
+int32 UNeo4jDatabase::_PickEndpoint(bool bReadOnly)
+{
+	const double now = FPlatformTime::Seconds();
+
+	auto pickLeastLoaded = [this, now](ENeo4jEndpointRole role, int32 startIndex)
+	{
+		int32 best = INDEX_NONE;
+		for (int32 n = 0; n < endpoints.Num(); n++)
+		{
+			int32 i = (startIndex + n) % endpoints.Num();
+			FNeo4jEndpointState& state = endpoints[i];
+			if (state.endpoint.role != role)
+				continue;
+
+			//unhealthy endpoints get a probe instead of real traffic
+			if (!state.bHealthy)
+			{
+				if (now >= state.nextProbeTime)
+					_ProbeEndpoint(i);
+				continue;
+			}
+
+			if (best == INDEX_NONE || state.outstandingRequests < endpoints[best].outstandingRequests)
+				best = i;
+		}
+
+		return best;
+	};
+
+	if (endpoints.Num() == 0)
+		return INDEX_NONE;
+
+	if (bReadOnly)
+	{
+		int32 reader = pickLeastLoaded(ENeo4jEndpointRole::Reader, nextReader);
+		nextReader = (nextReader + 1) % endpoints.Num();
+		if (reader != INDEX_NONE)
+			return reader;
+	}
+
+	int32 writer = pickLeastLoaded(ENeo4jEndpointRole::Writer, 0);
+	if (writer != INDEX_NONE)
+		return writer;
+
+	//no healthy writer, send it to the writer anyway so the caller sees the failure
+	for (int32 i = 0; i < endpoints.Num(); i++)
+	{
+		if (endpoints[i].endpoint.role == ENeo4jEndpointRole::Writer)
+			return i;
+	}
+
+	return 0;
+}
+
+void UNeo4jDatabase::_ProbeEndpoint(int32 index)
+{
+	FNeo4jEndpointState& state = endpoints[index];
+	state.nextProbeTime = FPlatformTime::Seconds() + unhealthyRetrySeconds;
+
+	//the discovery document is cheap and needs no transaction
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnEndpointProbe, state.baseURL);
+	HttpRequest->SetURL(state.baseURL + "/");
+	HttpRequest->SetHeader("Authorization", b64Auth);
+	HttpRequest->SetHeader("Accept", "application/json;charset=UTF-8");
+	HttpRequest->SetVerb("GET");
+	HttpRequest->ProcessRequest();
+}
+
+bool UNeo4jDatabase::_CancelPendingRequest(const IHttpRequest* key, bool bTimedOut, bool bDeferBroadcast)
+{
+	FNeo4jPendingRequest pending;
+	if (!pendingRequests.RemoveAndCopyValue(key, pending))
+		return false;
+
+	if (endpoints.IsValidIndex(pending.endpoint))
+		endpoints[pending.endpoint].outstandingRequests--;
+
+	//unbound first, some http backends complete cancelled requests right away
+	if (pending.request.IsValid())
+	{
+		pending.request->OnProcessRequestComplete().Unbind();
+		pending.request->CancelRequest();
+	}
+
+	TArray<FNeo4jPendingSave> saves;
+	if (pendingSaves.RemoveAndCopyValue(key, saves))
+	{
+		for (auto& save : saves)
+		{
+			if (save.node.IsValid())
+				save.node->RestoreChanges(save.changes);
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("%s request %d %s after %.1f ms"), *pending.operation, pending.requestID,
+		bTimedOut ? TEXT("timed out") : TEXT("cancelled"), (FPlatformTime::Seconds() - pending.startTime) * 1000.0);
+
+	if (bDeferBroadcast)
+	{
+		FNeo4jCancelledRequest& cancelled = deferredCancellations.AddDefaulted_GetRef();
+		cancelled.requestID = pending.requestID;
+		cancelled.operation = pending.operation;
+		cancelled.bTimedOut = bTimedOut;
+
+		if (!cancelBroadcastHandle.IsValid())
+			cancelBroadcastHandle = FTicker::GetCoreTicker().AddTicker(
+				FTickerDelegate::CreateUObject(this, &UNeo4jDatabase::_BroadcastDeferredCancellations));
+
+		return true;
+	}
+
+	OnRequestCancelledDelegate.Broadcast(pending.requestID, pending.operation, bTimedOut);
+	return true;
+}
+
+bool UNeo4jDatabase::_BroadcastDeferredCancellations(float deltaTime)
+{
+	cancelBroadcastHandle.Reset();
+
+	//listeners may supersede again, which queues for the next tick
+	TArray<FNeo4jCancelledRequest> cancellations = MoveTemp(deferredCancellations);
+	deferredCancellations.Reset();
+
+	for (auto& cancelled : cancellations)
+		OnRequestCancelledDelegate.Broadcast(cancelled.requestID, cancelled.operation, cancelled.bTimedOut);
+
+	return false;
+}
+
+bool UNeo4jDatabase::_TickDeadlines(float deltaTime)
+{
+	const double now = FPlatformTime::Seconds();
+
+	TArray<const IHttpRequest*> expired;
+	for (auto& pending : pendingRequests)
+	{
+		if (pending.Value.deadline > 0.0 && now >= pending.Value.deadline)
+			expired.Add(pending.Key);
+	}
+
+	for (auto* key : expired)
+		_CancelPendingRequest(key, true);
+
+	//counted after cancelling, requests sent from the cancel delegate can have deadlines of their own
+	for (auto& pending : pendingRequests)
+	{
+		if (pending.Value.deadline > 0.0)
+			return true;
+	}
+
+	deadlineTickerHandle.Reset();
+	return false;
+}
+
+bool UNeo4jDatabase::_OnFullTextDebounce(float deltaTime)
+{
+	fullTextDebounceHandle.Reset();
+
+	//options the caller set for their own next request stay for it
+	FNeo4jRequestOptions callerOptions = MoveTemp(nextRequestOptions);
+	nextRequestOptions = FNeo4jRequestOptions();
+	nextRequestOptions.supersedeKey = FULLTEXT_SUPERSEDE_KEY;
+
+	SearchFullText(debouncedSearch.index, debouncedSearch.text, debouncedSearch.mode, debouncedSearch.offset, debouncedSearch.limit);
+
+	nextRequestOptions = MoveTemp(callerOptions);
+	return false;
+}
+
+void UNeo4jDatabase::_SendToEndpoint(int32 index, TArray<uint8> body, TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> httpRequest)
+{
+	httpRequest->SetURL(endpoints[index].baseURL + "/db/neo4j/tx/commit");
+	_SendQuery(MoveTemp(body), httpRequest);
+}
+
+void UNeo4jDatabase::_CompleteInitializeStep()
+{
+	if (--pendingInitializeSteps > 0)
+		return;
+
+	if (!bCredentialsVerified)
+		_FinishInitialize(false, TEXT("No endpoint accepted the connection"));
+	else if (!bCatalogFetched)
+		_FinishInitialize(false, TEXT("Could not fetch the schema catalog"));
+	else
+		_FinishInitialize(true, FString());
+}
+
+void UNeo4jDatabase::_FinishInitialize(bool bSucceeded, const FString& error)
+{
+	if (initializeTimeoutHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(initializeTimeoutHandle);
+		initializeTimeoutHandle.Reset();
+	}
+
+	//late responses of this initialization are ignored from here on
+	initializeSerial++;
+	pendingInitializeSteps = 0;
+
+	bDatabaseReady = bSucceeded;
+	initializeError = error;
+
+	if (bSucceeded)
+		UE_LOG(LogTemp, Log, TEXT("Database ready, %d labels, %d relationship types, %d property keys"), knownLabels.Num(),
+			knownRelationshipTypes.Num(), knownPropertyKeys.Num());
+	else
+		UE_LOG(LogTemp, Error, TEXT("Database initialization failed: %s"), *error);
+
+	OnDatabaseInitializedDelegate.Broadcast();
+}
+
+bool UNeo4jDatabase::_OnInitializeTimeout(float deltaTime, uint32 serial)
+{
+	//the handle is removed by _FinishInitialize, returning false keeps the ticker from firing again
+	initializeTimeoutHandle.Reset();
+
+	if (serial == initializeSerial)
+		_FinishInitialize(false, TEXT("Timed out"));
+
+	return false;
+}
+
+void UNeo4jDatabase::_ReportEndpointResult(int32 index, bool bSucceeded)
+{
+	FNeo4jEndpointState& state = endpoints[index];
+
+	if (bSucceeded)
+	{
+		if (!state.bHealthy)
+			UE_LOG(LogTemp, Warning, TEXT("Endpoint %s is healthy again"), *state.baseURL);
+
+		state.consecutiveFailures = 0;
+		state.bHealthy = true;
+		return;
+	}
+
+	state.consecutiveFailures++;
+	if (state.bHealthy && state.consecutiveFailures >= failuresBeforeUnhealthy)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Endpoint %s marked unhealthy after %d failures"), *state.baseURL, state.consecutiveFailures);
+		state.bHealthy = false;
+		state.nextProbeTime = FPlatformTime::Seconds() + unhealthyRetrySeconds;
+	}
+}
+
+bool UNeo4jDatabase::_ReadResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, FString& outContent)
+{
+	FNeo4jPendingRequest pending;
+	bool bTracked = Request.IsValid() && pendingRequests.RemoveAndCopyValue(Request.Get(), pending);
+
+	//server errors count against the endpoint, cypher errors come back as 200 and don't
+	bool bServerAnswered = bWasSuccessful && Response.IsValid() && Response->GetResponseCode() < 500;
+	if (bTracked && endpoints.IsValidIndex(pending.endpoint))
+	{
+		endpoints[pending.endpoint].outstandingRequests--;
+		_ReportEndpointResult(pending.endpoint, bServerAnswered);
+	}
+
+	if (!bWasSuccessful || !Response.IsValid())
+		return false;
+
+	outContent = _GetResponseContent(Response);
+
+	if (bTracked && pending.bProfiled)
+		_CapturePlan(pending, outContent);
+
+	return true;
+}
+
+void UNeo4jDatabase::_CapturePlan(const FNeo4jPendingRequest& pending, const FString& content)
+{
+	FNeo4jQueryPlan plan;
+	if (!UNeo4jUtilities::DeserializeQueryPlan(content, plan))
+		return;
+
+	plan.operation = pending.operation;
+	plan.query = pending.query;
+	plan.elapsedSeconds = FPlatformTime::Seconds() - pending.startTime;
+
+	UE_LOG(LogTemp, Log, TEXT("%s plan: %d operators, %lld db hits, %.2f ms"), *plan.operation, plan.operators.Num(),
+		plan.totalDbHits, plan.elapsedSeconds * 1000.f);
+
+	//keep the slowest few per operation, slowest first
+	TArray<FNeo4jQueryPlan>& plans = slowestPlans.FindOrAdd(plan.operation);
+	int insertIndex = 0;
+	while (insertIndex < plans.Num() && plans[insertIndex].elapsedSeconds >= plan.elapsedSeconds)
+		insertIndex++;
+
+	if (insertIndex < maxPlansPerOperation)
+	{
+		plans.Insert(plan, insertIndex);
+		if (plans.Num() > maxPlansPerOperation)
+			plans.SetNum(maxPlansPerOperation);
+	}
+
+	lastQueryPlan = MoveTemp(plan);
+	OnQueryPlanCapturedDelegate.Broadcast();
+}
+
+
+
+void UNeo4jDatabase::_SendQuery(TArray<uint8>&& body, TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> httpRequest)
+{
+	httpRequest->SetHeader("Authorization", b64Auth);
+	httpRequest->SetHeader("Accept", "application/json;charset=UTF-8");
+	httpRequest->SetHeader("Content-Type", "application/json");
+	httpRequest->SetVerb("POST");
+
+	if (bAcceptCompressedResponses)
+		httpRequest->SetHeader("Accept-Encoding", "gzip, deflate");
+
+	//big UNWIND/write batches are mostly repeated keys and compress well
+	if (compressRequestsAboveBytes > 0 && body.Num() > compressRequestsAboveBytes)
+	{
+		TArray<uint8> compressedPayload;
+		if (UNeo4jUtilities::CompressPayload(body, compressedPayload))
+		{
+			httpRequest->SetHeader("Content-Encoding", "gzip");
+			httpRequest->SetContent(MoveTemp(compressedPayload));
+			httpRequest->ProcessRequest();
+			return;
+		}
+	}
+
+	//the request takes the buffer itself, the next body is written into a fresh requestBody
+	httpRequest->SetContent(MoveTemp(body));
+	httpRequest->ProcessRequest();
+}
+
+FString UNeo4jDatabase::_GetResponseContent(FHttpResponsePtr Response) const
+{
+	if (!Response.IsValid())
+		return FString();
+
+	FString encoding = Response->GetHeader("Content-Encoding");
+	if (encoding.IsEmpty() || encoding.Equals("identity", ESearchCase::IgnoreCase))
+		return Response->GetContentAsString();
+
+	FString content;
+	bool bInflatedAny = false;
+	if (UNeo4jUtilities::DecompressPayloadToString(Response->GetContent(), encoding, maxDecompressedResponseBytes, content, bInflatedAny))
+		return content;
+
+	//http layer already decoded the body for us
+	if (!bInflatedAny)
+		return Response->GetContentAsString();
+
+	UE_LOG(LogTemp, Error, TEXT("Could not inflate a %s encoded response"), *encoding);
+	return FString();
+}
+
+
+
+void UNeo4jDatabase::_AppendChangeMarker(TArray<FString>& queryArray, const FString& variable) const
+{
+	if (bStampChangeMarkers)
+		queryArray.Add(UNeo4jUtilities::SerializeChangeMarkerStamp(variable));
+}
+
+void UNeo4jDatabase::_AppendTombstone(TArray<FString>& queryArray, const FString& variable) const
+{
+	if (bStampChangeMarkers)
+		queryArray.Add(UNeo4jUtilities::SerializeTombstone(variable));
+}
+
+void UNeo4jDatabase::_AppendLabelRemoval(TArray<FString>& queryArray, const FString& variable, const FString& removedLabelsExpression) const
+{
+	if (bStampChangeMarkers)
+		queryArray.Add(UNeo4jUtilities::SerializeLabelRemovalTombstone(variable, removedLabelsExpression));
+}
+
+void UNeo4jDatabase::_EnsureSyncIndexes()
+{
+	if (!bStampChangeMarkers)
+		return;
+
+	TArray<FString> statements;
+	UNeo4jUtilities::SerializeSyncIndexCreation(syncView.labels, statements);
+
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	_SendStatements(statements, HttpRequest, TEXT("EnsureSyncIndexes"));
+}
+
+void UNeo4jDatabase::_StoreNodeResult(const FString& content, ENeo4jResultSlot slot)
+{
+	TArray<FNeo4jNode>& outputArray = _GetOutputArray(slot);
+
+	if (!bUseResultSets)
+	{
+		outputArray = UNeo4jUtilities::DeserializeNodeQueryResult(content);
+		return;
+	}
+
+	//hand the previous response's buffers back before taking new ones so they get reused
+	resultSetPool.Release(resultSets[(int)slot]);
+	outputArray.Empty();
+
+	TSharedRef<FNeo4jResultSet> resultSet = resultSetPool.Acquire();
+	resultSet->ParseQueryResult(content);
+	resultSets[(int)slot] = resultSet;
+}
+
+void UNeo4jDatabase::_RequestMappedGraphPage(const TArray<FString>& labels, const FString& filePath, int pageSize, int afterID)
+{
+	FString startPattern = UNeo4jUtilities::SerializeLabelsIntoQuery(labels);
+	FString endPattern = "n" + startPattern.Mid(1);
+
+	//both statements page the same id range, so each page brings the relationships leaving its own nodes
+	FString page = "match (" + startPattern + ") where id(m) > " + FString::FromInt(afterID)
+		+ " with m order by id(m) limit " + FString::FromInt(pageSize);
+
+	TArray<FString> statements;
+	statements.Add(page + " return m, labels(m)");
+	statements.Add(page + " match (m)-[r]->(" + endPattern + ") return id(r), type(r), id(m), id(n), properties(r)");
+	statements.Add(FString("optional match (c:") + SYNC_CLOCK_LABEL + ") return coalesce(max(c.value), 0)");
+
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnMappedGraphPage, labels, filePath, pageSize);
+
+	_SendStatements(statements, HttpRequest, TEXT("ExportMappedGraphByLabels"), true);
+}
+
+void UNeo4jDatabase::_FinishMappedGraphExport(bool bExported)
+{
+	mappedGraphBuilder.Reset();
+
+	bMappedGraphExported = bExported;
+	OnMappedGraphExportedDelegate.Broadcast();
+}
+
+void UNeo4jDatabase::_QuerySpatial(const FString& label, const FString& whereClause, const FString& distanceExpression, int limit,
+	const FString& operation)
+{
+	TArray<FString> queryArray;
+	queryArray.Add("match (m" + (label.IsEmpty() ? FString() : ":" + UNeo4jUtilities::EscapeIdentifier(label)) + ")");
+	queryArray.Add("where " + whereClause);
+	queryArray.Add("with m, " + distanceExpression + " as distance");
+
+	if (distanceExpression != TEXT("null"))
+		queryArray.Add("order by distance");
+
+	if (limit > 0)
+		queryArray.Add("limit " + FString::FromInt(limit));
+
+	queryArray.Add("return id(m), labels(m), properties(m), distance");
+
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnSpatialQuery);
+
+	_QueryStrings(queryArray, HttpRequest, operation, true, true);
+}
+
+void UNeo4jDatabase::_QueryPaths(const FString& pathFunction, int startNodeID, int endNodeID, const TArray<FString>& relationTypes,
+	ENeo4jDirection direction, int maxDepth)
+{
+	TArray<FString> queryArray;
+
+	if (startNodeID == endNodeID)
+	{
+		//the shortest path functions reject equal end points. The answer is the node on its own, in the same row
+		//shape so _OnPathQuery reads it like any path, and no row if the node doesn't exist
+		queryArray.Add(FString::Printf(TEXT("match (a) where id(a) = %d"), startNodeID));
+		queryArray.Add("return [[id(a), labels(a), properties(a)]], []");
+	}
+	else
+	{
+		FString lengthRange = maxDepth > 0 ? FString::Printf(TEXT("*..%d"), maxDepth) : FString(TEXT("*"));
+
+		queryArray.Add(FString::Printf(TEXT("match (a) where id(a) = %d"), startNodeID));
+		queryArray.Add(FString::Printf(TEXT("match (b) where id(b) = %d"), endNodeID));
+		queryArray.Add("match p = " + pathFunction + "((a)" + UNeo4jUtilities::SerializeRelationPattern(relationTypes, direction, FString(), lengthRange) + "(b))");
+		queryArray.Add("return [n in nodes(p) | [id(n), labels(n), properties(n)]],");
+		queryArray.Add("[r in relationships(p) | [id(r), type(r), id(startNode(r)), id(endNode(r)), properties(r)]]");
+	}
+
+	TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UNeo4jDatabase::_OnPathQuery);
+
+	_QueryStrings(queryArray, HttpRequest, pathFunction, true, true);
+}
+
+TArray<FNeo4jNode>& UNeo4jDatabase::_GetOutputArray(ENeo4jResultSlot slot)
+{
+	switch (slot)
+	{
+	case ENeo4jResultSlot::GetNode:			return getNodeQueryOutput;
+	case ENeo4jResultSlot::GetNeighbours:	return getNeighboursQueryOutput;
+	case ENeo4jResultSlot::CreateNode:		return createNodeQueryOutput;
+	case ENeo4jResultSlot::UpdateNode:		return updateNodeQueryOutput;
+	case ENeo4jResultSlot::MergeNode:		return mergeNodeQueryOutput;
+	default:								return stringQueryOutput;
+	}
+}
+
+FOnRequestCompletedDelegate& UNeo4jDatabase::_GetCompleteDelegate(ENeo4jResultSlot slot)
+{
+	switch (slot)
+	{
+	case ENeo4jResultSlot::GetNode:			return OnGetNodeCompleteDelegate;
+	case ENeo4jResultSlot::GetNeighbours:	return OnGetNeighbourCompleteDelegate;
+	case ENeo4jResultSlot::CreateNode:		return OnCreateNodeCompleteDelegate;
+	case ENeo4jResultSlot::UpdateNode:		return OnUpdateNodeCompleteDelegate;
+	case ENeo4jResultSlot::MergeNode:		return OnMergeNodeCompleteDelegate;
+	default:								return OnStringQueryCompleteDelegate;
+	}
+}
+
+void UNeo4jDatabase::_DeliverNodeResult(ENeo4jResultSlot slot)
+{
+	//a newer response replaces an unfinished delivery of the same slot
+	CancelDelivery(slot);
+
+	if (!bSliceNodeDelivery)
+	{
+		_GetCompleteDelegate(slot).Broadcast();
+		return;
+	}
+
+	FNeo4jNodeDelivery& delivery = deliveries.AddDefaulted_GetRef();
+	delivery.slot = slot;
+	delivery.numRows = _GetNumResultRows(slot);
+	delivery.serial = ++nextDeliverySerial;
+
+	if (!deliveryTickerHandle.IsValid())
+		deliveryTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UNeo4jDatabase::_TickDeliveries));
+}
+
+int32 UNeo4jDatabase::_GetNumResultRows(ENeo4jResultSlot slot)
+{
+	const TSharedPtr<FNeo4jResultSet>& resultSet = resultSets[(int)slot];
+	return resultSet.IsValid() ? resultSet->Num() : _GetOutputArray(slot).Num();
+}
+
+FNeo4jNode UNeo4jDatabase::_GetResultRow(ENeo4jResultSlot slot, int32 row)
+{
+	//result set rows are only turned into nodes as they go out
+	const TSharedPtr<FNeo4jResultSet>& resultSet = resultSets[(int)slot];
+	return resultSet.IsValid() ? resultSet->ToNode(row) : _GetOutputArray(slot)[row];
+}
+
+bool UNeo4jDatabase::_TickDeliveries(float deltaTime)
+{
+	const double deadline = FPlatformTime::Seconds() + deliveryBudgetMs / 1000.0;
+
+	//listeners may cancel or replace deliveries while rows go out, so the front entry is re-checked by serial
+	bool bDeliveredAny = false;
+	while (deliveries.Num() > 0 && (!bDeliveredAny || FPlatformTime::Seconds() < deadline))
+	{
+		const uint32 serial = deliveries[0].serial;
+		const ENeo4jResultSlot slot = deliveries[0].slot;
+
+		while (deliveries.Num() > 0 && deliveries[0].serial == serial && deliveries[0].nextRow < deliveries[0].numRows
+			&& (!bDeliveredAny || FPlatformTime::Seconds() < deadline))
+		{
+			int32 row = deliveries[0].nextRow++;
+
+			//output arrays are blueprint writable and may have shrunk
+			if (row >= _GetNumResultRows(slot))
+			{
+				deliveries[0].nextRow = deliveries[0].numRows;
+				break;
+			}
+
+			OnNodeDeliveredDelegate.Broadcast(slot, _GetResultRow(slot, row));
+			bDeliveredAny = true;
+		}
+
+		if (deliveries.Num() == 0 || deliveries[0].serial != serial)
+			continue;
+
+		const FNeo4jNodeDelivery delivery = deliveries[0];
+		OnDeliveryProgressDelegate.Broadcast(slot, delivery.nextRow, delivery.numRows);
+
+		if (delivery.nextRow >= delivery.numRows)
+		{
+			deliveries.RemoveAll([serial](const FNeo4jNodeDelivery& pending) { return pending.serial == serial; });
+			_GetCompleteDelegate(slot).Broadcast();
+		}
+		else
+		{
+			//out of budget for this frame
+			break;
+		}
+	}
+
+	if (deliveries.Num() > 0)
+		return true;
+
+	deliveryTickerHandle.Reset();
+	return false;
+}
+
+#pragma endregion HELPERS
+
+
+
+
+#pragma region DELEGATE_FUNCTIONS
+
+void UNeo4jDatabase::_OnStringQueryProcessed(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+{
+
+	FString temp;
+	if (_ReadResponse(Request, Response, bWasSuccessful, temp))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("String Query Result: %s"), *temp);
+
+		_StoreNodeResult(temp, ENeo4jResultSlot::StringQuery);
+
+
+		_DeliverNodeResult(ENeo4jResultSlot::StringQuery);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Response was invalid!"));
+		return;
+	}
+
+}
+
+#pragma region NODE_DELEGATE_FUNCTIONS
+
+void UNeo4jDatabase::_OnCreateNode(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+{
+
+	FString temp;
+	if (_ReadResponse(Request, Response, bWasSuccessful, temp))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("OnCreateNodeResponse: %s"), *temp);
+
+		_StoreNodeResult(temp, ENeo4jResultSlot::CreateNode);
+
+		_DeliverNodeResult(ENeo4jResultSlot::CreateNode);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Response was invalid!"));
+		return;
+	}
+
+
+
+}
+
+void UNeo4jDatabase::_OnGetNode(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+{
+	FString temp;
+	if (_ReadResponse(Request, Response, bWasSuccessful, temp))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("OnGetNodeResponse: %s"), *temp);
+
+		_StoreNodeResult(temp, ENeo4jResultSlot::GetNode);
+
+		_DeliverNodeResult(ENeo4jResultSlot::GetNode);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Response was invalid!"));
+		return;
+	}
+
+}
+
+void UNeo4jDatabase::_OnMergeNode(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+{
+	FString temp;
+	if (_ReadResponse(Request, Response, bWasSuccessful, temp))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("OnMergeNodeResponse: %s"), *temp);
+
+		_StoreNodeResult(temp, ENeo4jResultSlot::MergeNode);
+
+		_DeliverNodeResult(ENeo4jResultSlot::MergeNode);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Response was invalid!"));
+		return;
+	}
+}
+
+void UNeo4jDatabase::_OnUpdateNode(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+{
+	FString temp;
+	if (_ReadResponse(Request, Response, bWasSuccessful, temp))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("OnUpdateNodeResponse: %s"), *temp);
+		_StoreNodeResult(temp, ENeo4jResultSlot::UpdateNode);
+		_DeliverNodeResult(ENeo4jResultSlot::UpdateNode);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Response was invalid!"));
+		return;
+	}
+}
+
+
+#pragma endregion NODE_DELEGATE_FUNCTIONS
+
+
+#pragma region RELATION_DELEGATE_FUNCTIONS
+
+void UNeo4jDatabase::_OnGetNeighbour(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+{
+	FString temp;
+	if (_ReadResponse(Request, Response, bWasSuccessful, temp))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("OnGetNeighbour Response: %s"), *temp);
+		_StoreNodeResult(temp, ENeo4jResultSlot::GetNeighbours);
+		_DeliverNodeResult(ENeo4jResultSlot::GetNeighbours);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Response was invalid!"));
+		return;
+	}
+}
+
+
+
+#pragma endregion RELATION_DELEGATE_FUNCTIONS
+
+
+void UNeo4jDatabase::_OnSync(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+{
+	FString temp;
+	if (_ReadResponse(Request, Response, bWasSuccessful, temp))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("OnSync Response: %s"), *temp);
+
+		TArray<FNeo4jNode> changedNodes;
+		int64 latestMarker = syncView.marker;
+		UNeo4jUtilities::DeserializeSyncResult(temp, changedNodes, lastSyncDeletedIDs, latestMarker);
+
+		//deletes go first: ids are reused, so a node deleted and re-created within one window comes back as both a
+		//deleted id and a changed node, and only the changed node still exists
+		for (int deletedID : lastSyncDeletedIDs)
+			syncView.nodes.Remove(deletedID);
+
+		lastSyncChangedIDs.Reset(changedNodes.Num());
+		for (auto& node : changedNodes)
+		{
+			lastSyncChangedIDs.Add(node.id);
+			syncView.nodes.Add(node.id, MoveTemp(node));
+		}
+
+		syncView.marker = latestMarker;
+
+		OnSyncCompleteDelegate.Broadcast();
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Response was invalid!"));
+		return;
+	}
+}
+
+void UNeo4jDatabase::_OnMappedGraphPage(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, TArray<FString> labels, FString filePath, int pageSize)
+{
+	FString temp;
+	FNeo4jSubgraph page;
+	if (!_ReadResponse(Request, Response, bWasSuccessful, temp) || !UNeo4jUtilities::DeserializeSubgraphQueryResult(temp, page))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Mapped graph export stopped, a page response was invalid"));
+		_FinishMappedGraphExport(false);
+		return;
+	}
+
+	//later pages may see newer data, the first clock is the one every page is at least as new as
+	if (mappedGraphBuilder->Num() == 0)
+		mappedGraphBuilder->SetDataVersion(page.dataVersion);
+
+	mappedGraphBuilder->AddNodes(page.nodes);
+	mappedGraphBuilder->AddRelationships(page.relationships);
+
+	if (page.nodes.Num() == pageSize)
+	{
+		_RequestMappedGraphPage(labels, filePath, pageSize, page.nodes.Last().id);
+		return;
+	}
+
+	_FinishMappedGraphExport(mappedGraphBuilder->Write(filePath));
+}
+
+void UNeo4jDatabase::_OnSubgraphQuery(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+{
+	FString temp;
+	if (_ReadResponse(Request, Response, bWasSuccessful, temp))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("OnSubgraphQuery Response received"));
+
+		if (!UNeo4jUtilities::DeserializeSubgraphQueryResult(temp, subgraphQueryOutput))
+			UE_LOG(LogTemp, Error, TEXT("Subgraph response was incomplete"));
+
+		OnSubgraphQueryCompleteDelegate.Broadcast();
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Response was invalid!"));
+		return;
+	}
+}
+
+void UNeo4jDatabase::_OnValidateSnapshot(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+{
+	FString temp;
+	if (_ReadResponse(Request, Response, bWasSuccessful, temp))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("OnValidateSnapshot Response: %s"), *temp);
+
+		//the clock only moves forward, so an unchanged value means no stamped write since the snapshot.
+		//0 on both sides means nothing was ever stamped, which says nothing about unstamped writes
+		int64 serverVersion = 0;
+		if (!bSnapshotLoaded || !UNeo4jUtilities::DeserializeSyncClock(temp, serverVersion)
+			|| (serverVersion == 0 && snapshotOutput.dataVersion == 0))
+			snapshotState = ENeo4jSnapshotState::Unknown;
+		else if (serverVersion == snapshotOutput.dataVersion)
+			snapshotState = ENeo4jSnapshotState::Current;
+		else
+			snapshotState = ENeo4jSnapshotState::Stale;
+
+		bSnapshotCurrent = snapshotState == ENeo4jSnapshotState::Current;
+
+		OnSnapshotValidatedDelegate.Broadcast();
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Response was invalid!"));
+		return;
+	}
+}
+
+void UNeo4jDatabase::_OnPathQuery(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+{
+	FString temp;
+	if (_ReadResponse(Request, Response, bWasSuccessful, temp))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("OnPathQuery Response: %s"), *temp);
+		pathQueryOutput = UNeo4jUtilities::DeserializePathQueryResult(temp);
+		OnPathQueryCompleteDelegate.Broadcast();
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Response was invalid!"));
+		return;
+	}
+}
+
+void UNeo4jDatabase::_OnSpatialQuery(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+{
+	FString temp;
+	if (_ReadResponse(Request, Response, bWasSuccessful, temp))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("OnSpatialQuery Response: %s"), *temp);
+		spatialQueryOutput = UNeo4jUtilities::DeserializeSpatialQueryResult(temp);
+		OnSpatialQueryCompleteDelegate.Broadcast();
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Response was invalid!"));
+		return;
+	}
+}
+
+void UNeo4jDatabase::_OnFullTextQuery(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, FString text, int offset, int limit)
+{
+	FString temp;
+	if (_ReadResponse(Request, Response, bWasSuccessful, temp))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("OnFullTextQuery Response: %s"), *temp);
+
+		fullTextQueryOutput.text = text;
+		fullTextQueryOutput.offset = offset;
+		fullTextQueryOutput.matches = UNeo4jUtilities::DeserializeFullTextQueryResult(temp);
+		fullTextQueryOutput.bHasMore = limit > 0 && fullTextQueryOutput.matches.Num() > limit;
+		if (fullTextQueryOutput.bHasMore)
+			fullTextQueryOutput.matches.SetNum(limit);
+
+		OnFullTextQueryCompleteDelegate.Broadcast();
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Response was invalid!"));
+		return;
+	}
+}
+
+void UNeo4jDatabase::_OnStructQuery(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful,
+	TFunction<void(bool, const FString&)> onResponse)
+{
+	FString temp;
+	bool bSucceeded = _ReadResponse(Request, Response, bWasSuccessful, temp) && !UNeo4jUtilities::HasQueryErrors(temp);
+
+	if (bSucceeded)
+		UE_LOG(LogTemp, Warning, TEXT("OnStructQuery Response: %s"), *temp);
+	else
+		UE_LOG(LogTemp, Error, TEXT("Response was invalid!"));
+
+	//parsed straight into the caller's structs, no node array in between
+	if (onResponse)
+		onResponse(bSucceeded, temp);
+}
+
+void UNeo4jDatabase::_OnNeighbourBatch(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+{
+	FString temp;
+	if (_ReadResponse(Request, Response, bWasSuccessful, temp))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("OnNeighbourBatch Response: %s"), *temp);
+		neighbourBatchQueryOutput = UNeo4jUtilities::DeserializeNeighbourBatchResult(temp);
+		OnNeighbourBatchCompleteDelegate.Broadcast();
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Response was invalid!"));
+		return;
+	}
+}
+
+void UNeo4jDatabase::_OnAggregateQuery(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+{
+	FString temp;
+	if (_ReadResponse(Request, Response, bWasSuccessful, temp))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("OnAggregateQuery Response: %s"), *temp);
+		aggregateQueryOutput = UNeo4jUtilities::DeserializeAggregateQueryResult(temp);
+		OnAggregateQueryCompleteDelegate.Broadcast();
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Response was invalid!"));
+		return;
+	}
+}
+
+void UNeo4jDatabase::_OnSaveChanges(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+{
+	TArray<FNeo4jPendingSave> saves;
+	if (Request.IsValid())
+		pendingSaves.RemoveAndCopyValue(Request.Get(), saves);
+
+	FString temp;
+	bLastSaveSucceeded = _ReadResponse(Request, Response, bWasSuccessful, temp)
+		&& EHttpResponseCodes::IsOk(Response->GetResponseCode()) && !UNeo4jUtilities::HasQueryErrors(temp);
+
+	if (bLastSaveSucceeded)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("OnSaveChanges Response: %s"), *temp);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("SaveChanges failed, %d nodes are dirty again"), saves.Num());
+
+		for (auto& save : saves)
+		{
+			if (save.node.IsValid())
+				save.node->RestoreChanges(save.changes);
+		}
+	}
+
+	OnSaveChangesCompleteDelegate.Broadcast();
+}
+
+void UNeo4jDatabase::_OnEndpointProbe(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, FString baseURL)
+{
+	int32 index = endpoints.IndexOfByPredicate([&baseURL](const FNeo4jEndpointState& state) { return state.baseURL == baseURL; });
+	if (index == INDEX_NONE)
+		return;
+
+	_ReportEndpointResult(index, bWasSuccessful && Response.IsValid() && Response->GetResponseCode() < 500);
+}
+
+void UNeo4jDatabase::_OnWarmupConnection(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, uint32 serial, int32 endpoint)
+{
+	if (serial != initializeSerial)
+		return;
+
+	bool bServerAnswered = bWasSuccessful && Response.IsValid() && Response->GetResponseCode() < 500;
+	if (endpoints.IsValidIndex(endpoint))
+		_ReportEndpointResult(endpoint, bServerAnswered);
+
+	if (bServerAnswered && (Response->GetResponseCode() == EHttpResponseCodes::Denied || Response->GetResponseCode() == EHttpResponseCodes::Forbidden))
+	{
+		_FinishInitialize(false, TEXT("Authentication failed"));
+		return;
+	}
+
+	if (bServerAnswered && EHttpResponseCodes::IsOk(Response->GetResponseCode()))
+		bCredentialsVerified = true;
+
+	_CompleteInitializeStep();
+}
+
+void UNeo4jDatabase::_OnWarmupQuery(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, uint32 serial, int32 endpoint, FString query)
+{
+	if (serial != initializeSerial)
+		return;
+
+	//a query that doesn't plan is worth a warning, not a failed initialization
+	if (bWasSuccessful && Response.IsValid() && UNeo4jUtilities::HasQueryErrors(_GetResponseContent(Response)))
+		UE_LOG(LogTemp, Warning, TEXT("Warm-up query could not be planned on %s: %s\n%s"),
+			endpoints.IsValidIndex(endpoint) ? *endpoints[endpoint].baseURL : TEXT("?"), *query, *_GetResponseContent(Response));
+
+	_CompleteInitializeStep();
+}
+
+void UNeo4jDatabase::_OnSchemaCatalog(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, uint32 serial)
+{
+	FString temp;
+	bool bRead = _ReadResponse(Request, Response, bWasSuccessful, temp);
+
+	if (serial != initializeSerial)
+		return;
+
+	if (bRead && UNeo4jUtilities::DeserializeSchemaCatalog(temp, knownLabels, knownRelationshipTypes, knownPropertyKeys))
+	{
+		bCatalogFetched = true;
+
+		//result sets start out with every key the graph uses interned
+		resultSetPool.SetKnownKeys(knownPropertyKeys);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Schema catalog response was invalid!"));
+	}
+
+	_CompleteInitializeStep();
+}
+
+void UNeo4jDatabase::_OnUntrackedResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+{
+	FString temp;
+	if (!_ReadResponse(Request, Response, bWasSuccessful, temp))
+		UE_LOG(LogTemp, Error, TEXT("Response was invalid!"));
+}
+
+void UNeo4jDatabase::_OnTemplateQuery(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+{
+	FString temp;
+	if (_ReadResponse(Request, Response, bWasSuccessful, temp))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("OnTemplateQuery Response: %s"), *temp);
+		templateQueryOutput = UNeo4jUtilities::DeserializeNodeQueryResult(temp);
+		OnTemplateQueryCompleteDelegate.Broadcast();
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Response was invalid!"));
+		return;
+	}
+}
+
+void UNeo4jDatabase::_OnIndexQuery(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, bool bIsListing)
+{
+	FString temp;
+	if (_ReadResponse(Request, Response, bWasSuccessful, temp))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("OnIndexQuery Response: %s"), *temp);
+
+		//create/drop responses carry no rows and leave the output alone, a listing replaces it even when empty
+		if (bIsListing)
+			indexQueryOutput = UNeo4jUtilities::DeserializeIndexQueryResult(temp);
+
+		OnIndexQueryCompleteDelegate.Broadcast();
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Response was invalid!"));
+		return;
+	}
+}
+
+void UNeo4jDatabase::_OnProjectedQuery(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+{
+	FString temp;
+	if (_ReadResponse(Request, Response, bWasSuccessful, temp))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("OnProjectedQuery Response: %s"), *temp);
+		projectedQueryOutput = UNeo4jUtilities::DeserializeProjectedQueryResult(temp);
+		OnProjectedQueryCompleteDelegate.Broadcast();
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Response was invalid!"));
+		return;
+	}
+}
 
 
 #pragma endregion DELEGATE_FUNCTIONS
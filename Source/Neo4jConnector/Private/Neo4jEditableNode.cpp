@@ -0,0 +1,173 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Neo4jEditableNode.h"
+
+#include "Dom/JsonValue.h"
+
+
+//only scalars are compared, anything else counts as changed
+static bool _IsSameValue(const TSharedPtr<FJsonValue>& a, const TSharedPtr<FJsonValue>& b)
+{
+	if (!a.IsValid() || !b.IsValid() || a->Type != b->Type)
+		return false;
+
+	switch (a->Type)
+	{
+	case EJson::String:		return a->AsString().Equals(b->AsString(), ESearchCase::CaseSensitive);
+	case EJson::Number:		return a->AsNumber() == b->AsNumber();
+	case EJson::Boolean:	return a->AsBool() == b->AsBool();
+	default:				return false;
+	}
+}
+
+//labels are case-sensitive, TArray<FString>::Contains is not
+static bool _HasLabel(const FNeo4jNode& node, const FString& label)
+{
+	return node.labels.ContainsByPredicate([&label](const FString& nodeLabel) { return nodeLabel.Equals(label, ESearchCase::CaseSensitive); });
+}
+
+UNeo4jEditableNode* UNeo4jEditableNode::EditNode(const FNeo4jNode& node)
+{
+	UNeo4jEditableNode* editableNode = NewObject<UNeo4jEditableNode>();
+	editableNode->node = node;
+
+	return editableNode;
+}
+
+void UNeo4jEditableNode::SetStringProperty(const FString& key, const FString& value)
+{
+	SetProperty(key, MakeShareable(new FJsonValueString(value)));
+}
+
+void UNeo4jEditableNode::SetIntProperty(const FString& key, int value)
+{
+	SetProperty(key, MakeShareable(new FJsonValueNumber(value)));
+}
+
+void UNeo4jEditableNode::SetFloatProperty(const FString& key, float value)
+{
+	SetProperty(key, MakeShareable(new FJsonValueNumber(value)), true);
+}
+
+void UNeo4jEditableNode::SetBoolProperty(const FString& key, bool value)
+{
+	SetProperty(key, MakeShareable(new FJsonValueBoolean(value)));
+}
+
+void UNeo4jEditableNode::SetProperty(const FString& key, TSharedPtr<FJsonValue> value, bool bFloat)
+{
+	const TSharedPtr<FJsonValue>* currentValue = node.properties.Find(key);
+	if (currentValue && _IsSameValue(*currentValue, value) && bFloat == floatProperties.Contains(key))
+		return;
+
+	node.properties.Add(key, value);
+	if (bFloat)
+		floatProperties.Add(key);
+	else
+		floatProperties.Remove(key);
+	removedProperties.Remove(key);
+	dirtyProperties.Add(key);
+}
+
+void UNeo4jEditableNode::RemoveProperty(const FString& key)
+{
+	if (node.properties.Remove(key) == 0)
+		return;
+
+	dirtyProperties.Remove(key);
+	floatProperties.Remove(key);
+	removedProperties.Add(key);
+}
+
+void UNeo4jEditableNode::AddLabel(const FString& label)
+{
+	if (_HasLabel(node, label))
+		return;
+
+	node.labels.Add(label);
+
+	//re-adding a removed label cancels the removal
+	if (removedLabels.Remove(label) == 0)
+		addedLabels.Add(label);
+}
+
+void UNeo4jEditableNode::RemoveLabel(const FString& label)
+{
+	if (node.labels.RemoveAll([&label](const FString& nodeLabel) { return nodeLabel.Equals(label, ESearchCase::CaseSensitive); }) == 0)
+		return;
+
+	if (addedLabels.Remove(label) == 0)
+		removedLabels.Add(label);
+}
+
+bool UNeo4jEditableNode::IsDirty() const
+{
+	return dirtyProperties.Num() > 0 || removedProperties.Num() > 0 || addedLabels.Num() > 0 || removedLabels.Num() > 0;
+}
+
+void UNeo4jEditableNode::ResetNode(const FNeo4jNode& inNode)
+{
+	node = inNode;
+
+	dirtyProperties.Reset();
+	removedProperties.Reset();
+	floatProperties.Reset();
+	addedLabels.Reset();
+	removedLabels.Reset();
+}
+
+bool UNeo4jEditableNode::TakeChanges(FNeo4jNodeChanges& outChanges)
+{
+	if (!IsDirty())
+		return false;
+
+	outChanges = FNeo4jNodeChanges();
+	outChanges.id = node.id;
+
+	for (auto& key : dirtyProperties)
+	{
+		outChanges.setProperties.Add(key, node.properties.FindRef(key));
+		if (floatProperties.Contains(key))
+			outChanges.floatProperties.Add(key);
+	}
+
+	outChanges.removedProperties = removedProperties.Array();
+	outChanges.addedLabels = addedLabels.Array();
+	outChanges.removedLabels = removedLabels.Array();
+
+	dirtyProperties.Reset();
+	removedProperties.Reset();
+	addedLabels.Reset();
+	removedLabels.Reset();
+
+	return true;
+}
+
+void UNeo4jEditableNode::RestoreChanges(const FNeo4jNodeChanges& changes)
+{
+	//the local copy already holds the latest values, only the dirty flags need putting back
+	for (auto& change : changes.setProperties)
+	{
+		if (node.properties.Contains(change.Key))
+			dirtyProperties.Add(change.Key);
+	}
+
+	for (auto& key : changes.removedProperties)
+	{
+		if (!node.properties.Contains(key))
+			removedProperties.Add(key);
+	}
+
+	for (auto& label : changes.addedLabels)
+	{
+		if (_HasLabel(node, label))
+			addedLabels.Add(label);
+	}
+
+	for (auto& label : changes.removedLabels)
+	{
+		if (!_HasLabel(node, label))
+			removedLabels.Add(label);
+	}
+}
@@ -1,24 +1,152 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 
-// Fill out your copyright notice in the Description page of Project Settings.
+#include "Neo4jFilters.h"
 
+#include "Async/ParallelFor.h"
 
-#include "Neo4jFilters.h"
+//below this many nodes the batch filters run on the calling thread
+static const int32 PARALLEL_EXTRACT_THRESHOLD = 4096;
+
+//nodes handed to each worker in one go, keeps ParallelFor overhead low for cheap per-node work
+static const int32 PARALLEL_EXTRACT_CHUNK_SIZE = 1024;
 
-int UNeo4jFilters::FilterIntProperty(FNeo4jNode inNode, FString property)
+//reads one property of every node through convert, splitting large arrays across worker threads
+template<typename ValueType, typename ConvertFunc>
+static void _ExtractColumn(const TArray<FNeo4jNode>& inNodes, const FString& property, TArray<ValueType>& outValues,
+	TArray<bool>& outValid, ConvertFunc convert)
 {
+	const int32 numNodes = inNodes.Num();
 
-	return inNode.properties.Find(property)->ToSharedRef()->AsNumber();
+	outValues.Reset(numNodes);
+	outValues.SetNum(numNodes);
+	outValid.Reset(numNodes);
+	outValid.SetNumZeroed(numNodes);
 
+	const int32 numChunks = FMath::DivideAndRoundUp(numNodes, PARALLEL_EXTRACT_CHUNK_SIZE);
+
+	ParallelFor(numChunks, [&](int32 chunk)
+	{
+		const int32 start = chunk * PARALLEL_EXTRACT_CHUNK_SIZE;
+		const int32 end = FMath::Min(start + PARALLEL_EXTRACT_CHUNK_SIZE, numNodes);
+
+		for (int32 i = start; i < end; i++)
+		{
+			const TSharedPtr<FJsonValue>* value = inNodes[i].properties.Find(property);
+			if (value && value->IsValid())
+				outValid[i] = convert(**value, outValues[i]);
+		}
+	}, numNodes < PARALLEL_EXTRACT_THRESHOLD);
 }
 
-FString UNeo4jFilters::FilterStringProperty(FNeo4jNode inNode, FString property)
+
+int UNeo4jFilters::FilterIntProperty(const FNeo4jNode& inNode, const FString& property)
 {
-	return inNode.properties.Find(property)->ToSharedRef()->AsString();
+	const TSharedPtr<FJsonValue>* value = inNode.properties.Find(property);
+	if (!value || !value->IsValid())
+		return 0;
+
+	return (*value)->AsNumber();
+
 }
 
-bool UNeo4jFilters::FilterBoolProperty(FNeo4jNode inNode, FString property)
+FString UNeo4jFilters::FilterStringProperty(const FNeo4jNode& inNode, const FString& property)
 {
-	return inNode.properties.Find(property)->ToSharedRef()->AsBool();
+	const TSharedPtr<FJsonValue>* value = inNode.properties.Find(property);
+	if (!value || !value->IsValid())
+		return FString();
+
+	return (*value)->AsString();
 }
+
+bool UNeo4jFilters::FilterBoolProperty(const FNeo4jNode& inNode, const FString& property)
+{
+	const TSharedPtr<FJsonValue>* value = inNode.properties.Find(property);
+	if (!value || !value->IsValid())
+		return false;
+
+	return (*value)->AsBool();
+}
+
+
+#pragma region BATCH_FILTERS
+
+void UNeo4jFilters::ExtractIntProperty(const TArray<FNeo4jNode>& inNodes, const FString& property, TArray<int>& outValues, TArray<bool>& outValid)
+{
+	_ExtractColumn(inNodes, property, outValues, outValid, [](const FJsonValue& value, int& outValue)
+	{
+		double number;
+		if (!value.TryGetNumber(number))
+			return false;
+
+		outValue = (int)number;
+		return true;
+	});
+}
+
+void UNeo4jFilters::ExtractFloatProperty(const TArray<FNeo4jNode>& inNodes, const FString& property, TArray<float>& outValues, TArray<bool>& outValid)
+{
+	_ExtractColumn(inNodes, property, outValues, outValid, [](const FJsonValue& value, float& outValue)
+	{
+		double number;
+		if (!value.TryGetNumber(number))
+			return false;
+
+		outValue = (float)number;
+		return true;
+	});
+}
+
+void UNeo4jFilters::ExtractDoubleProperty(const TArray<FNeo4jNode>& inNodes, const FString& property, TArray<double>& outValues, TArray<bool>& outValid)
+{
+	_ExtractColumn(inNodes, property, outValues, outValid, [](const FJsonValue& value, double& outValue)
+	{
+		return value.TryGetNumber(outValue);
+	});
+}
+
+void UNeo4jFilters::ExtractBoolProperty(const TArray<FNeo4jNode>& inNodes, const FString& property, TArray<bool>& outValues, TArray<bool>& outValid)
+{
+	_ExtractColumn(inNodes, property, outValues, outValid, [](const FJsonValue& value, bool& outValue)
+	{
+		return value.TryGetBool(outValue);
+	});
+}
+
+void UNeo4jFilters::ExtractStringProperty(const TArray<FNeo4jNode>& inNodes, const FString& property, TArray<FString>& outValues, TArray<bool>& outValid)
+{
+	_ExtractColumn(inNodes, property, outValues, outValid, [](const FJsonValue& value, FString& outValue)
+	{
+		return value.TryGetString(outValue);
+	});
+}
+
+#pragma endregion BATCH_FILTERS
+
+
+#pragma region PROJECTION_FILTERS
+
+FString UNeo4jFilters::FilterProjectedString(const FNeo4jProjectedResult& inResult, int row, const FString& column)
+{
+	TSharedPtr<FJsonValue> value = inResult.GetValue(row, inResult.FindColumn(column));
+	return value.IsValid() ? value->AsString() : FString();
+}
+
+int UNeo4jFilters::FilterProjectedInt(const FNeo4jProjectedResult& inResult, int row, const FString& column)
+{
+	TSharedPtr<FJsonValue> value = inResult.GetValue(row, inResult.FindColumn(column));
+	return value.IsValid() ? (int)value->AsNumber() : 0;
+}
+
+bool UNeo4jFilters::FilterProjectedBool(const FNeo4jProjectedResult& inResult, int row, const FString& column)
+{
+	TSharedPtr<FJsonValue> value = inResult.GetValue(row, inResult.FindColumn(column));
+	return value.IsValid() ? value->AsBool() : false;
+}
+
+TArray<FString> UNeo4jFilters::FilterProjectedLabels(const FNeo4jProjectedResult& inResult, int row)
+{
+	return inResult.labels.IsValidIndex(row) ? inResult.labels[row] : TArray<FString>();
+}
+
+#pragma endregion PROJECTION_FILTERS
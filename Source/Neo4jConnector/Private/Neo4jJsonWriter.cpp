@@ -0,0 +1,319 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Neo4jJsonWriter.h"
+
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+
+
+FNeo4jJsonWriter::FNeo4jJsonWriter(TArray<uint8>& outBuffer)
+	: buffer(outBuffer)
+{
+}
+
+void FNeo4jJsonWriter::BeginObject()
+{
+	_BeforeValue();
+	buffer.Add('{');
+	containerHasMembers.Push(false);
+}
+
+void FNeo4jJsonWriter::EndObject()
+{
+	check(containerHasMembers.Num() > 0);
+	containerHasMembers.Pop(false);
+	buffer.Add('}');
+}
+
+void FNeo4jJsonWriter::BeginArray()
+{
+	_BeforeValue();
+	buffer.Add('[');
+	containerHasMembers.Push(false);
+}
+
+void FNeo4jJsonWriter::EndArray()
+{
+	check(containerHasMembers.Num() > 0);
+	containerHasMembers.Pop(false);
+	buffer.Add(']');
+}
+
+void FNeo4jJsonWriter::WriteKey(const FString& key)
+{
+	_BeforeValue();
+	_WriteEscaped(key);
+	buffer.Add(':');
+	bAfterKey = true;
+}
+
+void FNeo4jJsonWriter::WriteRawKey(const TArray<uint8>& quotedKey)
+{
+	_BeforeValue();
+	buffer.Append(quotedKey);
+	buffer.Add(':');
+	bAfterKey = true;
+}
+
+void FNeo4jJsonWriter::WriteString(const FString& value)
+{
+	_BeforeValue();
+	_WriteEscaped(value);
+}
+
+void FNeo4jJsonWriter::WriteNumber(double value)
+{
+	if (!FMath::IsFinite(value))
+	{
+		WriteNull();
+		return;
+	}
+
+	_BeforeValue();
+	ANSICHAR text[32];
+	int32 length = FCStringAnsi::Snprintf(text, sizeof(text), "%.17g", value);
+	_AppendNumber(text, length);
+}
+
+void FNeo4jJsonWriter::WriteFloat(float value)
+{
+	if (!FMath::IsFinite(value))
+	{
+		WriteNull();
+		return;
+	}
+
+	_BeforeValue();
+	ANSICHAR text[32];
+	int32 length = 0;
+
+	//9 significant digits always round-trip a float, most values need fewer
+	for (int32 precision = 6; precision <= 9; precision++)
+	{
+		length = FCStringAnsi::Snprintf(text, sizeof(text), "%.*g", precision, (double)value);
+		if ((float)FCStringAnsi::Atod(text) == value)
+			break;
+	}
+
+	_AppendNumber(text, length);
+}
+
+void FNeo4jJsonWriter::WriteInt(int64 value)
+{
+	_BeforeValue();
+	ANSICHAR text[24];
+	int32 length = FCStringAnsi::Snprintf(text, sizeof(text), "%lld", (long long)value);
+	_Append(text, length);
+}
+
+void FNeo4jJsonWriter::WriteBool(bool value)
+{
+	_BeforeValue();
+	if (value)
+		_Append("true", 4);
+	else
+		_Append("false", 5);
+}
+
+void FNeo4jJsonWriter::WriteNull()
+{
+	_BeforeValue();
+	_Append("null", 4);
+}
+
+void FNeo4jJsonWriter::WriteValue(const TSharedPtr<FJsonValue>& value)
+{
+	if (!value.IsValid())
+	{
+		WriteNull();
+		return;
+	}
+
+	switch (value->Type)
+	{
+	case EJson::String:
+		WriteString(value->AsString());
+		break;
+	case EJson::Number:
+	{
+		double number = value->AsNumber();
+		if (number == FMath::FloorToDouble(number) && FMath::Abs(number) < 9007199254740992.0)
+			WriteInt((int64)number);
+		else
+			WriteNumber(number);
+		break;
+	}
+	case EJson::Boolean:
+		WriteBool(value->AsBool());
+		break;
+	case EJson::Array:
+		BeginArray();
+		for (auto& element : value->AsArray())
+			WriteValue(element);
+		EndArray();
+		break;
+	case EJson::Object:
+		BeginObject();
+		for (auto& member : value->AsObject()->Values)
+		{
+			WriteKey(member.Key);
+			WriteValue(member.Value);
+		}
+		EndObject();
+		break;
+	default:
+		WriteNull();
+		break;
+	}
+}
+
+void FNeo4jJsonWriter::WriteRawValue(const TArray<uint8>& json)
+{
+	_BeforeValue();
+	buffer.Append(json);
+}
+
+void FNeo4jJsonWriter::BeginStatements()
+{
+	BeginObject();
+	WriteKey(TEXT("statements"));
+	BeginArray();
+}
+
+void FNeo4jJsonWriter::EndStatements()
+{
+	EndArray();
+	EndObject();
+}
+
+void FNeo4jJsonWriter::BeginStatement(const FString& statement, bool bRowsOnly)
+{
+	BeginObject();
+	WriteKey(TEXT("statement"));
+	WriteString(statement);
+
+	if (bRowsOnly)
+	{
+		WriteKey(TEXT("resultDataContents"));
+		BeginArray();
+		WriteString(TEXT("row"));
+		EndArray();
+	}
+}
+
+void FNeo4jJsonWriter::EndStatement()
+{
+	EndObject();
+}
+
+void FNeo4jJsonWriter::WriteStatement(const FString& statement, bool bRowsOnly)
+{
+	BeginStatement(statement, bRowsOnly);
+	EndStatement();
+}
+
+void FNeo4jJsonWriter::_BeforeValue()
+{
+	if (bAfterKey)
+	{
+		bAfterKey = false;
+		return;
+	}
+
+	if (containerHasMembers.Num() > 0)
+	{
+		if (containerHasMembers.Last())
+			buffer.Add(',');
+		else
+			containerHasMembers.Last() = true;
+	}
+}
+
+void FNeo4jJsonWriter::_WriteEscaped(const FString& string)
+{
+	const TCHAR* characters = *string;
+	const int32 length = string.Len();
+
+	//worst case is all ascii, anything longer grows the buffer as it goes
+	buffer.Reserve(buffer.Num() + length + 2);
+	buffer.Add('"');
+
+	for (int32 i = 0; i < length; i++)
+	{
+		uint32 codepoint = (uint32)characters[i];
+
+		if (codepoint >= 0x20 && codepoint < 0x80)
+		{
+			if (codepoint == '"' || codepoint == '\\')
+				buffer.Add('\\');
+			buffer.Add((uint8)codepoint);
+			continue;
+		}
+
+		if (codepoint < 0x20)
+		{
+			switch (codepoint)
+			{
+			case '\n':	_Append("\\n", 2); break;
+			case '\r':	_Append("\\r", 2); break;
+			case '\t':	_Append("\\t", 2); break;
+			default:
+			{
+				ANSICHAR text[8];
+				_Append(text, FCStringAnsi::Snprintf(text, sizeof(text), "\\u%04x", codepoint));
+			}
+			}
+			continue;
+		}
+
+		//utf-16 platforms hand out surrogate pairs, join them before encoding
+		if (codepoint >= 0xD800 && codepoint <= 0xDBFF && i + 1 < length)
+		{
+			uint32 low = (uint32)characters[i + 1];
+			if (low >= 0xDC00 && low <= 0xDFFF)
+			{
+				codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+				i++;
+			}
+		}
+
+		//lone surrogates and out of range values can't be encoded
+		if ((codepoint >= 0xD800 && codepoint <= 0xDFFF) || codepoint > 0x10FFFF)
+			codepoint = 0xFFFD;
+
+		if (codepoint < 0x800)
+		{
+			buffer.Add((uint8)(0xC0 | (codepoint >> 6)));
+			buffer.Add((uint8)(0x80 | (codepoint & 0x3F)));
+		}
+		else if (codepoint < 0x10000)
+		{
+			buffer.Add((uint8)(0xE0 | (codepoint >> 12)));
+			buffer.Add((uint8)(0x80 | ((codepoint >> 6) & 0x3F)));
+			buffer.Add((uint8)(0x80 | (codepoint & 0x3F)));
+		}
+		else
+		{
+			buffer.Add((uint8)(0xF0 | (codepoint >> 18)));
+			buffer.Add((uint8)(0x80 | ((codepoint >> 12) & 0x3F)));
+			buffer.Add((uint8)(0x80 | ((codepoint >> 6) & 0x3F)));
+			buffer.Add((uint8)(0x80 | (codepoint & 0x3F)));
+		}
+	}
+
+	buffer.Add('"');
+}
+
+void FNeo4jJsonWriter::_AppendNumber(const ANSICHAR* text, int32 length)
+{
+	_Append(text, length);
+
+	if (!FCStringAnsi::Strchr(text, '.') && !FCStringAnsi::Strchr(text, 'e'))
+		_Append(".0", 2);
+}
+
+void FNeo4jJsonWriter::_Append(const ANSICHAR* text, int32 length)
+{
+	buffer.Append((const uint8*)text, length);
+}
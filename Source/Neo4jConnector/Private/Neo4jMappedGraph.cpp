@@ -0,0 +1,1178 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Neo4jMappedGraph.h"
+
+#include "Async/MappedFileHandle.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/FileHelper.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+//"N4JM"
+static const uint32 MAPPED_GRAPH_MAGIC = 0x4D4A344E;
+
+static const uint32 MAPPED_GRAPH_FORMAT_VERSION = 1;
+
+
+//bytewise order used for the string table, so lookups can binary search on raw utf8
+static int32 _CompareBytes(const uint8* a, uint64 aLength, const uint8* b, uint64 bLength)
+{
+	int32 result = FMemory::Memcmp(a, b, FMath::Min(aLength, bLength));
+	if (result != 0)
+		return result;
+
+	return aLength < bLength ? -1 : (aLength > bLength ? 1 : 0);
+}
+
+//lists and maps have no column type of their own, they are kept as json text
+static FString _ValueToText(const TSharedPtr<FJsonValue>& value)
+{
+	if (value->Type == EJson::String)
+		return value->AsString();
+
+	FString outJson;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> writer =
+		TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&outJson);
+
+	if (value->Type == EJson::Array)
+		FJsonSerializer::Serialize(value->AsArray(), writer);
+	else
+		FJsonSerializer::Serialize(value->AsObject().ToSharedRef(), writer);
+
+	return outJson;
+}
+
+static bool _GetColumnType(const TSharedPtr<FJsonValue>& value, ENeo4jMappedColumnType& outType)
+{
+	if (!value.IsValid())
+		return false;
+
+	switch (value->Type)
+	{
+	case EJson::Number:		outType = ENeo4jMappedColumnType::Number; return true;
+	case EJson::Boolean:	outType = ENeo4jMappedColumnType::Bool; return true;
+	case EJson::String:
+	case EJson::Array:
+	case EJson::Object:		outType = ENeo4jMappedColumnType::String; return true;
+	default:				return false;
+	}
+}
+
+//pads the file to 8 bytes, returning the offset the next section starts at
+static uint64 _BeginSection(IFileHandle& file, bool& bOutFailed)
+{
+	static const uint8 padding[8] = {};
+
+	int64 position = file.Tell();
+	int64 numPadding = Align(position, 8) - position;
+	if (numPadding > 0 && !file.Write(padding, numPadding))
+		bOutFailed = true;
+
+	return position + numPadding;
+}
+
+/**
+* Streams one section into the file a page at a time, so export never holds a whole section in memory.
+* Construct it when the previous section is finished, Add every element in order and Finish to get the offset.
+*/
+template<typename T>
+class TNeo4jMappedSectionWriter
+{
+public:
+
+	TNeo4jMappedSectionWriter(IFileHandle& inFile, bool& inOutFailed)
+		: file(inFile)
+		, bFailed(inOutFailed)
+	{
+		offset = _BeginSection(file, bFailed);
+		page.Reserve(PAGE_ELEMENTS);
+	}
+
+	void Add(const T& element)
+	{
+		page.Add(element);
+		if (page.Num() == PAGE_ELEMENTS)
+			_Flush();
+	}
+
+	uint64 Finish()
+	{
+		_Flush();
+		return offset;
+	}
+
+private:
+
+	static constexpr int32 PAGE_ELEMENTS = sizeof(T) < 65536 ? 65536 / sizeof(T) : 1;
+
+	void _Flush()
+	{
+		if (page.Num() > 0 && !file.Write((const uint8*)page.GetData(), (int64)page.Num() * sizeof(T)))
+			bFailed = true;
+
+		page.Reset();
+	}
+
+	IFileHandle& file;
+	bool& bFailed;
+	uint64 offset;
+	TArray<T> page;
+};
+
+//relationship indices grouped by node index, in input order within a node, the order edges are stored in
+static TArray<int32> _GroupByNode(const TArray<uint32>& nodeOfRelationship, const TArray<uint32>& starts)
+{
+	TArray<int32> grouped;
+	grouped.SetNumUninitialized(nodeOfRelationship.Num());
+
+	TArray<uint32> cursor = starts;
+	for (int32 i = 0; i < nodeOfRelationship.Num(); i++)
+		grouped[cursor[nodeOfRelationship[i]]++] = i;
+
+	return grouped;
+}
+
+
+#pragma region MAPPED_GRAPH
+
+FNeo4jMappedGraph::~FNeo4jMappedGraph()
+{
+	Close();
+}
+
+bool FNeo4jMappedGraph::Open(const FString& filePath, bool bValidateIndices)
+{
+	Close();
+
+	int64 fileSize = 0;
+
+	IPlatformFile& platformFile = FPlatformFileManager::Get().GetPlatformFile();
+	mappedFile.Reset(platformFile.OpenMapped(*filePath));
+	if (mappedFile.IsValid())
+	{
+		mappedRegion.Reset(mappedFile->MapRegion(0, mappedFile->GetFileSize()));
+		if (mappedRegion.IsValid())
+		{
+			data = mappedRegion->GetMappedPtr();
+			fileSize = mappedRegion->GetMappedSize();
+		}
+	}
+
+	if (!data)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Could not map %s, loading it into memory instead"), *filePath);
+		mappedRegion.Reset();
+		mappedFile.Reset();
+
+		if (!FFileHelper::LoadFileToArray(loadedFile, *filePath))
+			return false;
+
+		data = loadedFile.GetData();
+		fileSize = loadedFile.Num();
+	}
+
+	header = _Section<FNeo4jMappedGraphHeader>(0);
+	if (!_ValidateSections(fileSize) || (bValidateIndices && !_ValidateIndices()))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s is not a valid mapped graph file"), *filePath);
+		Close();
+		return false;
+	}
+
+	nodeIds = _Section<int32>(header->nodeIdsOffset);
+	nodeLabelStarts = _Section<uint32>(header->nodeLabelStartsOffset);
+	nodeLabels = _Section<uint32>(header->nodeLabelsOffset);
+	labels = _Section<FNeo4jMappedLabel>(header->labelsOffset);
+	labelNodes = _Section<uint32>(header->labelNodesOffset);
+	outStarts = _Section<uint32>(header->outStartsOffset);
+	outEdges = _Section<FNeo4jMappedEdge>(header->outEdgesOffset);
+	inStarts = _Section<uint32>(header->inStartsOffset);
+	inEdges = _Section<FNeo4jMappedEdge>(header->inEdgesOffset);
+	stringStarts = _Section<uint64>(header->stringStartsOffset);
+	stringData = _Section<uint8>(header->stringDataOffset);
+	columns = _Section<FNeo4jMappedColumn>(header->columnsOffset);
+
+	return true;
+}
+
+void FNeo4jMappedGraph::Close()
+{
+	//region has to go before the handle it was mapped from
+	mappedRegion.Reset();
+	mappedFile.Reset();
+	loadedFile.Empty();
+
+	data = nullptr;
+	header = nullptr;
+}
+
+//only the header and the small label and column tables are read, the sections they point at are checked against the
+//file size without touching their pages. Start tables are read at their last entry, which bounds every range in them
+bool FNeo4jMappedGraph::_ValidateSections(int64 fileSize) const
+{
+	const uint64 size = fileSize;
+	auto fits = [size](uint64 offset, uint64 numBytes)
+	{
+		return offset % 8 == 0 && offset <= size && numBytes <= size - offset;
+	};
+
+	if (!fits(0, sizeof(FNeo4jMappedGraphHeader)) || header->magic != MAPPED_GRAPH_MAGIC
+		|| header->formatVersion != MAPPED_GRAPH_FORMAT_VERSION)
+		return false;
+
+	const uint64 numNodes = header->numNodes;
+	const uint64 numRelationships = header->numRelationships;
+
+	if (!fits(header->nodeIdsOffset, numNodes * sizeof(int32))
+		|| !fits(header->nodeLabelStartsOffset, (numNodes + 1) * sizeof(uint32))
+		|| !fits(header->labelsOffset, (uint64)header->numLabels * sizeof(FNeo4jMappedLabel))
+		|| !fits(header->outStartsOffset, (numNodes + 1) * sizeof(uint32))
+		|| !fits(header->outEdgesOffset, numRelationships * sizeof(FNeo4jMappedEdge))
+		|| !fits(header->inStartsOffset, (numNodes + 1) * sizeof(uint32))
+		|| !fits(header->inEdgesOffset, numRelationships * sizeof(FNeo4jMappedEdge))
+		|| !fits(header->stringStartsOffset, ((uint64)header->numStrings + 1) * sizeof(uint64))
+		|| !fits(header->columnsOffset, (uint64)header->numColumns * sizeof(FNeo4jMappedColumn)))
+		return false;
+
+	if (!fits(header->nodeLabelsOffset, (uint64)_Section<uint32>(header->nodeLabelStartsOffset)[numNodes] * sizeof(uint32))
+		|| _Section<uint32>(header->outStartsOffset)[numNodes] > numRelationships
+		|| _Section<uint32>(header->inStartsOffset)[numNodes] > numRelationships
+		|| !fits(header->stringDataOffset, 0)
+		|| _Section<uint64>(header->stringStartsOffset)[header->numStrings] > size - header->stringDataOffset)
+		return false;
+
+	const FNeo4jMappedLabel* labelTable = _Section<FNeo4jMappedLabel>(header->labelsOffset);
+	for (uint32 i = 0; i < header->numLabels; i++)
+	{
+		if (!fits(header->labelNodesOffset, ((uint64)labelTable[i].firstNode + labelTable[i].numNodes) * sizeof(uint32)))
+			return false;
+	}
+
+	const FNeo4jMappedColumn* columnTable = _Section<FNeo4jMappedColumn>(header->columnsOffset);
+	for (uint32 i = 0; i < header->numColumns; i++)
+	{
+		const FNeo4jMappedColumn& column = columnTable[i];
+		if ((uint8)column.type > (uint8)ENeo4jMappedColumnType::String)
+			return false;
+
+		uint64 valueSize = column.type == ENeo4jMappedColumnType::Number ? sizeof(double)
+			: (column.type == ENeo4jMappedColumnType::Bool ? sizeof(uint8) : sizeof(uint32));
+
+		if (!fits(column.presentOffset, (numNodes + 7) / 8) || !fits(column.valuesOffset, numNodes * valueSize))
+			return false;
+	}
+
+	return true;
+}
+
+//every stored index against the count of the table it points into. Touches every page once, so it is only done when
+//asked for, the readers check what they follow otherwise
+bool FNeo4jMappedGraph::_ValidateIndices() const
+{
+	const uint64 numNodes = header->numNodes;
+	const uint64 numRelationships = header->numRelationships;
+	const uint64 numStrings = header->numStrings;
+
+	const uint32* labelStarts = _Section<uint32>(header->nodeLabelStartsOffset);
+	const uint32* outStartTable = _Section<uint32>(header->outStartsOffset);
+	const uint32* inStartTable = _Section<uint32>(header->inStartsOffset);
+	for (uint64 i = 0; i < numNodes; i++)
+	{
+		if (labelStarts[i] > labelStarts[i + 1] || outStartTable[i] > outStartTable[i + 1] || inStartTable[i] > inStartTable[i + 1])
+			return false;
+	}
+
+	const uint32* nodeLabelTable = _Section<uint32>(header->nodeLabelsOffset);
+	for (uint64 i = 0; i < labelStarts[numNodes]; i++)
+	{
+		if (nodeLabelTable[i] >= numStrings)
+			return false;
+	}
+
+	const FNeo4jMappedEdge* edgeTables[] = { _Section<FNeo4jMappedEdge>(header->outEdgesOffset), _Section<FNeo4jMappedEdge>(header->inEdgesOffset) };
+	for (const FNeo4jMappedEdge* edgeTable : edgeTables)
+	{
+		for (uint64 i = 0; i < numRelationships; i++)
+		{
+			if (edgeTable[i].node >= numNodes || edgeTable[i].type >= numStrings)
+				return false;
+		}
+	}
+
+	const FNeo4jMappedLabel* labelTable = _Section<FNeo4jMappedLabel>(header->labelsOffset);
+	const uint32* labelNodeTable = _Section<uint32>(header->labelNodesOffset);
+	for (uint32 i = 0; i < header->numLabels; i++)
+	{
+		if (labelTable[i].name >= numStrings)
+			return false;
+
+		for (uint64 j = labelTable[i].firstNode; j < (uint64)labelTable[i].firstNode + labelTable[i].numNodes; j++)
+		{
+			if (labelNodeTable[j] >= numNodes)
+				return false;
+		}
+	}
+
+	const uint64* stringStartTable = _Section<uint64>(header->stringStartsOffset);
+	for (uint64 i = 0; i < numStrings; i++)
+	{
+		if (stringStartTable[i] > stringStartTable[i + 1])
+			return false;
+	}
+
+	const FNeo4jMappedColumn* columnTable = _Section<FNeo4jMappedColumn>(header->columnsOffset);
+	for (uint32 i = 0; i < header->numColumns; i++)
+	{
+		const FNeo4jMappedColumn& column = columnTable[i];
+		if (column.key >= numStrings)
+			return false;
+
+		if (column.type != ENeo4jMappedColumnType::String)
+			continue;
+
+		const uint32* values = _Section<uint32>(column.valuesOffset);
+		for (int32 j = 0; j < (int32)numNodes; j++)
+		{
+			if (_IsPresent(data, column, j) && values[j] >= numStrings)
+				return false;
+		}
+	}
+
+	return true;
+}
+
+int32 FNeo4jMappedGraph::FindNode(int nodeID) const
+{
+	int32 low = 0;
+	int32 high = header->numNodes;
+	while (low < high)
+	{
+		int32 middle = low + (high - low) / 2;
+		if (nodeIds[middle] < nodeID)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+
+	return low < (int32)header->numNodes && nodeIds[low] == nodeID ? low : INDEX_NONE;
+}
+
+//the last start was checked on open, so a range that ends by it and doesn't run backwards stays inside its section
+template<typename T>
+static TArrayView<const T> _Range(const T* elements, const uint32* starts, int32 index, int32 numNodes)
+{
+	if (starts[index] > starts[index + 1] || starts[index + 1] > starts[numNodes])
+		return TArrayView<const T>();
+
+	return TArrayView<const T>(elements + starts[index], starts[index + 1] - starts[index]);
+}
+
+TArrayView<const uint32> FNeo4jMappedGraph::GetNodeLabels(int32 index) const
+{
+	return IsValidIndex(index) ? _Range(nodeLabels, nodeLabelStarts, index, header->numNodes) : TArrayView<const uint32>();
+}
+
+TArrayView<const FNeo4jMappedEdge> FNeo4jMappedGraph::GetOutgoingEdges(int32 index) const
+{
+	return IsValidIndex(index) ? _Range(outEdges, outStarts, index, header->numNodes) : TArrayView<const FNeo4jMappedEdge>();
+}
+
+TArrayView<const FNeo4jMappedEdge> FNeo4jMappedGraph::GetIncomingEdges(int32 index) const
+{
+	return IsValidIndex(index) ? _Range(inEdges, inStarts, index, header->numNodes) : TArrayView<const FNeo4jMappedEdge>();
+}
+
+TArrayView<const uint32> FNeo4jMappedGraph::GetNodesWithLabel(const FString& label) const
+{
+	uint32 name = FindString(label);
+	if (name == MAX_uint32)
+		return TArrayView<const uint32>();
+
+	int32 low = 0;
+	int32 high = header->numLabels;
+	while (low < high)
+	{
+		int32 middle = low + (high - low) / 2;
+		if (labels[middle].name < name)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+
+	if (low >= (int32)header->numLabels || labels[low].name != name)
+		return TArrayView<const uint32>();
+
+	return TArrayView<const uint32>(labelNodes + labels[low].firstNode, labels[low].numNodes);
+}
+
+void FNeo4jMappedGraph::GetNeighbours(int32 index, ENeo4jDirection direction, const TArray<FString>& typeFilter, TArray<int32>& outIndices) const
+{
+	TArray<uint32, TInlineAllocator<8>> types;
+	for (auto& type : typeFilter)
+	{
+		uint32 typeIndex = FindString(type);
+		if (typeIndex != MAX_uint32)
+			types.Add(typeIndex);
+	}
+
+	//every requested type is unknown, nothing can match
+	if (typeFilter.Num() > 0 && types.Num() == 0)
+		return;
+
+	auto addEdges = [this, &types, &outIndices](TArrayView<const FNeo4jMappedEdge> edges)
+	{
+		for (const FNeo4jMappedEdge& edge : edges)
+		{
+			if ((types.Num() == 0 || types.Contains(edge.type)) && edge.node < header->numNodes)
+				outIndices.Add(edge.node);
+		}
+	};
+
+	if (direction != ENeo4jDirection::Incoming)
+		addEdges(GetOutgoingEdges(index));
+
+	if (direction != ENeo4jDirection::Outgoing)
+		addEdges(GetIncomingEdges(index));
+}
+
+const FNeo4jMappedColumn* FNeo4jMappedGraph::_FindColumn(const FString& key) const
+{
+	uint32 name = FindString(key);
+	if (name == MAX_uint32)
+		return nullptr;
+
+	int32 low = 0;
+	int32 high = header->numColumns;
+	while (low < high)
+	{
+		int32 middle = low + (high - low) / 2;
+		if (columns[middle].key < name)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+
+	return low < (int32)header->numColumns && columns[low].key == name ? &columns[low] : nullptr;
+}
+
+bool FNeo4jMappedGraph::_IsPresent(const uint8* fileData, const FNeo4jMappedColumn& column, int32 index)
+{
+	return (fileData[column.presentOffset + index / 8] & (1 << (index % 8))) != 0;
+}
+
+bool FNeo4jMappedGraph::GetNumberProperty(int32 index, const FString& key, double& outValue) const
+{
+	if (!IsValidIndex(index))
+		return false;
+
+	const FNeo4jMappedColumn* column = _FindColumn(key);
+	if (!column || column->type != ENeo4jMappedColumnType::Number || !_IsPresent(data, *column, index))
+		return false;
+
+	outValue = _Section<double>(column->valuesOffset)[index];
+	return true;
+}
+
+bool FNeo4jMappedGraph::GetBoolProperty(int32 index, const FString& key, bool& outValue) const
+{
+	if (!IsValidIndex(index))
+		return false;
+
+	const FNeo4jMappedColumn* column = _FindColumn(key);
+	if (!column || column->type != ENeo4jMappedColumnType::Bool || !_IsPresent(data, *column, index))
+		return false;
+
+	outValue = _Section<uint8>(column->valuesOffset)[index] != 0;
+	return true;
+}
+
+bool FNeo4jMappedGraph::GetStringProperty(int32 index, const FString& key, FString& outValue) const
+{
+	if (!IsValidIndex(index))
+		return false;
+
+	const FNeo4jMappedColumn* column = _FindColumn(key);
+	if (!column || !_IsPresent(data, *column, index))
+		return false;
+
+	switch (column->type)
+	{
+	case ENeo4jMappedColumnType::Number:
+		outValue = FString::SanitizeFloat(_Section<double>(column->valuesOffset)[index]);
+		break;
+	case ENeo4jMappedColumnType::Bool:
+		outValue = _Section<uint8>(column->valuesOffset)[index] ? TEXT("true") : TEXT("false");
+		break;
+	default:
+		outValue = GetString(_Section<uint32>(column->valuesOffset)[index]);
+		break;
+	}
+
+	return true;
+}
+
+uint32 FNeo4jMappedGraph::FindString(const FString& string) const
+{
+	FTCHARToUTF8 utf8(*string);
+	const uint8* bytes = (const uint8*)utf8.Get();
+	const uint64 length = utf8.Length();
+
+	uint32 low = 0;
+	uint32 high = header->numStrings;
+	while (low < high)
+	{
+		uint32 middle = low + (high - low) / 2;
+
+		const uint8* middleBytes;
+		uint64 middleLength;
+		if (!_GetStringBytes(middle, middleBytes, middleLength))
+			return MAX_uint32;
+
+		int32 result = _CompareBytes(middleBytes, middleLength, bytes, length);
+		if (result == 0)
+			return middle;
+
+		if (result < 0)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+
+	return MAX_uint32;
+}
+
+bool FNeo4jMappedGraph::_GetStringBytes(uint32 stringIndex, const uint8*& outBytes, uint64& outLength) const
+{
+	//the last start was checked against the file size on open
+	if (stringIndex >= header->numStrings || stringStarts[stringIndex] > stringStarts[stringIndex + 1]
+		|| stringStarts[stringIndex + 1] > stringStarts[header->numStrings])
+		return false;
+
+	outBytes = stringData + stringStarts[stringIndex];
+	outLength = stringStarts[stringIndex + 1] - stringStarts[stringIndex];
+	return true;
+}
+
+FString FNeo4jMappedGraph::GetString(uint32 stringIndex) const
+{
+	const uint8* bytes;
+	uint64 length;
+	if (!_GetStringBytes(stringIndex, bytes, length))
+		return FString();
+
+	FUTF8ToTCHAR converted((const ANSICHAR*)bytes, length);
+	return FString(converted.Length(), converted.Get());
+}
+
+FNeo4jNode FNeo4jMappedGraph::MakeNode(int32 index) const
+{
+	FNeo4jNode node;
+	if (!IsValidIndex(index))
+		return node;
+
+	node.id = nodeIds[index];
+
+	for (uint32 label : GetNodeLabels(index))
+		node.labels.Add(GetString(label));
+
+	for (uint32 i = 0; i < header->numColumns; i++)
+	{
+		const FNeo4jMappedColumn& column = columns[i];
+		if (!_IsPresent(data, column, index))
+			continue;
+
+		TSharedPtr<FJsonValue> value;
+		switch (column.type)
+		{
+		case ENeo4jMappedColumnType::Number:
+			value = MakeShareable(new FJsonValueNumber(_Section<double>(column.valuesOffset)[index]));
+			break;
+		case ENeo4jMappedColumnType::Bool:
+			value = MakeShareable(new FJsonValueBoolean(_Section<uint8>(column.valuesOffset)[index] != 0));
+			break;
+		default:
+			value = MakeShareable(new FJsonValueString(GetString(_Section<uint32>(column.valuesOffset)[index])));
+			break;
+		}
+
+		node.properties.Add(GetString(column.key), value);
+	}
+
+	return node;
+}
+
+#pragma endregion MAPPED_GRAPH
+
+
+#pragma region EXPORT
+
+uint32 FNeo4jMappedGraphBuilder::_Intern(const FString& string)
+{
+	if (const uint32* id = stringIds.Find(string))
+		return *id;
+
+	uint32 id = stringIds.Num();
+	stringIds.Add(string, id);
+	return id;
+}
+
+void FNeo4jMappedGraphBuilder::AddNodes(const TArray<FNeo4jNode>& nodes)
+{
+	if (nodeLabelStarts.Num() == 0)
+		nodeLabelStarts.Add(0);
+
+	for (auto& node : nodes)
+	{
+		const uint32 nodeIndex = nodeIds.Add(node.id);
+
+		for (auto& label : node.labels)
+			nodeLabels.Add(_Intern(label));
+		nodeLabelStarts.Add(nodeLabels.Num());
+
+		//a column takes the type of the first value seen for its key, values of another type are left out
+		for (auto& property : node.properties)
+		{
+			ENeo4jMappedColumnType type;
+			if (!_GetColumnType(property.Value, type))
+				continue;
+
+			int32* columnIndex = columnOfKey.Find(property.Key);
+			if (!columnIndex)
+			{
+				FColumn& column = columns.AddDefaulted_GetRef();
+				column.key = _Intern(property.Key);
+				column.type = type;
+				columnIndex = &columnOfKey.Add(property.Key, columns.Num() - 1);
+			}
+
+			FColumn& column = columns[*columnIndex];
+			if (column.type != type)
+				continue;
+
+			FCell& cell = column.cells.AddZeroed_GetRef();
+			cell.node = nodeIndex;
+			switch (type)
+			{
+			case ENeo4jMappedColumnType::Number:	cell.number = property.Value->AsNumber(); break;
+			case ENeo4jMappedColumnType::Bool:		cell.number = property.Value->AsBool() ? 1.0 : 0.0; break;
+			default:								cell.string = _Intern(_ValueToText(property.Value)); break;
+			}
+		}
+	}
+}
+
+void FNeo4jMappedGraphBuilder::AddRelationships(const TArray<FNeo4jRelationship>& inRelationships)
+{
+	relationships.Reserve(relationships.Num() + inRelationships.Num());
+	for (auto& relationship : inRelationships)
+	{
+		FRelationship& entry = relationships.AddDefaulted_GetRef();
+		entry.id = relationship.id;
+		entry.type = _Intern(relationship.type);
+		entry.startNode = relationship.startNode;
+		entry.endNode = relationship.endNode;
+	}
+}
+
+void FNeo4jMappedGraphBuilder::Reset()
+{
+	dataVersion = 0;
+	nodeIds.Empty();
+	nodeLabelStarts.Empty();
+	nodeLabels.Empty();
+	stringIds.Empty();
+	columnOfKey.Empty();
+	columns.Empty();
+	relationships.Empty();
+}
+
+//sections are streamed to a temporary file in paged writes, only the per node and per relationship indices needed
+//to order them are kept in memory. The header is written last, once every offset is known
+bool FNeo4jMappedGraphBuilder::Write(const FString& filePath) const
+{
+	const int32 numNodes = nodeIds.Num();
+
+	//nodes are stored in ascending id order
+	TArray<int32> order;
+	order.SetNum(numNodes);
+	for (int32 i = 0; i < numNodes; i++)
+		order[i] = i;
+	order.Sort([this](int32 a, int32 b) { return nodeIds[a] < nodeIds[b]; });
+
+	TArray<uint32> sortedIndexOf;
+	sortedIndexOf.SetNumUninitialized(numNodes);
+	TMap<int, uint32> indexOfID;
+	indexOfID.Reserve(numNodes);
+	for (int32 i = 0; i < numNodes; i++)
+	{
+		sortedIndexOf[order[i]] = i;
+		indexOfID.Add(nodeIds[order[i]], i);
+	}
+
+	//string table, unique and sorted bytewise. sortedString maps an interned id to its place in the table
+	TArray<TArray<uint8>> utf8Strings;
+	utf8Strings.SetNum(stringIds.Num());
+	for (auto& string : stringIds)
+	{
+		FTCHARToUTF8 utf8(*string.Key);
+		utf8Strings[string.Value].Append((const uint8*)utf8.Get(), utf8.Length());
+	}
+
+	TArray<int32> stringOrder;
+	stringOrder.SetNum(utf8Strings.Num());
+	for (int32 i = 0; i < utf8Strings.Num(); i++)
+		stringOrder[i] = i;
+	stringOrder.Sort([&utf8Strings](int32 a, int32 b)
+	{
+		return _CompareBytes(utf8Strings[a].GetData(), utf8Strings[a].Num(), utf8Strings[b].GetData(), utf8Strings[b].Num()) < 0;
+	});
+
+	TArray<uint32> sortedString;
+	sortedString.SetNumUninitialized(stringOrder.Num());
+	for (int32 i = 0; i < stringOrder.Num(); i++)
+		sortedString[stringOrder[i]] = i;
+
+	//reverse label index
+	TMap<uint32, TArray<uint32>> labelMembers;
+	for (int32 i = 0; i < numNodes; i++)
+	{
+		for (uint32 j = nodeLabelStarts[order[i]]; j < nodeLabelStarts[order[i] + 1]; j++)
+			labelMembers.FindOrAdd(sortedString[nodeLabels[j]]).Add(i);
+	}
+	labelMembers.KeySort(TLess<uint32>());
+
+	//csr adjacency, relationships leaving the graph are dropped
+	TArray<const FRelationship*> keptRelationships;
+	TArray<uint32> startOfRelationship;
+	TArray<uint32> endOfRelationship;
+	TArray<uint32> outStarts;
+	TArray<uint32> inStarts;
+	outStarts.SetNumZeroed(numNodes + 1);
+	inStarts.SetNumZeroed(numNodes + 1);
+
+	for (auto& relationship : relationships)
+	{
+		const uint32* start = indexOfID.Find(relationship.startNode);
+		const uint32* end = indexOfID.Find(relationship.endNode);
+		if (!start || !end)
+			continue;
+
+		keptRelationships.Add(&relationship);
+		startOfRelationship.Add(*start);
+		endOfRelationship.Add(*end);
+		outStarts[*start + 1]++;
+		inStarts[*end + 1]++;
+	}
+
+	indexOfID.Empty();
+
+	for (int32 i = 0; i < numNodes; i++)
+	{
+		outStarts[i + 1] += outStarts[i];
+		inStarts[i + 1] += inStarts[i];
+	}
+
+	IPlatformFile& platformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const FString tempPath = filePath + TEXT(".tmp");
+
+	TUniquePtr<IFileHandle> file(platformFile.OpenWrite(*tempPath));
+	if (!file.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Could not write mapped graph to %s"), *filePath);
+		return false;
+	}
+
+	bool bFailed = false;
+
+	FNeo4jMappedGraphHeader header;
+	FMemory::Memzero(header);
+	header.magic = MAPPED_GRAPH_MAGIC;
+	header.formatVersion = MAPPED_GRAPH_FORMAT_VERSION;
+	header.dataVersion = dataVersion;
+	header.numNodes = numNodes;
+	header.numRelationships = keptRelationships.Num();
+	header.numStrings = utf8Strings.Num();
+	header.numLabels = labelMembers.Num();
+	header.numColumns = columns.Num();
+
+	//placeholder, rewritten at the end
+	if (!file->Write((const uint8*)&header, sizeof(header)))
+		bFailed = true;
+
+	{
+		TNeo4jMappedSectionWriter<int32> section(*file, bFailed);
+		for (int32 i = 0; i < numNodes; i++)
+			section.Add(nodeIds[order[i]]);
+		header.nodeIdsOffset = section.Finish();
+	}
+	{
+		TNeo4jMappedSectionWriter<uint32> section(*file, bFailed);
+		uint32 numNodeLabels = 0;
+		for (int32 i = 0; i < numNodes; i++)
+		{
+			section.Add(numNodeLabels);
+			numNodeLabels += nodeLabelStarts[order[i] + 1] - nodeLabelStarts[order[i]];
+		}
+		section.Add(numNodeLabels);
+		header.nodeLabelStartsOffset = section.Finish();
+	}
+	{
+		TNeo4jMappedSectionWriter<uint32> section(*file, bFailed);
+		for (int32 i = 0; i < numNodes; i++)
+		{
+			for (uint32 j = nodeLabelStarts[order[i]]; j < nodeLabelStarts[order[i] + 1]; j++)
+				section.Add(sortedString[nodeLabels[j]]);
+		}
+		header.nodeLabelsOffset = section.Finish();
+	}
+	{
+		TNeo4jMappedSectionWriter<FNeo4jMappedLabel> section(*file, bFailed);
+		uint32 firstNode = 0;
+		for (auto& members : labelMembers)
+		{
+			FNeo4jMappedLabel label;
+			FMemory::Memzero(label);
+			label.name = members.Key;
+			label.firstNode = firstNode;
+			label.numNodes = members.Value.Num();
+			section.Add(label);
+
+			firstNode += label.numNodes;
+		}
+		header.labelsOffset = section.Finish();
+	}
+	{
+		TNeo4jMappedSectionWriter<uint32> section(*file, bFailed);
+		for (auto& members : labelMembers)
+		{
+			for (uint32 member : members.Value)
+				section.Add(member);
+		}
+		header.labelNodesOffset = section.Finish();
+	}
+	labelMembers.Empty();
+
+	auto writeEdges = [&](const TArray<uint32>& starts, const TArray<uint32>& nodeOfRelationship, const TArray<uint32>& otherNodeOfRelationship,
+		uint64& outStartsOffset, uint64& outEdgesOffset)
+	{
+		{
+			TNeo4jMappedSectionWriter<uint32> section(*file, bFailed);
+			for (uint32 start : starts)
+				section.Add(start);
+			outStartsOffset = section.Finish();
+		}
+
+		TNeo4jMappedSectionWriter<FNeo4jMappedEdge> section(*file, bFailed);
+		for (int32 relationshipIndex : _GroupByNode(nodeOfRelationship, starts))
+		{
+			const FRelationship* relationship = keptRelationships[relationshipIndex];
+
+			FNeo4jMappedEdge edge;
+			FMemory::Memzero(edge);
+			edge.node = otherNodeOfRelationship[relationshipIndex];
+			edge.type = sortedString[relationship->type];
+			edge.relationshipId = relationship->id;
+			section.Add(edge);
+		}
+		outEdgesOffset = section.Finish();
+	};
+
+	writeEdges(outStarts, startOfRelationship, endOfRelationship, header.outStartsOffset, header.outEdgesOffset);
+	writeEdges(inStarts, endOfRelationship, startOfRelationship, header.inStartsOffset, header.inEdgesOffset);
+
+	{
+		TNeo4jMappedSectionWriter<uint64> section(*file, bFailed);
+		uint64 numBytes = 0;
+		for (int32 stringIndex : stringOrder)
+		{
+			section.Add(numBytes);
+			numBytes += utf8Strings[stringIndex].Num();
+		}
+		section.Add(numBytes);
+		header.stringStartsOffset = section.Finish();
+	}
+	{
+		TNeo4jMappedSectionWriter<uint8> section(*file, bFailed);
+		for (int32 stringIndex : stringOrder)
+		{
+			for (uint8 byte : utf8Strings[stringIndex])
+				section.Add(byte);
+		}
+		header.stringDataOffset = section.Finish();
+	}
+	utf8Strings.Empty();
+
+	//columns one at a time, the table goes last since it points at them
+	TArray<const FColumn*> sortedColumns;
+	for (auto& column : columns)
+		sortedColumns.Add(&column);
+	sortedColumns.Sort([&sortedString](const FColumn& a, const FColumn& b) { return sortedString[a.key] < sortedString[b.key]; });
+
+	TArray<FNeo4jMappedColumn> columnTable;
+	TArray<int32> cellOfNode;
+	for (const FColumn* builtColumn : sortedColumns)
+	{
+		FNeo4jMappedColumn& column = columnTable.AddZeroed_GetRef();
+		column.key = sortedString[builtColumn->key];
+		column.type = builtColumn->type;
+
+		cellOfNode.Init(INDEX_NONE, numNodes);
+		for (int32 i = 0; i < builtColumn->cells.Num(); i++)
+			cellOfNode[sortedIndexOf[builtColumn->cells[i].node]] = i;
+
+		{
+			TNeo4jMappedSectionWriter<uint8> section(*file, bFailed);
+			uint8 presentBits = 0;
+			for (int32 i = 0; i < numNodes; i++)
+			{
+				if (cellOfNode[i] != INDEX_NONE)
+					presentBits |= 1 << (i % 8);
+
+				if (i % 8 == 7 || i == numNodes - 1)
+				{
+					section.Add(presentBits);
+					presentBits = 0;
+				}
+			}
+			column.presentOffset = section.Finish();
+		}
+
+		switch (column.type)
+		{
+		case ENeo4jMappedColumnType::Number:
+		{
+			TNeo4jMappedSectionWriter<double> section(*file, bFailed);
+			for (int32 i = 0; i < numNodes; i++)
+				section.Add(cellOfNode[i] != INDEX_NONE ? builtColumn->cells[cellOfNode[i]].number : 0.0);
+			column.valuesOffset = section.Finish();
+			break;
+		}
+		case ENeo4jMappedColumnType::Bool:
+		{
+			TNeo4jMappedSectionWriter<uint8> section(*file, bFailed);
+			for (int32 i = 0; i < numNodes; i++)
+				section.Add((uint8)(cellOfNode[i] != INDEX_NONE && builtColumn->cells[cellOfNode[i]].number != 0.0 ? 1 : 0));
+			column.valuesOffset = section.Finish();
+			break;
+		}
+		default:
+		{
+			TNeo4jMappedSectionWriter<uint32> section(*file, bFailed);
+			for (int32 i = 0; i < numNodes; i++)
+				section.Add(cellOfNode[i] != INDEX_NONE ? sortedString[builtColumn->cells[cellOfNode[i]].string] : 0);
+			column.valuesOffset = section.Finish();
+			break;
+		}
+		}
+	}
+
+	{
+		TNeo4jMappedSectionWriter<FNeo4jMappedColumn> section(*file, bFailed);
+		for (const FNeo4jMappedColumn& column : columnTable)
+			section.Add(column);
+		header.columnsOffset = section.Finish();
+	}
+
+	if (!file->Seek(0) || !file->Write((const uint8*)&header, sizeof(header)) || !file->Flush())
+		bFailed = true;
+
+	file.Reset();
+
+	//the previous file is only replaced by a complete one
+	if (bFailed || (platformFile.FileExists(*filePath) && !platformFile.DeleteFile(*filePath)) || !platformFile.MoveFile(*filePath, *tempPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Could not write mapped graph to %s"), *filePath);
+		platformFile.DeleteFile(*tempPath);
+		return false;
+	}
+
+	return true;
+}
+
+bool UNeo4jMappedGraph::ExportMappedGraph(const FNeo4jSubgraph& subgraph, const FString& filePath)
+{
+	FNeo4jMappedGraphBuilder builder;
+	builder.SetDataVersion(subgraph.dataVersion);
+	builder.AddNodes(subgraph.nodes);
+	builder.AddRelationships(subgraph.relationships);
+
+	return builder.Write(filePath);
+}
+
+#pragma endregion EXPORT
+
+
+#pragma region QUERIES
+
+UNeo4jMappedGraph* UNeo4jMappedGraph::OpenMappedGraph(const FString& filePath, bool bValidateIndices)
+{
+	UNeo4jMappedGraph* mappedGraph = NewObject<UNeo4jMappedGraph>();
+	if (!mappedGraph->graph.Open(filePath, bValidateIndices))
+		return nullptr;
+
+	return mappedGraph;
+}
+
+void UNeo4jMappedGraph::BeginDestroy()
+{
+	graph.Close();
+
+	Super::BeginDestroy();
+}
+
+int UNeo4jMappedGraph::GetNumNodes() const
+{
+	return graph.IsOpen() ? graph.Num() : 0;
+}
+
+TArray<FNeo4jNode> UNeo4jMappedGraph::GetNodesByID(const TArray<int>& elementIDs) const
+{
+	TArray<FNeo4jNode> outNodes;
+	if (!graph.IsOpen())
+		return outNodes;
+
+	for (int id : elementIDs)
+	{
+		int32 index = graph.FindNode(id);
+		if (index != INDEX_NONE)
+			outNodes.Add(graph.MakeNode(index));
+	}
+
+	return outNodes;
+}
+
+TArray<int> UNeo4jMappedGraph::GetNodesByLabels(const TArray<FString>& labels) const
+{
+	TArray<int> outIDs;
+	if (!graph.IsOpen() || labels.Num() == 0)
+		return outIDs;
+
+	//walk the first label's nodes and check the rest on each of them
+	TArray<uint32> otherLabels;
+	for (int32 i = 1; i < labels.Num(); i++)
+	{
+		uint32 label = graph.FindString(labels[i]);
+		if (label == MAX_uint32)
+			return outIDs;
+
+		otherLabels.Add(label);
+	}
+
+	for (uint32 index : graph.GetNodesWithLabel(labels[0]))
+	{
+		if (!graph.IsValidIndex(index))
+			continue;
+
+		TArrayView<const uint32> nodeLabels = graph.GetNodeLabels(index);
+
+		bool bHasAll = true;
+		for (uint32 label : otherLabels)
+			bHasAll = bHasAll && nodeLabels.Contains(label);
+
+		if (bHasAll)
+			outIDs.Add(graph.GetNodeID(index));
+	}
+
+	return outIDs;
+}
+
+TArray<FString> UNeo4jMappedGraph::GetNodeLabels(int nodeID) const
+{
+	TArray<FString> outLabels;
+	int32 index = graph.IsOpen() ? graph.FindNode(nodeID) : INDEX_NONE;
+	if (index == INDEX_NONE)
+		return outLabels;
+
+	for (uint32 label : graph.GetNodeLabels(index))
+		outLabels.Add(graph.GetString(label));
+
+	return outLabels;
+}
+
+TArray<int> UNeo4jMappedGraph::GetNodeNeighbours(int nodeID) const
+{
+	return _GetNeighbourIDs(nodeID, ENeo4jDirection::Both, TArray<FString>());
+}
+
+TArray<int> UNeo4jMappedGraph::GetNodeNeighboursByTypes(int nodeID, const TArray<FString>& relationTypes) const
+{
+	return _GetNeighbourIDs(nodeID, ENeo4jDirection::Both, relationTypes);
+}
+
+TArray<int> UNeo4jMappedGraph::GetIncomingNeighboursFromNode(int nodeID) const
+{
+	return _GetNeighbourIDs(nodeID, ENeo4jDirection::Incoming, TArray<FString>());
+}
+
+TArray<int> UNeo4jMappedGraph::GetOutgoingNeighboursFromNode(int nodeID) const
+{
+	return _GetNeighbourIDs(nodeID, ENeo4jDirection::Outgoing, TArray<FString>());
+}
+
+TArray<int> UNeo4jMappedGraph::GetIncomingNeighboursByTypes(int nodeID, const TArray<FString>& relationTypes) const
+{
+	return _GetNeighbourIDs(nodeID, ENeo4jDirection::Incoming, relationTypes);
+}
+
+TArray<int> UNeo4jMappedGraph::GetOutgoingNeighboursByTypes(int nodeID, const TArray<FString>& relationTypes) const
+{
+	return _GetNeighbourIDs(nodeID, ENeo4jDirection::Outgoing, relationTypes);
+}
+
+bool UNeo4jMappedGraph::GetIntProperty(int nodeID, const FString& property, int& outValue) const
+{
+	double value;
+	int32 index = graph.IsOpen() ? graph.FindNode(nodeID) : INDEX_NONE;
+	if (index == INDEX_NONE || !graph.GetNumberProperty(index, property, value))
+		return false;
+
+	outValue = (int)value;
+	return true;
+}
+
+bool UNeo4jMappedGraph::GetFloatProperty(int nodeID, const FString& property, float& outValue) const
+{
+	double value;
+	int32 index = graph.IsOpen() ? graph.FindNode(nodeID) : INDEX_NONE;
+	if (index == INDEX_NONE || !graph.GetNumberProperty(index, property, value))
+		return false;
+
+	outValue = (float)value;
+	return true;
+}
+
+bool UNeo4jMappedGraph::GetBoolProperty(int nodeID, const FString& property, bool& outValue) const
+{
+	int32 index = graph.IsOpen() ? graph.FindNode(nodeID) : INDEX_NONE;
+	return index != INDEX_NONE && graph.GetBoolProperty(index, property, outValue);
+}
+
+bool UNeo4jMappedGraph::GetStringProperty(int nodeID, const FString& property, FString& outValue) const
+{
+	int32 index = graph.IsOpen() ? graph.FindNode(nodeID) : INDEX_NONE;
+	return index != INDEX_NONE && graph.GetStringProperty(index, property, outValue);
+}
+
+TArray<int> UNeo4jMappedGraph::_GetNeighbourIDs(int nodeID, ENeo4jDirection direction, const TArray<FString>& relationTypes) const
+{
+	TArray<int> outIDs;
+	int32 index = graph.IsOpen() ? graph.FindNode(nodeID) : INDEX_NONE;
+	if (index == INDEX_NONE)
+		return outIDs;
+
+	TArray<int32> neighbours;
+	graph.GetNeighbours(index, direction, relationTypes, neighbours);
+
+	outIDs.Reserve(neighbours.Num());
+	for (int32 neighbour : neighbours)
+		outIDs.Add(graph.GetNodeID(neighbour));
+
+	return outIDs;
+}
+
+#pragma endregion QUERIES
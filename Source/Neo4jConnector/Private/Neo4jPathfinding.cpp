@@ -0,0 +1,192 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Neo4jPathfinding.h"
+
+#include "Algo/Reverse.h"
+#include "Dom/JsonValue.h"
+
+
+#pragma region PATH_GRAPH
+
+void FNeo4jPathGraph::Build(const FNeo4jSubgraph& inSubgraph, const FString& weightProperty, const TArray<FString>& relationTypes,
+	ENeo4jDirection direction, double defaultWeight)
+{
+	subgraph = &inSubgraph;
+
+	const int32 numNodes = inSubgraph.nodes.Num();
+
+	indexOfID.Reset();
+	indexOfID.Reserve(numNodes);
+	for (int32 i = 0; i < numNodes; i++)
+		indexOfID.Add(inSubgraph.nodes[i].id, i);
+
+	//edges are collected as (from, edge) pairs first and packed into csr afterwards
+	TArray<TPair<int32, FEdge>> pendingEdges;
+	pendingEdges.Reserve(direction == ENeo4jDirection::Both ? inSubgraph.relationships.Num() * 2 : inSubgraph.relationships.Num());
+
+	for (int32 i = 0; i < inSubgraph.relationships.Num(); i++)
+	{
+		const FNeo4jRelationship& relationship = inSubgraph.relationships[i];
+		if (relationTypes.Num() > 0 && !relationTypes.Contains(relationship.type))
+			continue;
+
+		const int32* start = indexOfID.Find(relationship.startNode);
+		const int32* end = indexOfID.Find(relationship.endNode);
+		if (!start || !end)
+			continue;
+
+		double weight = defaultWeight;
+		const TSharedPtr<FJsonValue>* weightValue = weightProperty.IsEmpty() ? nullptr : relationship.properties.Find(weightProperty);
+		if (weightValue && weightValue->IsValid())
+			(*weightValue)->TryGetNumber(weight);
+
+		//dijkstra can't handle negative weights
+		if (weight < 0.0)
+			continue;
+
+		if (direction != ENeo4jDirection::Incoming)
+			pendingEdges.Emplace(*start, FEdge{ *end, i, weight });
+
+		if (direction != ENeo4jDirection::Outgoing)
+			pendingEdges.Emplace(*end, FEdge{ *start, i, weight });
+	}
+
+	edgeStarts.Reset();
+	edgeStarts.SetNumZeroed(numNodes + 1);
+	for (auto& pending : pendingEdges)
+		edgeStarts[pending.Key + 1]++;
+
+	for (int32 i = 0; i < numNodes; i++)
+		edgeStarts[i + 1] += edgeStarts[i];
+
+	edges.Reset();
+	edges.SetNumUninitialized(pendingEdges.Num());
+	TArray<int32> cursor = edgeStarts;
+	for (auto& pending : pendingEdges)
+		edges[cursor[pending.Key]++] = pending.Value;
+}
+
+int32 FNeo4jPathGraph::FindNode(int nodeID) const
+{
+	const int32* index = indexOfID.Find(nodeID);
+	return index ? *index : INDEX_NONE;
+}
+
+bool FNeo4jPathGraph::FindPath(int startNodeID, int endNodeID, FNeo4jPath& outPath, TFunction<double(int32 fromIndex, int32 toIndex)> heuristic,
+	int32 maxExpandedNodes) const
+{
+	outPath = FNeo4jPath();
+
+	const int32 start = FindNode(startNodeID);
+	const int32 goal = FindNode(endNodeID);
+	if (!subgraph || start == INDEX_NONE || goal == INDEX_NONE)
+		return false;
+
+	struct FOpenEntry
+	{
+		double priority;
+		int32 node;
+	};
+
+	const int32 numNodes = subgraph->nodes.Num();
+	TArray<double> costs;
+	TArray<int32> previousEdge;
+	TArray<int32> previousNode;
+	TBitArray<> closed(false, numNodes);
+	costs.Init(TNumericLimits<double>::Max(), numNodes);
+	previousEdge.Init(INDEX_NONE, numNodes);
+	previousNode.Init(INDEX_NONE, numNodes);
+
+	auto lowestFirst = [](const FOpenEntry& a, const FOpenEntry& b) { return a.priority < b.priority; };
+
+	TArray<FOpenEntry> open;
+	costs[start] = 0.0;
+	open.HeapPush(FOpenEntry{ heuristic ? heuristic(start, goal) : 0.0, start }, lowestFirst);
+
+	int32 numExpanded = 0;
+	while (open.Num() > 0)
+	{
+		FOpenEntry current;
+		open.HeapPop(current, lowestFirst, false);
+
+		//stale entries are left in the heap instead of decreasing keys
+		if (closed[current.node])
+			continue;
+
+		if (current.node == goal)
+			break;
+
+		closed[current.node] = true;
+		if (maxExpandedNodes > 0 && ++numExpanded > maxExpandedNodes)
+			return false;
+
+		for (int32 e = edgeStarts[current.node]; e < edgeStarts[current.node + 1]; e++)
+		{
+			const FEdge& edge = edges[e];
+			double cost = costs[current.node] + edge.weight;
+			if (closed[edge.node] || cost >= costs[edge.node])
+				continue;
+
+			costs[edge.node] = cost;
+			previousEdge[edge.node] = edge.relationship;
+			previousNode[edge.node] = current.node;
+			open.HeapPush(FOpenEntry{ cost + (heuristic ? heuristic(edge.node, goal) : 0.0), edge.node }, lowestFirst);
+		}
+	}
+
+	if (costs[goal] == TNumericLimits<double>::Max())
+		return false;
+
+	//walk back from the goal and reverse
+	for (int32 node = goal; node != INDEX_NONE; node = previousNode[node])
+	{
+		outPath.nodes.Add(subgraph->nodes[node]);
+		if (previousEdge[node] != INDEX_NONE)
+			outPath.relationships.Add(subgraph->relationships[previousEdge[node]]);
+	}
+
+	Algo::Reverse(outPath.nodes);
+	Algo::Reverse(outPath.relationships);
+	outPath.cost = costs[goal];
+
+	return true;
+}
+
+#pragma endregion PATH_GRAPH
+
+
+bool UNeo4jPathfinding::FindWeightedPath(const FNeo4jSubgraph& subgraph, int startNodeID, int endNodeID, const FString& weightProperty,
+	const TArray<FString>& relationTypes, ENeo4jDirection direction, FNeo4jPath& outPath)
+{
+	FNeo4jPathGraph graph;
+	graph.Build(subgraph, weightProperty, relationTypes, direction);
+
+	return graph.FindPath(startNodeID, endNodeID, outPath);
+}
+
+bool UNeo4jPathfinding::FindWeightedPathAStar(const FNeo4jSubgraph& subgraph, int startNodeID, int endNodeID, const FString& weightProperty,
+	const TArray<FString>& positionProperties, const TArray<FString>& relationTypes, ENeo4jDirection direction, FNeo4jPath& outPath)
+{
+	FNeo4jPathGraph graph;
+	graph.Build(subgraph, weightProperty, relationTypes, direction);
+
+	//positions are read once up front, missing components count as 0
+	TArray<FVector> positions;
+	positions.SetNumZeroed(subgraph.nodes.Num());
+	for (int32 i = 0; i < subgraph.nodes.Num(); i++)
+	{
+		for (int32 axis = 0; axis < FMath::Min(positionProperties.Num(), 3); axis++)
+		{
+			const TSharedPtr<FJsonValue>* value = subgraph.nodes[i].properties.Find(positionProperties[axis]);
+			double component;
+			if (value && value->IsValid() && (*value)->TryGetNumber(component))
+				positions[i][axis] = component;
+		}
+	}
+
+	return graph.FindPath(startNodeID, endNodeID, outPath, [&positions](int32 fromIndex, int32 toIndex)
+	{
+		return (double)FVector::Dist(positions[fromIndex], positions[toIndex]);
+	});
+}
@@ -0,0 +1,444 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Neo4jResultOperators.h"
+
+#include "Async/ParallelFor.h"
+#include "Neo4jKeyFuncs.h"
+
+//neo4j strings are case-sensitive, so Iron and iron are different values, groups and labels
+typedef TMap<FString, FNeo4jGroup, FDefaultSetAllocator, TNeo4jCaseSensitiveMapKeyFuncs<FNeo4jGroup>> FNeo4jGroupMap;
+
+//below this many nodes the operators run on the calling thread
+static const int32 PARALLEL_OPERATOR_THRESHOLD = 4096;
+
+//nodes handed to each worker in one go
+static const int32 PARALLEL_OPERATOR_CHUNK_SIZE = 1024;
+
+
+//comparable copy of one property of one node, read once so sorting doesn't hit the property maps
+struct FNeo4jSortCell
+{
+	bool bValid = false;
+	bool bNumeric = false;
+	double number = 0.0;
+	FString string;
+};
+
+//predicate with its value parsed up front
+struct FNeo4jParsedPredicate
+{
+	const FNeo4jPropertyPredicate* predicate;
+	bool bNumeric;
+	double number;
+};
+
+
+//runs body(chunk, start, end) over [0, num), in parallel once num is large enough to pay for it
+template<typename ChunkFunc>
+static void _ForEachChunk(int32 num, int32 chunkSize, ChunkFunc body)
+{
+	const int32 numChunks = FMath::DivideAndRoundUp(num, chunkSize);
+
+	ParallelFor(numChunks, [&](int32 chunk)
+	{
+		const int32 start = chunk * chunkSize;
+		body(chunk, start, FMath::Min(start + chunkSize, num));
+	}, num < PARALLEL_OPERATOR_THRESHOLD);
+}
+
+static void _ReadCell(const FNeo4jNode& node, const FString& property, FNeo4jSortCell& outCell)
+{
+	const TSharedPtr<FJsonValue>* value = node.properties.Find(property);
+	if (!value || !value->IsValid())
+		return;
+
+	switch ((*value)->Type)
+	{
+	case EJson::Number:
+		outCell.bNumeric = true;
+		outCell.number = (*value)->AsNumber();
+		break;
+	case EJson::Boolean:
+		outCell.bNumeric = true;
+		outCell.number = (*value)->AsBool() ? 1.0 : 0.0;
+		break;
+	case EJson::String:
+		outCell.string = (*value)->AsString();
+		break;
+	default:
+		//nulls, lists and maps have no order
+		return;
+	}
+
+	outCell.bValid = true;
+}
+
+//negative if a sorts before b. Numbers sort before strings
+static int32 _CompareCells(const FNeo4jSortCell& a, const FNeo4jSortCell& b)
+{
+	if (a.bNumeric != b.bNumeric)
+		return a.bNumeric ? -1 : 1;
+
+	if (a.bNumeric)
+		return a.number < b.number ? -1 : (a.number > b.number ? 1 : 0);
+
+	return a.string.Compare(b.string, ESearchCase::CaseSensitive);
+}
+
+//cells are key major: cells[key * numNodes + node]
+static void _BuildSortCells(const TArray<FNeo4jNode>& inNodes, const TArray<FNeo4jSortKey>& sortKeys, TArray<FNeo4jSortCell>& outCells)
+{
+	const int32 numNodes = inNodes.Num();
+	outCells.SetNum(numNodes * sortKeys.Num());
+
+	_ForEachChunk(numNodes, PARALLEL_OPERATOR_CHUNK_SIZE, [&](int32 chunk, int32 start, int32 end)
+	{
+		for (int32 key = 0; key < sortKeys.Num(); key++)
+		{
+			for (int32 i = start; i < end; i++)
+				_ReadCell(inNodes[i], sortKeys[key].property, outCells[key * numNodes + i]);
+		}
+	});
+}
+
+//strict weak order over node indices. Ties fall back to input order so sorting is stable
+static bool _SortsBefore(int32 a, int32 b, const TArray<FNeo4jSortCell>& cells, const TArray<FNeo4jSortKey>& sortKeys, int32 numNodes)
+{
+	for (int32 key = 0; key < sortKeys.Num(); key++)
+	{
+		const FNeo4jSortCell& cellA = cells[key * numNodes + a];
+		const FNeo4jSortCell& cellB = cells[key * numNodes + b];
+
+		//missing values go last regardless of direction
+		if (cellA.bValid != cellB.bValid)
+			return cellA.bValid;
+
+		if (!cellA.bValid)
+			continue;
+
+		int32 order = _CompareCells(cellA, cellB);
+		if (order != 0)
+			return sortKeys[key].bDescending ? order > 0 : order < 0;
+	}
+
+	return a < b;
+}
+
+static bool _MatchesPredicate(const FNeo4jNode& node, const FNeo4jParsedPredicate& parsed)
+{
+	const FNeo4jPropertyPredicate& predicate = *parsed.predicate;
+
+	const TSharedPtr<FJsonValue>* value = node.properties.Find(predicate.property);
+	const bool bExists = value && value->IsValid() && !(*value)->IsNull();
+
+	if (predicate.comparison == ENeo4jComparison::Exists)
+		return bExists;
+	if (predicate.comparison == ENeo4jComparison::NotExists)
+		return !bExists;
+	if (!bExists)
+		return false;
+
+	int32 order;
+	if (parsed.bNumeric && (*value)->Type == EJson::Number)
+	{
+		double number = (*value)->AsNumber();
+		order = number < parsed.number ? -1 : (number > parsed.number ? 1 : 0);
+	}
+	else
+	{
+		FString string;
+		if (!(*value)->TryGetString(string))
+			return false;
+
+		order = string.Compare(predicate.value, ESearchCase::CaseSensitive);
+	}
+
+	switch (predicate.comparison)
+	{
+	case ENeo4jComparison::Equal:			return order == 0;
+	case ENeo4jComparison::NotEqual:		return order != 0;
+	case ENeo4jComparison::Less:			return order < 0;
+	case ENeo4jComparison::LessOrEqual:		return order <= 0;
+	case ENeo4jComparison::Greater:			return order > 0;
+	case ENeo4jComparison::GreaterOrEqual:	return order >= 0;
+	default:								return false;
+	}
+}
+
+static void _Accumulate(FNeo4jGroup& group, const FNeo4jNode& node, const FString& aggregateProperty)
+{
+	group.count++;
+
+	if (aggregateProperty.IsEmpty())
+		return;
+
+	const TSharedPtr<FJsonValue>* value = node.properties.Find(aggregateProperty);
+	double number;
+	if (!value || !value->IsValid() || !(*value)->TryGetNumber(number))
+		return;
+
+	group.min = group.numericCount == 0 ? number : FMath::Min(group.min, number);
+	group.max = group.numericCount == 0 ? number : FMath::Max(group.max, number);
+	group.sum += number;
+	group.numericCount++;
+}
+
+static void _MergeGroup(FNeo4jGroup& into, const FNeo4jGroup& from)
+{
+	if (from.numericCount > 0)
+	{
+		into.min = into.numericCount == 0 ? from.min : FMath::Min(into.min, from.min);
+		into.max = into.numericCount == 0 ? from.max : FMath::Max(into.max, from.max);
+	}
+
+	into.count += from.count;
+	into.numericCount += from.numericCount;
+	into.sum += from.sum;
+}
+
+//groups every node under the keys produced by getKeys, each chunk builds its own map and the maps are merged after
+template<typename KeyFunc>
+static TArray<FNeo4jGroup> _GroupNodes(const TArray<FNeo4jNode>& inNodes, const FString& aggregateProperty, KeyFunc getKeys)
+{
+	const int32 numChunks = FMath::DivideAndRoundUp(inNodes.Num(), PARALLEL_OPERATOR_CHUNK_SIZE);
+	TArray<FNeo4jGroupMap> chunkGroups;
+	chunkGroups.SetNum(numChunks);
+
+	_ForEachChunk(inNodes.Num(), PARALLEL_OPERATOR_CHUNK_SIZE, [&](int32 chunk, int32 start, int32 end)
+	{
+		TArray<FString> keys;
+		for (int32 i = start; i < end; i++)
+		{
+			keys.Reset();
+			getKeys(inNodes[i], keys);
+
+			for (auto& key : keys)
+			{
+				FNeo4jGroup& group = chunkGroups[chunk].FindOrAdd(key);
+				group.key = key;
+				_Accumulate(group, inNodes[i], aggregateProperty);
+			}
+		}
+	});
+
+	FNeo4jGroupMap groups;
+	for (auto& chunkGroup : chunkGroups)
+	{
+		for (auto& pair : chunkGroup)
+		{
+			FNeo4jGroup* existing = groups.Find(pair.Key);
+			if (existing)
+				_MergeGroup(*existing, pair.Value);
+			else
+				groups.Add(pair.Key, pair.Value);
+		}
+	}
+
+	TArray<FNeo4jGroup> outGroups;
+	groups.GenerateValueArray(outGroups);
+	for (auto& group : outGroups)
+	{
+		group.blueprintSum = (float)group.sum;
+		group.blueprintMin = (float)group.min;
+		group.blueprintMax = (float)group.max;
+	}
+	outGroups.Sort([](const FNeo4jGroup& a, const FNeo4jGroup& b) { return a.key.Compare(b.key, ESearchCase::CaseSensitive) < 0; });
+
+	return outGroups;
+}
+
+
+
+TArray<FNeo4jNode> UNeo4jResultOperators::FilterNodes(const TArray<FNeo4jNode>& inNodes, const TArray<FNeo4jPropertyPredicate>& predicates,
+	const TArray<FString>& requiredLabels)
+{
+	TArray<FNeo4jParsedPredicate> parsedPredicates;
+	for (auto& predicate : predicates)
+	{
+		if (predicate.property.IsEmpty())
+			continue;
+
+		parsedPredicates.Add({ &predicate, predicate.value.IsNumeric(), FCString::Atod(*predicate.value) });
+	}
+
+	TArray<bool> keep;
+	keep.SetNumZeroed(inNodes.Num());
+
+	_ForEachChunk(inNodes.Num(), PARALLEL_OPERATOR_CHUNK_SIZE, [&](int32 chunk, int32 start, int32 end)
+	{
+		for (int32 i = start; i < end; i++)
+		{
+			bool bMatches = true;
+
+			for (auto& label : requiredLabels)
+			{
+				if (!label.IsEmpty() && !inNodes[i].labels.ContainsByPredicate([&label](const FString& nodeLabel)
+					{ return nodeLabel.Equals(label, ESearchCase::CaseSensitive); }))
+				{
+					bMatches = false;
+					break;
+				}
+			}
+
+			for (int32 p = 0; bMatches && p < parsedPredicates.Num(); p++)
+				bMatches = _MatchesPredicate(inNodes[i], parsedPredicates[p]);
+
+			keep[i] = bMatches;
+		}
+	});
+
+	TArray<FNeo4jNode> outNodes;
+	for (int32 i = 0; i < inNodes.Num(); i++)
+	{
+		if (keep[i])
+			outNodes.Add(inNodes[i]);
+	}
+
+	return outNodes;
+}
+
+TArray<FNeo4jNode> UNeo4jResultOperators::SortNodes(const TArray<FNeo4jNode>& inNodes, const TArray<FNeo4jSortKey>& sortKeys)
+{
+	const int32 numNodes = inNodes.Num();
+
+	TArray<FNeo4jSortCell> cells;
+	_BuildSortCells(inNodes, sortKeys, cells);
+
+	TArray<int32> order;
+	order.SetNumUninitialized(numNodes);
+	for (int32 i = 0; i < numNodes; i++)
+		order[i] = i;
+
+	order.Sort([&](int32 a, int32 b) { return _SortsBefore(a, b, cells, sortKeys, numNodes); });
+
+	TArray<FNeo4jNode> outNodes;
+	outNodes.Reserve(numNodes);
+	for (int32 index : order)
+		outNodes.Add(inNodes[index]);
+
+	return outNodes;
+}
+
+TArray<FNeo4jNode> UNeo4jResultOperators::TopKNodes(const TArray<FNeo4jNode>& inNodes, const TArray<FNeo4jSortKey>& sortKeys, int k)
+{
+	const int32 numNodes = inNodes.Num();
+
+	if (k <= 0)
+		return TArray<FNeo4jNode>();
+
+	if (k >= numNodes)
+		return SortNodes(inNodes, sortKeys);
+
+	TArray<FNeo4jSortCell> cells;
+	_BuildSortCells(inNodes, sortKeys, cells);
+
+	auto sortsBefore = [&](int32 a, int32 b) { return _SortsBefore(a, b, cells, sortKeys, numNodes); };
+
+	//heap top is the worst node kept so far, so each candidate only has to beat it
+	auto worstFirst = [&](int32 a, int32 b) { return sortsBefore(b, a); };
+
+	const int32 chunkSize = FMath::Max(PARALLEL_OPERATOR_CHUNK_SIZE, k);
+	TArray<TArray<int32>> chunkHeaps;
+	chunkHeaps.SetNum(FMath::DivideAndRoundUp(numNodes, chunkSize));
+
+	_ForEachChunk(numNodes, chunkSize, [&](int32 chunk, int32 start, int32 end)
+	{
+		TArray<int32>& heap = chunkHeaps[chunk];
+		heap.Reserve(k + 1);
+
+		for (int32 i = start; i < end; i++)
+		{
+			if (heap.Num() < k)
+			{
+				heap.HeapPush(i, worstFirst);
+			}
+			else if (sortsBefore(i, heap.HeapTop()))
+			{
+				heap.HeapPopDiscard(worstFirst, false);
+				heap.HeapPush(i, worstFirst);
+			}
+		}
+	});
+
+	TArray<int32> candidates;
+	for (auto& heap : chunkHeaps)
+		candidates.Append(heap);
+
+	candidates.Sort(sortsBefore);
+
+	TArray<FNeo4jNode> outNodes;
+	outNodes.Reserve(k);
+	for (int32 i = 0; i < k; i++)
+		outNodes.Add(inNodes[candidates[i]]);
+
+	return outNodes;
+}
+
+//nodes without the group property are left out
+TArray<FNeo4jGroup> UNeo4jResultOperators::GroupByProperty(const TArray<FNeo4jNode>& inNodes, const FString& groupProperty, const FString& aggregateProperty)
+{
+	return _GroupNodes(inNodes, aggregateProperty, [&](const FNeo4jNode& node, TArray<FString>& outKeys)
+	{
+		const TSharedPtr<FJsonValue>* value = node.properties.Find(groupProperty);
+		FString key;
+		if (value && value->IsValid() && (*value)->TryGetString(key))
+			outKeys.Add(key);
+	});
+}
+
+TArray<FNeo4jGroup> UNeo4jResultOperators::GroupByLabel(const TArray<FNeo4jNode>& inNodes, const FString& aggregateProperty)
+{
+	return _GroupNodes(inNodes, aggregateProperty, [](const FNeo4jNode& node, TArray<FString>& outKeys)
+	{
+		outKeys.Append(node.labels);
+	});
+}
+
+TArray<FNeo4jNode> UNeo4jResultOperators::DistinctNodes(const TArray<FNeo4jNode>& inNodes, const TArray<FString>& properties)
+{
+	//build keys in parallel, the dedupe itself has to keep input order so it runs serially
+	TArray<FString> keys;
+	keys.SetNum(inNodes.Num());
+
+	_ForEachChunk(inNodes.Num(), PARALLEL_OPERATOR_CHUNK_SIZE, [&](int32 chunk, int32 start, int32 end)
+	{
+		for (int32 i = start; i < end; i++)
+		{
+			if (properties.Num() == 0)
+			{
+				keys[i].AppendInt(inNodes[i].id);
+				continue;
+			}
+
+			for (auto& property : properties)
+			{
+				const TSharedPtr<FJsonValue>* value = inNodes[i].properties.Find(property);
+				FString string;
+
+				//tag missing values so they can't collide with a real empty string
+				if (value && value->IsValid() && (*value)->TryGetString(string))
+					keys[i] += TEXT("=") + string;
+				else
+					keys[i] += TEXT("!");
+
+				keys[i].AppendChar(TCHAR(0x1F));
+			}
+		}
+	});
+
+	TSet<FString, FNeo4jCaseSensitiveKeyFuncs> seen;
+	seen.Reserve(inNodes.Num());
+
+	TArray<FNeo4jNode> outNodes;
+	for (int32 i = 0; i < inNodes.Num(); i++)
+	{
+		bool bAlreadySeen;
+		seen.Add(keys[i], &bAlreadySeen);
+
+		if (!bAlreadySeen)
+			outNodes.Add(inNodes[i]);
+	}
+
+	return outNodes;
+}
@@ -0,0 +1,617 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Neo4jResultSet.h"
+
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+
+
+/**
+* Walks a node query response token by token and writes rows straight into a result set,
+* so no FJsonObject/FJsonValue tree is built for the response.
+*/
+class FNeo4jResultSetParser
+{
+public:
+
+	FNeo4jResultSetParser(FNeo4jResultSet& inResultSet, const FString& resultString)
+		: resultSet(inResultSet)
+		, reader(TJsonReaderFactory<TCHAR>::Create(resultString))
+	{
+	}
+
+	//{"results":[{"columns":[...],"data":[{"row":[{...}],"meta":[{"id":..}]}]}],"errors":[]}
+	bool Parse()
+	{
+		EJsonNotation notation;
+		if (!reader->ReadNext(notation) || notation != EJsonNotation::ObjectStart)
+			return false;
+
+		while (reader->ReadNext(notation))
+		{
+			if (notation == EJsonNotation::ObjectEnd)
+				return true;
+
+			if (notation == EJsonNotation::ArrayStart && reader->GetIdentifier() == TEXT("results"))
+			{
+				if (!_ParseArrayOfObjects(&FNeo4jResultSetParser::_ParseResult))
+					return false;
+			}
+			else if (!_Skip(notation))
+				return false;
+		}
+
+		return false;
+	}
+
+private:
+
+	//calls parseObject for every object in the array that was just opened
+	bool _ParseArrayOfObjects(bool (FNeo4jResultSetParser::*parseObject)())
+	{
+		EJsonNotation notation;
+		while (reader->ReadNext(notation))
+		{
+			if (notation == EJsonNotation::ArrayEnd)
+				return true;
+
+			if (notation == EJsonNotation::ObjectStart)
+			{
+				if (!(this->*parseObject)())
+					return false;
+			}
+			else if (!_Skip(notation))
+				return false;
+		}
+
+		return false;
+	}
+
+	bool _ParseResult()
+	{
+		EJsonNotation notation;
+		while (reader->ReadNext(notation))
+		{
+			if (notation == EJsonNotation::ObjectEnd)
+				return true;
+
+			if (notation == EJsonNotation::ArrayStart && reader->GetIdentifier() == TEXT("data"))
+			{
+				if (!_ParseArrayOfObjects(&FNeo4jResultSetParser::_ParseDataRow))
+					return false;
+			}
+			else if (!_Skip(notation))
+				return false;
+		}
+
+		return false;
+	}
+
+	bool _ParseDataRow()
+	{
+		rowIndex = resultSet.rows.Add({ INDEX_NONE, resultSet.properties.Num(), 0, resultSet.labels.Num(), 0 });
+
+		EJsonNotation notation;
+		while (reader->ReadNext(notation))
+		{
+			if (notation == EJsonNotation::ObjectEnd)
+				return true;
+
+			bool bParsed;
+			if (notation == EJsonNotation::ArrayStart && reader->GetIdentifier() == TEXT("row"))
+				bParsed = _ParseRow();
+			else if (notation == EJsonNotation::ArrayStart && reader->GetIdentifier() == TEXT("meta"))
+				bParsed = _ParseFirstObject(&FNeo4jResultSetParser::_ParseMeta);
+			else
+				bParsed = _Skip(notation);
+
+			if (!bParsed)
+				return false;
+		}
+
+		return false;
+	}
+
+	//node queries return the node as the first column and may return its labels right after it, anything else is skipped
+	bool _ParseRow()
+	{
+		bool bParsedNode = false;
+		bool bParsedLabels = false;
+
+		EJsonNotation notation;
+		while (reader->ReadNext(notation))
+		{
+			if (notation == EJsonNotation::ArrayEnd)
+				return true;
+
+			bool bParsed;
+			if (notation == EJsonNotation::ObjectStart && !bParsedNode)
+			{
+				bParsed = _ParseProperties();
+				bParsedNode = true;
+			}
+			else if (notation == EJsonNotation::ArrayStart && bParsedNode && !bParsedLabels)
+			{
+				bParsed = _ParseLabels();
+				bParsedLabels = true;
+			}
+			else
+				bParsed = _Skip(notation);
+
+			if (!bParsed)
+				return false;
+		}
+
+		return false;
+	}
+
+	bool _ParseLabels()
+	{
+		EJsonNotation notation;
+		while (reader->ReadNext(notation))
+		{
+			if (notation == EJsonNotation::ArrayEnd)
+				return true;
+
+			if (notation == EJsonNotation::String)
+			{
+				const FString& label = reader->GetValueAsString();
+				resultSet.labels.Add({ resultSet._AppendString(label), label.Len() });
+				resultSet.rows[rowIndex].numLabels++;
+			}
+			else if (!_Skip(notation))
+				return false;
+		}
+
+		return false;
+	}
+
+	//meta has one entry per column, the node's is first
+	bool _ParseFirstObject(bool (FNeo4jResultSetParser::*parseObject)())
+	{
+		bool bParsedFirst = false;
+
+		EJsonNotation notation;
+		while (reader->ReadNext(notation))
+		{
+			if (notation == EJsonNotation::ArrayEnd)
+				return true;
+
+			if (notation == EJsonNotation::ObjectStart && !bParsedFirst)
+			{
+				if (!(this->*parseObject)())
+					return false;
+
+				bParsedFirst = true;
+			}
+			else if (!_Skip(notation))
+				return false;
+		}
+
+		return false;
+	}
+
+	bool _ParseProperties()
+	{
+		EJsonNotation notation;
+		while (reader->ReadNext(notation))
+		{
+			if (notation == EJsonNotation::ObjectEnd)
+				return true;
+
+			FNeo4jResultSet::FResultProperty property;
+			property.keyIndex = resultSet._InternKey(reader->GetIdentifier());
+			property.type = ENeo4jResultValueType::Null;
+			property.boolean = false;
+			property.number = 0.0;
+			property.stringOffset = 0;
+			property.stringLength = 0;
+
+			switch (notation)
+			{
+			case EJsonNotation::String:
+				property.type = ENeo4jResultValueType::String;
+				property.stringLength = reader->GetValueAsString().Len();
+				property.stringOffset = resultSet._AppendString(reader->GetValueAsString());
+				break;
+			case EJsonNotation::Number:
+				property.type = ENeo4jResultValueType::Number;
+				property.number = reader->GetValueAsNumber();
+				break;
+			case EJsonNotation::Boolean:
+				property.type = ENeo4jResultValueType::Bool;
+				property.boolean = reader->GetValueAsBoolean();
+				break;
+			case EJsonNotation::Null:
+				break;
+			case EJsonNotation::ObjectStart:
+			case EJsonNotation::ArrayStart:
+			{
+				FString json;
+				if (!_CaptureJson(notation, json))
+					return false;
+
+				property.type = ENeo4jResultValueType::Json;
+				property.stringLength = json.Len();
+				property.stringOffset = resultSet._AppendString(json);
+				break;
+			}
+			default:
+				return false;
+			}
+
+			resultSet.properties.Add(property);
+			resultSet.rows[rowIndex].numProperties++;
+		}
+
+		return false;
+	}
+
+	bool _ParseMeta()
+	{
+		EJsonNotation notation;
+		while (reader->ReadNext(notation))
+		{
+			if (notation == EJsonNotation::ObjectEnd)
+				return true;
+
+			if (notation == EJsonNotation::Number && reader->GetIdentifier() == TEXT("id"))
+				resultSet.rows[rowIndex].id = (int32)reader->GetValueAsNumber();
+			else if (!_Skip(notation))
+				return false;
+		}
+
+		return false;
+	}
+
+	//consumes the rest of a value whose first token was just read
+	bool _Skip(EJsonNotation notation)
+	{
+		if (notation == EJsonNotation::Error)
+			return false;
+
+		if (notation != EJsonNotation::ObjectStart && notation != EJsonNotation::ArrayStart)
+			return true;
+
+		int32 depth = 1;
+		while (depth > 0 && reader->ReadNext(notation))
+		{
+			if (notation == EJsonNotation::ObjectStart || notation == EJsonNotation::ArrayStart)
+				depth++;
+			else if (notation == EJsonNotation::ObjectEnd || notation == EJsonNotation::ArrayEnd)
+				depth--;
+			else if (notation == EJsonNotation::Error)
+				return false;
+		}
+
+		return depth == 0;
+	}
+
+	//re-serializes a nested list/map property as condensed json text
+	bool _CaptureJson(EJsonNotation notation, FString& outJson)
+	{
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> writer =
+			TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&outJson);
+
+		int32 depth = 0;
+		do
+		{
+			//the outermost value is written without the property name it had
+			const FString& identifier = reader->GetIdentifier();
+			const bool bNamed = depth > 0 && !identifier.IsEmpty();
+
+			switch (notation)
+			{
+			case EJsonNotation::ObjectStart:
+				bNamed ? writer->WriteObjectStart(identifier) : writer->WriteObjectStart();
+				depth++;
+				break;
+			case EJsonNotation::ArrayStart:
+				bNamed ? writer->WriteArrayStart(identifier) : writer->WriteArrayStart();
+				depth++;
+				break;
+			case EJsonNotation::ObjectEnd:
+				writer->WriteObjectEnd();
+				depth--;
+				break;
+			case EJsonNotation::ArrayEnd:
+				writer->WriteArrayEnd();
+				depth--;
+				break;
+			case EJsonNotation::String:
+				bNamed ? writer->WriteValue(identifier, reader->GetValueAsString()) : writer->WriteValue(reader->GetValueAsString());
+				break;
+			case EJsonNotation::Number:
+				bNamed ? writer->WriteValue(identifier, reader->GetValueAsNumber()) : writer->WriteValue(reader->GetValueAsNumber());
+				break;
+			case EJsonNotation::Boolean:
+				bNamed ? writer->WriteValue(identifier, reader->GetValueAsBoolean()) : writer->WriteValue(reader->GetValueAsBoolean());
+				break;
+			case EJsonNotation::Null:
+				bNamed ? writer->WriteNull(identifier) : writer->WriteNull();
+				break;
+			default:
+				return false;
+			}
+		} while (depth > 0 && reader->ReadNext(notation));
+
+		writer->Close();
+		return depth == 0;
+	}
+
+	FNeo4jResultSet& resultSet;
+	TSharedRef<TJsonReader<TCHAR>> reader;
+	int32 rowIndex = INDEX_NONE;
+};
+
+
+
+#pragma region RESULT_SET
+
+bool FNeo4jResultSet::ParseQueryResult(const FString& resultString)
+{
+	const int32 firstNewRow = rows.Num();
+	const int32 firstNewProperty = properties.Num();
+	const int32 firstNewLabel = labels.Num();
+	const int32 arenaSize = stringArena.Num();
+
+	FNeo4jResultSetParser parser(*this, resultString);
+	if (parser.Parse())
+		return true;
+
+	//roll back whatever the broken response managed to add
+	rows.SetNum(firstNewRow, false);
+	properties.SetNum(firstNewProperty, false);
+	labels.SetNum(firstNewLabel, false);
+	stringArena.SetNum(arenaSize, false);
+
+	UE_LOG(LogTemp, Error, TEXT("Could not parse node query result into result set"));
+	return false;
+}
+
+void FNeo4jResultSet::Reset(bool bReleaseMemory)
+{
+	if (bReleaseMemory)
+	{
+		rows.Empty();
+		properties.Empty();
+		labels.Empty();
+		stringArena.Empty();
+		keys.Empty();
+		keyIndices.Empty();
+	}
+	else
+	{
+		rows.Reset();
+		properties.Reset();
+		labels.Reset();
+		stringArena.Reset();
+	}
+}
+
+bool FNeo4jResultSet::HasProperty(int32 row, const FString& key) const
+{
+	return _FindProperty(row, key) != nullptr;
+}
+
+bool FNeo4jResultSet::GetNumber(int32 row, const FString& key, double& outValue) const
+{
+	const FResultProperty* property = _FindProperty(row, key);
+	if (!property || property->type != ENeo4jResultValueType::Number)
+		return false;
+
+	outValue = property->number;
+	return true;
+}
+
+bool FNeo4jResultSet::GetBool(int32 row, const FString& key, bool& outValue) const
+{
+	const FResultProperty* property = _FindProperty(row, key);
+	if (!property || property->type != ENeo4jResultValueType::Bool)
+		return false;
+
+	outValue = property->boolean;
+	return true;
+}
+
+bool FNeo4jResultSet::GetString(int32 row, const FString& key, FString& outValue) const
+{
+	const FResultProperty* property = _FindProperty(row, key);
+	if (!property)
+		return false;
+
+	switch (property->type)
+	{
+	case ENeo4jResultValueType::String:
+	case ENeo4jResultValueType::Json:
+		outValue = FString(property->stringLength, stringArena.GetData() + property->stringOffset);
+		return true;
+	case ENeo4jResultValueType::Number:
+		outValue = FString::SanitizeFloat(property->number, 0);
+		return true;
+	case ENeo4jResultValueType::Bool:
+		outValue = property->boolean ? TEXT("true") : TEXT("false");
+		return true;
+	default:
+		return false;
+	}
+}
+
+FNeo4jNode FNeo4jResultSet::ToNode(int32 row) const
+{
+	FNeo4jNode node;
+	node.id = rows[row].id;
+	node.properties.Reserve(rows[row].numProperties);
+
+	for (int32 i = 0; i < rows[row].numProperties; i++)
+	{
+		const FResultProperty& property = properties[rows[row].firstProperty + i];
+		node.properties.Add(keys[property.keyIndex], _MakeJsonValue(property));
+	}
+
+	node.labels.Reserve(rows[row].numLabels);
+	for (int32 i = 0; i < rows[row].numLabels; i++)
+	{
+		const FLabel& label = labels[rows[row].firstLabel + i];
+		node.labels.Emplace(label.stringLength, stringArena.GetData() + label.stringOffset);
+	}
+
+	return node;
+}
+
+TArray<FNeo4jNode> FNeo4jResultSet::ToNodes() const
+{
+	TArray<FNeo4jNode> outNodes;
+	outNodes.Reserve(rows.Num());
+
+	for (int32 row = 0; row < rows.Num(); row++)
+		outNodes.Add(ToNode(row));
+
+	return outNodes;
+}
+
+SIZE_T FNeo4jResultSet::GetAllocatedSize() const
+{
+	SIZE_T size = rows.GetAllocatedSize() + properties.GetAllocatedSize() + labels.GetAllocatedSize() + stringArena.GetAllocatedSize()
+		+ keys.GetAllocatedSize() + keyIndices.GetAllocatedSize();
+
+	for (auto& key : keys)
+		size += key.GetAllocatedSize();
+
+	return size;
+}
+
+const FNeo4jResultSet::FResultProperty* FNeo4jResultSet::_FindProperty(int32 row, const FString& key) const
+{
+	const int32* keyIndex = keyIndices.Find(key);
+	if (!keyIndex || !rows.IsValidIndex(row))
+		return nullptr;
+
+	//nodes carry a handful of properties, a linear scan beats any per row index
+	for (int32 i = 0; i < rows[row].numProperties; i++)
+	{
+		const FResultProperty& property = properties[rows[row].firstProperty + i];
+		if (property.keyIndex == *keyIndex)
+			return &property;
+	}
+
+	return nullptr;
+}
+
+void FNeo4jResultSet::InternKeys(const TArray<FString>& inKeys)
+{
+	keys.Reserve(keys.Num() + inKeys.Num());
+	keyIndices.Reserve(keyIndices.Num() + inKeys.Num());
+
+	for (auto& key : inKeys)
+		_InternKey(key);
+}
+
+int32 FNeo4jResultSet::_InternKey(const FString& key)
+{
+	const int32* existing = keyIndices.Find(key);
+	if (existing)
+		return *existing;
+
+	int32 index = keys.Add(key);
+	keyIndices.Add(key, index);
+	return index;
+}
+
+int32 FNeo4jResultSet::_AppendString(const FString& string)
+{
+	int32 offset = stringArena.Num();
+	stringArena.Append(*string, string.Len());
+	return offset;
+}
+
+TSharedPtr<FJsonValue> FNeo4jResultSet::_MakeJsonValue(const FResultProperty& property) const
+{
+	switch (property.type)
+	{
+	case ENeo4jResultValueType::Number:
+		return MakeShareable(new FJsonValueNumber(property.number));
+	case ENeo4jResultValueType::Bool:
+		return MakeShareable(new FJsonValueBoolean(property.boolean));
+	case ENeo4jResultValueType::String:
+		return MakeShareable(new FJsonValueString(FString(property.stringLength, stringArena.GetData() + property.stringOffset)));
+	case ENeo4jResultValueType::Json:
+	{
+		FString json(property.stringLength, stringArena.GetData() + property.stringOffset);
+		TSharedRef<TJsonReader<TCHAR>> jsonReader = TJsonReaderFactory<TCHAR>::Create(json);
+
+		if (json.StartsWith(TEXT("[")))
+		{
+			TArray<TSharedPtr<FJsonValue>> jsonArray;
+			if (FJsonSerializer::Deserialize(jsonReader, jsonArray))
+				return MakeShareable(new FJsonValueArray(jsonArray));
+		}
+		else
+		{
+			TSharedPtr<FJsonObject> jsonObject;
+			if (FJsonSerializer::Deserialize(jsonReader, jsonObject))
+				return MakeShareable(new FJsonValueObject(jsonObject));
+		}
+
+		return MakeShareable(new FJsonValueNull());
+	}
+	default:
+		return MakeShareable(new FJsonValueNull());
+	}
+}
+
+#pragma endregion RESULT_SET
+
+
+
+#pragma region RESULT_SET_POOL
+
+TSharedRef<FNeo4jResultSet> FNeo4jResultSetPool::Acquire()
+{
+	if (freeSets.Num() > 0)
+		return freeSets.Pop(false);
+
+	TSharedRef<FNeo4jResultSet> resultSet = MakeShareable(new FNeo4jResultSet());
+	resultSet->InternKeys(knownKeys);
+	return resultSet;
+}
+
+void FNeo4jResultSetPool::Release(TSharedPtr<FNeo4jResultSet>& resultSet)
+{
+	if (!resultSet.IsValid())
+		return;
+
+	//someone still reads from it, let the last reference free it
+	if (!resultSet.IsUnique())
+	{
+		resultSet.Reset();
+		return;
+	}
+
+	if (freeSets.Num() < maxPooledSets && resultSet->GetAllocatedSize() <= maxRetainedBytes)
+	{
+		resultSet->Reset();
+		freeSets.Add(resultSet.ToSharedRef());
+	}
+
+	resultSet.Reset();
+}
+
+void FNeo4jResultSetPool::Trim()
+{
+	freeSets.Empty();
+}
+
+void FNeo4jResultSetPool::SetKnownKeys(const TArray<FString>& inKeys)
+{
+	knownKeys = inKeys;
+
+	for (auto& resultSet : freeSets)
+		resultSet->InternKeys(knownKeys);
+}
+
+#pragma endregion RESULT_SET_POOL
@@ -0,0 +1,384 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Neo4jSnapshot.h"
+
+#include "Async/Async.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+//"N4JS"
+static const uint32 SNAPSHOT_MAGIC = 0x534A344E;
+
+//bump whenever the body layout changes, older files are then rejected instead of misread
+static const uint32 SNAPSHOT_FORMAT_VERSION = 1;
+
+//nested lists/maps deeper than this are treated as corrupt data
+static const int32 SNAPSHOT_MAX_VALUE_DEPTH = 64;
+
+//deflate never expands data more than about 1032 to 1, so a header claiming more is corrupt
+static const int64 SNAPSHOT_MAX_COMPRESSION_RATIO = 1032;
+
+enum class ENeo4jSnapshotValueType : uint8
+{
+	Null,
+	Number,
+	Bool,
+	String,
+	Array,
+	Object
+};
+
+
+static void _WriteValue(FArchive& archive, const TSharedPtr<FJsonValue>& value);
+
+static void _WriteProperties(FArchive& archive, const TMap<FString, TSharedPtr<FJsonValue>>& properties)
+{
+	int32 numProperties = properties.Num();
+	archive << numProperties;
+
+	for (auto& property : properties)
+	{
+		FString key = property.Key;
+		archive << key;
+		_WriteValue(archive, property.Value);
+	}
+}
+
+static void _WriteValue(FArchive& archive, const TSharedPtr<FJsonValue>& value)
+{
+	ENeo4jSnapshotValueType type = ENeo4jSnapshotValueType::Null;
+	if (value.IsValid())
+	{
+		switch (value->Type)
+		{
+		case EJson::Number:		type = ENeo4jSnapshotValueType::Number; break;
+		case EJson::Boolean:	type = ENeo4jSnapshotValueType::Bool; break;
+		case EJson::String:		type = ENeo4jSnapshotValueType::String; break;
+		case EJson::Array:		type = ENeo4jSnapshotValueType::Array; break;
+		case EJson::Object:		type = ENeo4jSnapshotValueType::Object; break;
+		default:				break;
+		}
+	}
+
+	archive << type;
+
+	switch (type)
+	{
+	case ENeo4jSnapshotValueType::Number:
+	{
+		double number = value->AsNumber();
+		archive << number;
+		break;
+	}
+	case ENeo4jSnapshotValueType::Bool:
+	{
+		bool boolean = value->AsBool();
+		archive << boolean;
+		break;
+	}
+	case ENeo4jSnapshotValueType::String:
+	{
+		FString string = value->AsString();
+		archive << string;
+		break;
+	}
+	case ENeo4jSnapshotValueType::Array:
+	{
+		const TArray<TSharedPtr<FJsonValue>>& elements = value->AsArray();
+		int32 numElements = elements.Num();
+		archive << numElements;
+
+		for (auto& element : elements)
+			_WriteValue(archive, element);
+		break;
+	}
+	case ENeo4jSnapshotValueType::Object:
+		_WriteProperties(archive, value->AsObject()->Values);
+		break;
+	default:
+		break;
+	}
+}
+
+static TSharedPtr<FJsonValue> _ReadValue(FArchive& archive, int32 depth);
+
+//counts come from the file, never trust them further than the bytes that are left
+static bool _IsPlausibleCount(FArchive& archive, int32 count)
+{
+	return count >= 0 && count <= archive.TotalSize() - archive.Tell() && !archive.IsError();
+}
+
+static bool _ReadProperties(FArchive& archive, TMap<FString, TSharedPtr<FJsonValue>>& outProperties, int32 depth)
+{
+	int32 numProperties = 0;
+	archive << numProperties;
+
+	if (!_IsPlausibleCount(archive, numProperties) || depth > SNAPSHOT_MAX_VALUE_DEPTH)
+		return false;
+
+	outProperties.Reserve(numProperties);
+	for (int32 i = 0; i < numProperties; i++)
+	{
+		FString key;
+		archive << key;
+
+		TSharedPtr<FJsonValue> value = _ReadValue(archive, depth + 1);
+		if (!value.IsValid())
+			return false;
+
+		outProperties.Add(key, value);
+	}
+
+	return !archive.IsError();
+}
+
+//same layout as archive << TArray<FString>, with the count checked before anything is allocated
+static bool _ReadLabels(FArchive& archive, TArray<FString>& outLabels)
+{
+	int32 numLabels = 0;
+	archive << numLabels;
+
+	if (!_IsPlausibleCount(archive, numLabels))
+		return false;
+
+	outLabels.SetNum(numLabels);
+	for (auto& label : outLabels)
+		archive << label;
+
+	return !archive.IsError();
+}
+
+//returns null on corrupt data, json nulls come back as FJsonValueNull
+static TSharedPtr<FJsonValue> _ReadValue(FArchive& archive, int32 depth)
+{
+	ENeo4jSnapshotValueType type;
+	archive << type;
+
+	if (archive.IsError() || depth > SNAPSHOT_MAX_VALUE_DEPTH)
+		return nullptr;
+
+	switch (type)
+	{
+	case ENeo4jSnapshotValueType::Null:
+		return MakeShareable(new FJsonValueNull());
+	case ENeo4jSnapshotValueType::Number:
+	{
+		double number = 0.0;
+		archive << number;
+		return MakeShareable(new FJsonValueNumber(number));
+	}
+	case ENeo4jSnapshotValueType::Bool:
+	{
+		bool boolean = false;
+		archive << boolean;
+		return MakeShareable(new FJsonValueBoolean(boolean));
+	}
+	case ENeo4jSnapshotValueType::String:
+	{
+		FString string;
+		archive << string;
+		return MakeShareable(new FJsonValueString(string));
+	}
+	case ENeo4jSnapshotValueType::Array:
+	{
+		int32 numElements = 0;
+		archive << numElements;
+		if (!_IsPlausibleCount(archive, numElements))
+			return nullptr;
+
+		TArray<TSharedPtr<FJsonValue>> elements;
+		elements.Reserve(numElements);
+		for (int32 i = 0; i < numElements; i++)
+		{
+			TSharedPtr<FJsonValue> element = _ReadValue(archive, depth + 1);
+			if (!element.IsValid())
+				return nullptr;
+
+			elements.Add(element);
+		}
+
+		return MakeShareable(new FJsonValueArray(elements));
+	}
+	case ENeo4jSnapshotValueType::Object:
+	{
+		TSharedPtr<FJsonObject> object = MakeShareable(new FJsonObject());
+		if (!_ReadProperties(archive, object->Values, depth + 1))
+			return nullptr;
+
+		return MakeShareable(new FJsonValueObject(object));
+	}
+	default:
+		return nullptr;
+	}
+}
+
+
+
+bool UNeo4jSnapshot::SerializeSubgraph(const FNeo4jSubgraph& subgraph, TArray<uint8>& outBytes)
+{
+	//body first, then compress it behind a small uncompressed header
+	TArray<uint8> body;
+	FMemoryWriter bodyWriter(body);
+
+	int32 numNodes = subgraph.nodes.Num();
+	bodyWriter << numNodes;
+	for (auto& node : subgraph.nodes)
+	{
+		int32 id = node.id;
+		TArray<FString> labels = node.labels;
+		bodyWriter << id;
+		bodyWriter << labels;
+		_WriteProperties(bodyWriter, node.properties);
+	}
+
+	int32 numRelationships = subgraph.relationships.Num();
+	bodyWriter << numRelationships;
+	for (auto& relationship : subgraph.relationships)
+	{
+		int32 id = relationship.id;
+		FString type = relationship.type;
+		int32 startNode = relationship.startNode;
+		int32 endNode = relationship.endNode;
+		bodyWriter << id;
+		bodyWriter << type;
+		bodyWriter << startNode;
+		bodyWriter << endNode;
+		_WriteProperties(bodyWriter, relationship.properties);
+	}
+
+	int32 compressedSize = FCompression::CompressMemoryBound(NAME_Zlib, body.Num());
+	TArray<uint8> compressed;
+	compressed.SetNumUninitialized(compressedSize);
+	if (!FCompression::CompressMemory(NAME_Zlib, compressed.GetData(), compressedSize, body.GetData(), body.Num()))
+		return false;
+
+	outBytes.Reset();
+	FMemoryWriter writer(outBytes);
+
+	uint32 magic = SNAPSHOT_MAGIC;
+	uint32 formatVersion = SNAPSHOT_FORMAT_VERSION;
+	int64 dataVersion = subgraph.dataVersion;
+	int32 uncompressedSize = body.Num();
+	writer << magic;
+	writer << formatVersion;
+	writer << dataVersion;
+	writer << uncompressedSize;
+	writer << compressedSize;
+	writer.Serialize(compressed.GetData(), compressedSize);
+
+	return true;
+}
+
+bool UNeo4jSnapshot::DeserializeSubgraph(const TArray<uint8>& bytes, FNeo4jSubgraph& outSubgraph)
+{
+	FMemoryReader reader(bytes);
+
+	uint32 magic = 0;
+	uint32 formatVersion = 0;
+	int64 dataVersion = 0;
+	int32 uncompressedSize = 0;
+	int32 compressedSize = 0;
+	reader << magic;
+	reader << formatVersion;
+	reader << dataVersion;
+	reader << uncompressedSize;
+	reader << compressedSize;
+
+	if (reader.IsError() || magic != SNAPSHOT_MAGIC || formatVersion != SNAPSHOT_FORMAT_VERSION
+		|| uncompressedSize < 0 || compressedSize < 0 || compressedSize > reader.TotalSize() - reader.Tell()
+		|| uncompressedSize > compressedSize * SNAPSHOT_MAX_COMPRESSION_RATIO)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Snapshot header is invalid or from another format version"));
+		return false;
+	}
+
+	TArray<uint8> body;
+	body.SetNumUninitialized(uncompressedSize);
+	if (!FCompression::UncompressMemory(NAME_Zlib, body.GetData(), uncompressedSize, bytes.GetData() + reader.Tell(), compressedSize))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Snapshot body could not be decompressed"));
+		return false;
+	}
+
+	FMemoryReader bodyReader(body);
+	FNeo4jSubgraph subgraph;
+	subgraph.dataVersion = dataVersion;
+
+	int32 numNodes = 0;
+	bodyReader << numNodes;
+	if (!_IsPlausibleCount(bodyReader, numNodes))
+		return false;
+
+	subgraph.nodes.SetNum(numNodes);
+	for (auto& node : subgraph.nodes)
+	{
+		bodyReader << node.id;
+		if (!_ReadLabels(bodyReader, node.labels) || !_ReadProperties(bodyReader, node.properties, 0))
+			return false;
+	}
+
+	int32 numRelationships = 0;
+	bodyReader << numRelationships;
+	if (!_IsPlausibleCount(bodyReader, numRelationships))
+		return false;
+
+	subgraph.relationships.SetNum(numRelationships);
+	for (auto& relationship : subgraph.relationships)
+	{
+		bodyReader << relationship.id;
+		bodyReader << relationship.type;
+		bodyReader << relationship.startNode;
+		bodyReader << relationship.endNode;
+		if (!_ReadProperties(bodyReader, relationship.properties, 0))
+			return false;
+	}
+
+	if (bodyReader.IsError())
+		return false;
+
+	outSubgraph = MoveTemp(subgraph);
+	return true;
+}
+
+bool UNeo4jSnapshot::SaveSnapshot(const FNeo4jSubgraph& subgraph, const FString& filePath)
+{
+	TArray<uint8> bytes;
+	if (!SerializeSubgraph(subgraph, bytes) || !FFileHelper::SaveArrayToFile(bytes, *filePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Could not save snapshot to %s"), *filePath);
+		return false;
+	}
+
+	return true;
+}
+
+bool UNeo4jSnapshot::LoadSnapshot(const FString& filePath, FNeo4jSubgraph& outSubgraph)
+{
+	TArray<uint8> bytes;
+	if (!FFileHelper::LoadFileToArray(bytes, *filePath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("No snapshot at %s"), *filePath);
+		return false;
+	}
+
+	return DeserializeSubgraph(bytes, outSubgraph);
+}
+
+void UNeo4jSnapshot::LoadSnapshotAsync(const FString& filePath, TFunction<void(bool bLoaded, FNeo4jSubgraph& subgraph)> onLoaded)
+{
+	Async(EAsyncExecution::ThreadPool, [filePath, onLoaded]()
+	{
+		TSharedPtr<FNeo4jSubgraph, ESPMode::ThreadSafe> subgraph = MakeShareable(new FNeo4jSubgraph());
+		bool bLoaded = LoadSnapshot(filePath, *subgraph);
+
+		AsyncTask(ENamedThreads::GameThread, [bLoaded, subgraph, onLoaded]()
+		{
+			onLoaded(bLoaded, *subgraph);
+		});
+	});
+}
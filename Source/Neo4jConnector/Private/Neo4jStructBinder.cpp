@@ -0,0 +1,433 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Neo4jStructBinder.h"
+
+#include "Misc/ScopeLock.h"
+#include "Neo4jJsonWriter.h"
+#include "Serialization/JsonReader.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/UnrealType.h"
+#include "UObject/WeakObjectPtr.h"
+
+
+/**
+* Walks a node query response token by token and writes each row's properties straight into a struct.
+* Same response walk as the result set parser, the node is the first row column and its id is in meta.
+*/
+class FNeo4jStructParser
+{
+public:
+
+	FNeo4jStructParser(const FNeo4jStructBinder& inBinder, const FString& resultString, TFunctionRef<void*()> inAddStruct)
+		: binder(inBinder)
+		, addStruct(inAddStruct)
+		, reader(TJsonReaderFactory<TCHAR>::Create(resultString))
+	{
+	}
+
+	bool Parse()
+	{
+		EJsonNotation notation;
+		if (!reader->ReadNext(notation) || notation != EJsonNotation::ObjectStart)
+			return false;
+
+		while (reader->ReadNext(notation))
+		{
+			if (notation == EJsonNotation::ObjectEnd)
+				return true;
+
+			if (notation == EJsonNotation::ArrayStart && reader->GetIdentifier() == TEXT("results"))
+			{
+				if (!_ParseArrayOfObjects(&FNeo4jStructParser::_ParseResult))
+					return false;
+			}
+			else if (!_Skip(notation))
+				return false;
+		}
+
+		return false;
+	}
+
+private:
+
+	bool _ParseArrayOfObjects(bool (FNeo4jStructParser::*parseObject)())
+	{
+		EJsonNotation notation;
+		while (reader->ReadNext(notation))
+		{
+			if (notation == EJsonNotation::ArrayEnd)
+				return true;
+
+			if (notation == EJsonNotation::ObjectStart)
+			{
+				if (!(this->*parseObject)())
+					return false;
+			}
+			else if (!_Skip(notation))
+				return false;
+		}
+
+		return false;
+	}
+
+	bool _ParseResult()
+	{
+		EJsonNotation notation;
+		while (reader->ReadNext(notation))
+		{
+			if (notation == EJsonNotation::ObjectEnd)
+				return true;
+
+			if (notation == EJsonNotation::ArrayStart && reader->GetIdentifier() == TEXT("data"))
+			{
+				if (!_ParseArrayOfObjects(&FNeo4jStructParser::_ParseDataRow))
+					return false;
+			}
+			else if (!_Skip(notation))
+				return false;
+		}
+
+		return false;
+	}
+
+	bool _ParseDataRow()
+	{
+		//only valid until the next row is added, the caller's array may move
+		structMemory = (uint8*)addStruct();
+
+		EJsonNotation notation;
+		while (reader->ReadNext(notation))
+		{
+			if (notation == EJsonNotation::ObjectEnd)
+				return true;
+
+			bool bParsed;
+			if (notation == EJsonNotation::ArrayStart && reader->GetIdentifier() == TEXT("row"))
+				bParsed = _ParseFirstObject(&FNeo4jStructParser::_ParseProperties);
+			else if (notation == EJsonNotation::ArrayStart && reader->GetIdentifier() == TEXT("meta"))
+				bParsed = _ParseFirstObject(&FNeo4jStructParser::_ParseMeta);
+			else
+				bParsed = _Skip(notation);
+
+			if (!bParsed)
+				return false;
+		}
+
+		return false;
+	}
+
+	bool _ParseFirstObject(bool (FNeo4jStructParser::*parseObject)())
+	{
+		bool bParsedFirst = false;
+
+		EJsonNotation notation;
+		while (reader->ReadNext(notation))
+		{
+			if (notation == EJsonNotation::ArrayEnd)
+				return true;
+
+			if (notation == EJsonNotation::ObjectStart && !bParsedFirst)
+			{
+				if (!(this->*parseObject)())
+					return false;
+
+				bParsedFirst = true;
+			}
+			else if (!_Skip(notation))
+				return false;
+		}
+
+		return false;
+	}
+
+	bool _ParseProperties()
+	{
+		int32 hint = 0;
+
+		EJsonNotation notation;
+		while (reader->ReadNext(notation))
+		{
+			if (notation == EJsonNotation::ObjectEnd)
+				return true;
+
+			int32 fieldIndex = binder._FindField(reader->GetIdentifier(), hint);
+			if (fieldIndex == INDEX_NONE)
+			{
+				if (!_Skip(notation))
+					return false;
+				continue;
+			}
+
+			hint = fieldIndex + 1;
+			const FNeo4jStructBinder::FField& field = binder.fields[fieldIndex];
+			void* value = structMemory + field.offset;
+
+			//values of the wrong type leave the field at its default
+			switch (notation)
+			{
+			case EJsonNotation::Number:
+				if (field.type == FNeo4jStructBinder::EFieldType::Int)
+					CastFieldChecked<FNumericProperty>(field.property)->SetIntPropertyValue(value, (int64)reader->GetValueAsNumber());
+				else if (field.type == FNeo4jStructBinder::EFieldType::Float)
+					CastFieldChecked<FNumericProperty>(field.property)->SetFloatingPointPropertyValue(value, reader->GetValueAsNumber());
+				break;
+			case EJsonNotation::Boolean:
+				if (field.type == FNeo4jStructBinder::EFieldType::Bool)
+					CastFieldChecked<FBoolProperty>(field.property)->SetPropertyValue(value, reader->GetValueAsBoolean());
+				break;
+			case EJsonNotation::String:
+				_SetString(field, value, reader->GetValueAsString());
+				break;
+			case EJsonNotation::Null:
+				break;
+			default:
+				if (!_Skip(notation))
+					return false;
+				break;
+			}
+		}
+
+		return false;
+	}
+
+	void _SetString(const FNeo4jStructBinder::FField& field, void* value, const FString& string)
+	{
+		switch (field.type)
+		{
+		case FNeo4jStructBinder::EFieldType::String:
+			*(FString*)value = string;
+			break;
+		case FNeo4jStructBinder::EFieldType::Name:
+			*(FName*)value = FName(*string);
+			break;
+		case FNeo4jStructBinder::EFieldType::Enum:
+		{
+			int64 enumValue = field.enumType->GetValueByNameString(string);
+			if (enumValue != INDEX_NONE)
+				CastFieldChecked<FNumericProperty>(field.enumValueProperty)->SetIntPropertyValue(value, enumValue);
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	bool _ParseMeta()
+	{
+		EJsonNotation notation;
+		while (reader->ReadNext(notation))
+		{
+			if (notation == EJsonNotation::ObjectEnd)
+				return true;
+
+			if (notation == EJsonNotation::Number && reader->GetIdentifier() == TEXT("id") && binder.idProperty)
+				CastFieldChecked<FNumericProperty>(binder.idProperty)->SetIntPropertyValue(structMemory + binder.idOffset,
+					(int64)reader->GetValueAsNumber());
+			else if (!_Skip(notation))
+				return false;
+		}
+
+		return false;
+	}
+
+	bool _Skip(EJsonNotation notation)
+	{
+		if (notation == EJsonNotation::Error)
+			return false;
+
+		if (notation != EJsonNotation::ObjectStart && notation != EJsonNotation::ArrayStart)
+			return true;
+
+		int32 depth = 1;
+		while (depth > 0 && reader->ReadNext(notation))
+		{
+			if (notation == EJsonNotation::ObjectStart || notation == EJsonNotation::ArrayStart)
+				depth++;
+			else if (notation == EJsonNotation::ObjectEnd || notation == EJsonNotation::ArrayEnd)
+				depth--;
+			else if (notation == EJsonNotation::Error)
+				return false;
+		}
+
+		return depth == 0;
+	}
+
+	const FNeo4jStructBinder& binder;
+	TFunctionRef<void*()> addStruct;
+	TSharedRef<TJsonReader<TCHAR>> reader;
+	uint8* structMemory = nullptr;
+};
+
+
+
+#pragma region STRUCT_BINDER
+
+const FNeo4jStructBinder& FNeo4jStructBinder::Get(const UScriptStruct* type)
+{
+	check(type);
+
+	//keyed weakly, hot reload replaces a struct with a new UScriptStruct and a raw key could be reused by
+	//whatever is allocated at the old address once it's collected
+	static FCriticalSection bindersLock;
+	static TMap<TWeakObjectPtr<const UScriptStruct>, TUniquePtr<FNeo4jStructBinder>> binders;
+
+	//callers may still hold a stale binder, so replaced ones are kept rather than freed
+	static TArray<TUniquePtr<FNeo4jStructBinder>> replacedBinders;
+
+	FScopeLock lock(&bindersLock);
+
+	TUniquePtr<FNeo4jStructBinder>& binder = binders.FindOrAdd(TWeakObjectPtr<const UScriptStruct>(type));
+	if (binder.IsValid() && !binder->_MatchesLayout())
+		replacedBinders.Add(MoveTemp(binder));
+
+	if (!binder.IsValid())
+		binder.Reset(new FNeo4jStructBinder(type));
+
+	return *binder;
+}
+
+FNeo4jStructBinder::FNeo4jStructBinder(const UScriptStruct* inStructType)
+	: structType(inStructType)
+	, structSize(inStructType->GetStructureSize())
+	, firstProperty(inStructType->PropertyLink)
+{
+	for (TFieldIterator<FProperty> it(structType); it; ++it)
+	{
+		const FProperty* property = *it;
+
+		//fixed size arrays would need a list per field
+		if (property->ArrayDim != 1)
+			continue;
+
+		FField field;
+		field.property = property;
+		field.offset = property->GetOffset_ForInternal();
+		field.key = property->GetName();
+		field.enumType = nullptr;
+		field.enumValueProperty = nullptr;
+
+		const FNumericProperty* numericProperty = CastField<FNumericProperty>(property);
+		const FEnumProperty* enumProperty = CastField<FEnumProperty>(property);
+
+		if (enumProperty)
+		{
+			field.type = EFieldType::Enum;
+			field.enumType = enumProperty->GetEnum();
+			field.enumValueProperty = enumProperty->GetUnderlyingProperty();
+		}
+		else if (numericProperty && numericProperty->IsEnum())
+		{
+			field.type = EFieldType::Enum;
+			field.enumType = numericProperty->GetIntPropertyEnum();
+			field.enumValueProperty = numericProperty;
+		}
+		else if (numericProperty && numericProperty->IsInteger())
+		{
+			if (field.key.Equals(TEXT("id"), ESearchCase::CaseSensitive))
+			{
+				idProperty = property;
+				idOffset = field.offset;
+				continue;
+			}
+
+			field.type = EFieldType::Int;
+		}
+		else if (numericProperty && numericProperty->IsFloatingPoint())
+			field.type = EFieldType::Float;
+		else if (property->IsA<FBoolProperty>())
+			field.type = EFieldType::Bool;
+		else if (property->IsA<FStrProperty>())
+			field.type = EFieldType::String;
+		else if (property->IsA<FNameProperty>())
+			field.type = EFieldType::Name;
+		else
+		{
+			UE_LOG(LogTemp, Log, TEXT("%s.%s has no node property form and is not bound"), *structType->GetName(), *field.key);
+			continue;
+		}
+
+		FNeo4jJsonWriter keyWriter(field.quotedKey);
+		keyWriter.WriteString(field.key);
+
+		fieldIndices.Add(field.key, fields.Num());
+		fields.Add(MoveTemp(field));
+	}
+}
+
+void FNeo4jStructBinder::WriteProperties(const void* structMemory, FNeo4jJsonWriter& writer) const
+{
+	const uint8* memory = (const uint8*)structMemory;
+
+	writer.BeginObject();
+
+	for (const FField& field : fields)
+	{
+		const void* value = memory + field.offset;
+		writer.WriteRawKey(field.quotedKey);
+
+		switch (field.type)
+		{
+		case EFieldType::Int:
+			writer.WriteInt(CastFieldChecked<FNumericProperty>(field.property)->GetSignedIntPropertyValue(value));
+			break;
+		case EFieldType::Float:
+			if (const FFloatProperty* floatProperty = CastField<FFloatProperty>(field.property))
+				writer.WriteFloat(floatProperty->GetPropertyValue(value));
+			else
+				writer.WriteNumber(CastFieldChecked<FNumericProperty>(field.property)->GetFloatingPointPropertyValue(value));
+			break;
+		case EFieldType::Bool:
+			writer.WriteBool(CastFieldChecked<FBoolProperty>(field.property)->GetPropertyValue(value));
+			break;
+		case EFieldType::String:
+			writer.WriteString(*(const FString*)value);
+			break;
+		case EFieldType::Name:
+			writer.WriteString(((const FName*)value)->ToString());
+			break;
+		case EFieldType::Enum:
+		{
+			//by name, so reordering the enum doesn't change what stored values mean
+			int64 enumValue = CastFieldChecked<FNumericProperty>(field.enumValueProperty)->GetSignedIntPropertyValue(value);
+			writer.WriteString(field.enumType->GetNameStringByValue(enumValue));
+			break;
+		}
+		}
+	}
+
+	writer.EndObject();
+}
+
+void FNeo4jStructBinder::WriteArray(const void* firstStruct, int32 num, int32 stride, FNeo4jJsonWriter& writer) const
+{
+	writer.BeginArray();
+
+	for (int32 i = 0; i < num; i++)
+		WriteProperties((const uint8*)firstStruct + (SIZE_T)i * stride, writer);
+
+	writer.EndArray();
+}
+
+bool FNeo4jStructBinder::ParseQueryResult(const FString& resultString, TFunctionRef<void*()> addStruct) const
+{
+	FNeo4jStructParser parser(*this, resultString, addStruct);
+	return parser.Parse();
+}
+
+int32 FNeo4jStructBinder::_FindField(const FString& key, int32 hint) const
+{
+	if (fields.IsValidIndex(hint) && fields[hint].key.Equals(key, ESearchCase::CaseSensitive))
+		return hint;
+
+	const int32* index = fieldIndices.Find(key);
+	return index ? *index : INDEX_NONE;
+}
+
+bool FNeo4jStructBinder::_MatchesLayout() const
+{
+	//a struct relinked in place gets new properties, the cached ones would point at freed memory
+	return structType->GetStructureSize() == structSize && structType->PropertyLink == firstProperty;
+}
+
+#pragma endregion STRUCT_BINDER
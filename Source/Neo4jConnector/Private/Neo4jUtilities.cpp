@@ -6,9 +6,24 @@
 #include <string>
 
 #include "Dom/JsonObject.h"
+#include "Neo4jJsonWriter.h"
+#include "Neo4jKeyFuncs.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
 
+#include "zlib.h"
+
+//column aliases projected queries use for the node id and labels
+static const TCHAR* PROJECTION_ID_COLUMN = TEXT("__id");
+static const TCHAR* PROJECTION_LABELS_COLUMN = TEXT("__labels");
+
+//column aliases aggregate queries use for the group key and the aggregated value
+static const TCHAR* AGGREGATE_GROUP_COLUMN = TEXT("__group");
+static const TCHAR* AGGREGATE_VALUE_COLUMN = TEXT("__value");
+
+//size of the scratch window zlib inflates/deflates through
+static const int32 ZLIB_CHUNK_SIZE = 64 * 1024;
+
 
 
 
@@ -35,6 +50,192 @@ FString UNeo4jUtilities::_ConstructJSONQueryString(FString stringToSerialize)
 
 
 
+FString UNeo4jUtilities::_ConstructJSONQueryString(const TArray<FString>& statementsToSerialize)
+{
+	TArray<TSharedPtr<FJsonValue>> statementsArray;
+
+	for (auto& statement : statementsToSerialize)
+	{
+		TSharedPtr<FJsonObject> statementObj = MakeShareable(new FJsonObject());
+		statementObj->SetStringField("statement", statement);
+		statementsArray.Add(MakeShareable(new FJsonValueObject(statementObj)));
+	}
+
+	TSharedPtr<FJsonObject> queryJsonObj = MakeShareable(new FJsonObject());
+	queryJsonObj->SetArrayField("statements", statementsArray);
+
+	FString jsonQueryString;
+	TSharedRef<TJsonWriter<TCHAR>> JsonWriter = TJsonWriterFactory<>::Create(&jsonQueryString);
+	FJsonSerializer::Serialize(queryJsonObj.ToSharedRef(), JsonWriter);
+
+	return jsonQueryString;
+}
+
+
+
+bool UNeo4jUtilities::HasQueryErrors(const FString& resultString)
+{
+	//the errors array comes last, so searching from the end skips any row data
+	int32 errorsIndex = resultString.Find(TEXT("\"errors\":["), ESearchCase::CaseSensitive, ESearchDir::FromEnd);
+	if (errorsIndex == INDEX_NONE)
+		return false;
+
+	int32 valueIndex = errorsIndex + 10;
+	while (valueIndex < resultString.Len() && FChar::IsWhitespace(resultString[valueIndex]))
+		valueIndex++;
+
+	return valueIndex < resultString.Len() && resultString[valueIndex] != TEXT(']');
+}
+
+
+
+FString UNeo4jUtilities::EscapeJsonString(const FString& string)
+{
+	FString outString;
+	outString.Reserve(string.Len() + 2);
+	outString.AppendChar('"');
+
+	for (TCHAR character : string)
+	{
+		switch (character)
+		{
+		case '"':	outString.Append(TEXT("\\\"")); break;
+		case '\\':	outString.Append(TEXT("\\\\")); break;
+		case '\n':	outString.Append(TEXT("\\n")); break;
+		case '\r':	outString.Append(TEXT("\\r")); break;
+		case '\t':	outString.Append(TEXT("\\t")); break;
+		default:
+			if (character < 0x20)
+				outString += FString::Printf(TEXT("\\u%04x"), (int32)character);
+			else
+				outString.AppendChar(character);
+		}
+	}
+
+	outString.AppendChar('"');
+	return outString;
+}
+
+FNeo4jQueryTemplate UNeo4jUtilities::MakeQueryTemplate(const FString& name, const FString& statement,
+	const TArray<FNeo4jParameterDeclaration>& parameters)
+{
+	FNeo4jQueryTemplate queryTemplate;
+	queryTemplate.name = name;
+	queryTemplate.statement = statement;
+	queryTemplate.parameters = parameters;
+
+	//everything up to the parameters value, the writer's open containers are closed by the suffix
+	FNeo4jJsonWriter writer(queryTemplate.bodyPrefix);
+	writer.BeginStatements();
+	writer.BeginStatement(statement);
+	writer.WriteKey(TEXT("parameters"));
+
+	const ANSICHAR* suffix = "}]}";
+	queryTemplate.bodySuffix.Append((const uint8*)suffix, 3);
+
+	return queryTemplate;
+}
+
+//finds a typed parameter value, logging which one is missing
+template<typename ValueType>
+static const ValueType* _FindParameter(const TMap<FString, ValueType>& parameterMap, const FNeo4jQueryTemplate& queryTemplate,
+	const FString& parameterName)
+{
+	const ValueType* value = parameterMap.Find(parameterName);
+	if (!value)
+		UE_LOG(LogTemp, Error, TEXT("Query template %s is missing parameter %s"), *queryTemplate.name, *parameterName);
+
+	return value;
+}
+
+bool UNeo4jUtilities::SerializeTemplateParameters(const FNeo4jQueryTemplate& queryTemplate, const FNeo4jQueryParameters& values,
+	FNeo4jJsonWriter& writer)
+{
+	writer.BeginObject();
+
+	for (auto& declaration : queryTemplate.parameters)
+	{
+		writer.WriteKey(declaration.name);
+
+		switch (declaration.type)
+		{
+		case ENeo4jParameterType::String:
+		{
+			const FString* value = _FindParameter(values.stringParameters, queryTemplate, declaration.name);
+			if (!value)
+				return false;
+			writer.WriteString(*value);
+			break;
+		}
+		case ENeo4jParameterType::Int:
+		{
+			const int* value = _FindParameter(values.intParameters, queryTemplate, declaration.name);
+			if (!value)
+				return false;
+			writer.WriteInt(*value);
+			break;
+		}
+		case ENeo4jParameterType::Float:
+		{
+			const float* value = _FindParameter(values.floatParameters, queryTemplate, declaration.name);
+			if (!value)
+				return false;
+			writer.WriteFloat(*value);
+			break;
+		}
+		case ENeo4jParameterType::Bool:
+		{
+			const bool* value = _FindParameter(values.boolParameters, queryTemplate, declaration.name);
+			if (!value)
+				return false;
+			writer.WriteBool(*value);
+			break;
+		}
+		case ENeo4jParameterType::StringList:
+		{
+			const FNeo4jStringList* value = _FindParameter(values.stringListParameters, queryTemplate, declaration.name);
+			if (!value)
+				return false;
+
+			writer.BeginArray();
+			for (auto& element : value->values)
+				writer.WriteString(element);
+			writer.EndArray();
+			break;
+		}
+		case ENeo4jParameterType::IntList:
+		{
+			const FNeo4jIntList* value = _FindParameter(values.intListParameters, queryTemplate, declaration.name);
+			if (!value)
+				return false;
+
+			writer.BeginArray();
+			for (int element : value->values)
+				writer.WriteInt(element);
+			writer.EndArray();
+			break;
+		}
+		case ENeo4jParameterType::FloatList:
+		{
+			const FNeo4jFloatList* value = _FindParameter(values.floatListParameters, queryTemplate, declaration.name);
+			if (!value)
+				return false;
+
+			writer.BeginArray();
+			for (float element : value->values)
+				writer.WriteFloat(element);
+			writer.EndArray();
+			break;
+		}
+		}
+	}
+
+	writer.EndObject();
+	return true;
+}
+
+
+
 //takes in an array of labels and serializes it into CYPHER format
 FString UNeo4jUtilities::SerializeLabelsIntoQuery(TArray<FString> labels)
 {
@@ -116,6 +317,458 @@ FString UNeo4jUtilities::SerializePropertiesIntoQuery(TMap<FString, FString> str
 	return outString;
 }
 
+FString UNeo4jUtilities::SerializeIDsIntoQuery(const TArray<int>& ids)
+{
+	FString outString = "[";
+
+	for (int i = 0; i < ids.Num(); i++)
+	{
+		outString.AppendInt(ids[i]);
+		if (i != ids.Num() - 1)
+			outString.Append(",");
+	}
+
+	return outString + "]";
+}
+
+FString UNeo4jUtilities::SerializeRelationPattern(const TArray<FString>& relationTypes, ENeo4jDirection direction, const FString& relationVariable,
+	const FString& lengthRange)
+{
+	FString outString = relationVariable;
+
+	bool bFirstType = true;
+	for (auto& type : relationTypes)
+	{
+		if (type.IsEmpty())
+			continue;
+
+		outString = outString + (bFirstType ? ":" : "|") + EscapeIdentifier(type);
+		bFirstType = false;
+	}
+
+	outString += lengthRange;
+
+	switch (direction)
+	{
+	case ENeo4jDirection::Outgoing:
+		return "-[" + outString + "]->";
+	case ENeo4jDirection::Incoming:
+		return "<-[" + outString + "]-";
+	default:
+		return "-[" + outString + "]-";
+	}
+}
+
+FString UNeo4jUtilities::EscapeIdentifier(const FString& identifier)
+{
+	return "`" + identifier.Replace(TEXT("`"), TEXT("``")) + "`";
+}
+
+//return id(n) as __id, n.`prop` as `prop`..., labels(n) as __labels
+FString UNeo4jUtilities::SerializeProjectionIntoReturn(const FString& nodeVariable, const FNeo4jProjection& projection)
+{
+	FString outString = "return id(" + nodeVariable + ") as " + PROJECTION_ID_COLUMN;
+
+	//cypher rejects a return clause with the same alias twice. Keys are case-sensitive, so Name and name are
+	//two columns, and a property can't take the place of the id or labels column
+	TArray<FString, TInlineAllocator<16>> aliases = { PROJECTION_ID_COLUMN, PROJECTION_LABELS_COLUMN };
+
+	for (auto& property : projection.properties)
+	{
+		if (property.IsEmpty())
+			continue;
+
+		if (aliases.ContainsByPredicate([&property](const FString& alias) { return alias.Equals(property, ESearchCase::CaseSensitive); }))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Projected property %s is a duplicate or a reserved column name and is skipped"), *property);
+			continue;
+		}
+		aliases.Add(property);
+
+		FString escaped = EscapeIdentifier(property);
+		outString = outString + ", " + nodeVariable + "." + escaped + " as " + escaped;
+	}
+
+	if (projection.bIncludeLabels)
+		outString = outString + ", labels(" + nodeVariable + ") as " + PROJECTION_LABELS_COLUMN;
+
+	return outString;
+}
+
+FString UNeo4jUtilities::SerializeAggregationIntoReturn(const FString& nodeVariable, const FNeo4jAggregation& aggregation)
+{
+	FString target = aggregation.property.IsEmpty() ? nodeVariable : nodeVariable + "." + EscapeIdentifier(aggregation.property);
+
+	FString function;
+	switch (aggregation.function)
+	{
+	case ENeo4jAggregateFunction::Sum:	function = "sum"; break;
+	case ENeo4jAggregateFunction::Avg:	function = "avg"; break;
+	case ENeo4jAggregateFunction::Min:	function = "min"; break;
+	case ENeo4jAggregateFunction::Max:	function = "max"; break;
+	default:							function = "count"; break;
+	}
+
+	FString value = function + "(" + target + ") as " + AGGREGATE_VALUE_COLUMN;
+
+	switch (aggregation.grouping)
+	{
+	case ENeo4jAggregateGrouping::Label:
+		return "unwind labels(" + nodeVariable + ") as " + AGGREGATE_GROUP_COLUMN + " return " + AGGREGATE_GROUP_COLUMN + ", " + value;
+	case ENeo4jAggregateGrouping::Property:
+		return "return " + nodeVariable + "." + EscapeIdentifier(aggregation.groupProperty) + " as " + AGGREGATE_GROUP_COLUMN + ", " + value;
+	default:
+		//a lone count over a label pattern is answered from the count store without touching nodes
+		return "return " + value;
+	}
+}
+
+FNeo4jAggregateResult UNeo4jUtilities::DeserializeAggregateQueryResult(const FString& resultString)
+{
+	FNeo4jAggregateResult outResult;
+
+	TSharedPtr<FJsonObject> jsonObjectResult = MakeShareable(new FJsonObject());
+	TSharedRef<TJsonReader<TCHAR>> jsonReader = TJsonReaderFactory<TCHAR>::Create(resultString);
+	if (!FJsonSerializer::Deserialize(jsonReader, jsonObjectResult))
+		return outResult;
+
+	for (auto& result : jsonObjectResult->GetArrayField("results"))
+	{
+		TSharedPtr<FJsonObject> resultObj = result->AsObject();
+
+		int groupColumn = INDEX_NONE;
+		int valueColumn = INDEX_NONE;
+
+		TArray<TSharedPtr<FJsonValue>> columnArray = resultObj->GetArrayField("columns");
+		for (int i = 0; i < columnArray.Num(); i++)
+		{
+			FString column = columnArray[i]->AsString();
+
+			if (column == AGGREGATE_GROUP_COLUMN)
+				groupColumn = i;
+			else if (column == AGGREGATE_VALUE_COLUMN)
+				valueColumn = i;
+		}
+
+		for (auto& dataElement : resultObj->GetArrayField("data"))
+		{
+			TArray<TSharedPtr<FJsonValue>> rowArray = dataElement->AsObject()->GetArrayField("row");
+			FNeo4jAggregateRow& row = outResult.rows.AddDefaulted_GetRef();
+
+			//numbers and bools are turned into their string form, null groups stay empty
+			if (rowArray.IsValidIndex(groupColumn) && !rowArray[groupColumn]->IsNull())
+				rowArray[groupColumn]->TryGetString(row.group);
+
+			double value;
+			if (rowArray.IsValidIndex(valueColumn) && rowArray[valueColumn]->TryGetNumber(value))
+			{
+				row.value = value;
+				row.blueprintValue = (float)value;
+				row.bHasValue = true;
+			}
+		}
+	}
+
+	return outResult;
+}
+
+FString UNeo4jUtilities::MakeIndexName(const FNeo4jIndexDefinition& definition)
+{
+	FString suffix;
+	switch (definition.type)
+	{
+	case ENeo4jIndexType::Unique:
+		suffix = "_unique";
+		break;
+	case ENeo4jIndexType::Point:
+		suffix = "_point";
+		break;
+	default:
+		suffix = "_range";
+		break;
+	}
+
+	FString name = "neo4jconnector_" + definition.label + "_" + definition.property + suffix;
+
+	//index names are identifiers too, keep them to characters that never need escaping
+	for (TCHAR& character : name.GetCharArray())
+	{
+		if (character != 0 && !FChar::IsAlnum(character) && character != '_')
+			character = '_';
+	}
+
+	//the readable part can collide (a-b and a_b, or a label/property split differently), the hash of the raw,
+	//length prefixed pair tells them apart
+	FString rawPair = FString::Printf(TEXT("%d:%s%s"), definition.label.Len(), *definition.label, *definition.property);
+	return name + FString::Printf(TEXT("_%08x"), FCrc::StrCrc32(*rawPair));
+}
+
+FString UNeo4jUtilities::SerializeIndexCreation(const FNeo4jIndexDefinition& definition)
+{
+	FString name = MakeIndexName(definition);
+	FString pattern = "(m:" + EscapeIdentifier(definition.label) + ")";
+	FString property = "m." + EscapeIdentifier(definition.property);
+
+	if (definition.type == ENeo4jIndexType::Unique)
+		return "create constraint " + name + " if not exists for " + pattern + " require " + property + " is unique";
+
+	if (definition.type == ENeo4jIndexType::Point)
+		return "create point index " + name + " if not exists for " + pattern + " on (" + property + ")";
+
+	return "create index " + name + " if not exists for " + pattern + " on (" + property + ")";
+}
+
+FString UNeo4jUtilities::SerializeFullTextIndexCreation(const FNeo4jFullTextIndexDefinition& definition)
+{
+	if (definition.name.IsEmpty() || definition.labels.Num() == 0 || definition.properties.Num() == 0)
+		return "";
+
+	TArray<FString> labels;
+	for (auto& label : definition.labels)
+		labels.Add(EscapeIdentifier(label));
+
+	TArray<FString> properties;
+	for (auto& property : definition.properties)
+		properties.Add("m." + EscapeIdentifier(property));
+
+	return "create fulltext index " + EscapeIdentifier(definition.name) + " if not exists for (m:" + FString::Join(labels, TEXT("|"))
+		+ ") on each [" + FString::Join(properties, TEXT(", ")) + "]";
+}
+
+FString UNeo4jUtilities::MakeFullTextQuery(const FString& text, ENeo4jFullTextMode mode)
+{
+	if (mode == ENeo4jFullTextMode::Lucene)
+		return text.TrimStartAndEnd();
+
+	TArray<FString> words;
+	text.ParseIntoArrayWS(words);
+
+	TArray<FString> terms;
+	terms.Reserve(words.Num());
+	for (auto& word : words)
+	{
+		//user text must never be read as lucene syntax, a stray quote or bracket fails the whole query
+		FString term;
+		term.Reserve(word.Len() + 3);
+
+		if (mode == ENeo4jFullTextMode::AllTerms)
+		{
+			//a quoted term is never an operator, only the quote and backslash need escaping inside it
+			term.AppendChar('"');
+			for (TCHAR character : word)
+			{
+				if (character == '"' || character == '\\')
+					term.AppendChar('\\');
+				term.AppendChar(character);
+			}
+			term.AppendChar('"');
+		}
+		else
+		{
+			//wildcards don't work inside quotes, and a bare AND, OR, NOT or TO is an operator. lucene only
+			//reads them in capitals, prefix terms aren't analyzed so the lowercase form matches the same words
+			static const TCHAR* operators[] = { TEXT("AND"), TEXT("OR"), TEXT("NOT"), TEXT("TO") };
+			bool bOperator = false;
+			for (const TCHAR* op : operators)
+				bOperator |= word.Equals(op, ESearchCase::CaseSensitive);
+
+			if (bOperator)
+				term = word.ToLower();
+			else
+			{
+				for (TCHAR character : word)
+				{
+					if (FCString::Strchr(TEXT("+-&|!(){}[]^\"~*?:\\/"), character))
+						term.AppendChar('\\');
+					term.AppendChar(character);
+				}
+			}
+
+			term.AppendChar('*');
+		}
+
+		terms.Add(MoveTemp(term));
+	}
+
+	return FString::Join(terms, TEXT(" AND "));
+}
+
+TArray<FNeo4jFullTextMatch> UNeo4jUtilities::DeserializeFullTextQueryResult(const FString& resultString)
+{
+	TArray<FNeo4jFullTextMatch> outMatches;
+
+	TSharedPtr<FJsonObject> jsonObjectResult = MakeShareable(new FJsonObject());
+	TSharedRef<TJsonReader<TCHAR>> jsonReader = TJsonReaderFactory<TCHAR>::Create(resultString);
+	if (!FJsonSerializer::Deserialize(jsonReader, jsonObjectResult))
+		return outMatches;
+
+	for (auto& result : jsonObjectResult->GetArrayField("results"))
+	{
+		const TArray<TSharedPtr<FJsonValue>>& dataArray = result->AsObject()->GetArrayField("data");
+		outMatches.Reserve(outMatches.Num() + dataArray.Num());
+
+		for (auto& dataElement : dataArray)
+		{
+			const TArray<TSharedPtr<FJsonValue>>& rowArray = dataElement->AsObject()->GetArrayField("row");
+			if (rowArray.Num() < 4)
+				continue;
+
+			FNeo4jFullTextMatch& match = outMatches.AddDefaulted_GetRef();
+			match.node.id = (int)rowArray[0]->AsNumber();
+			for (auto& label : rowArray[1]->AsArray())
+				match.node.labels.Add(label->AsString());
+			if (rowArray[2]->Type == EJson::Object)
+				match.node.properties = rowArray[2]->AsObject()->Values;
+			match.score = rowArray[3]->AsNumber();
+		}
+	}
+
+	return outMatches;
+}
+
+//the clock is a single node, its write lock orders every stamped transaction so markers never go backwards.
+//Merging on a constrained key is what keeps two first writers from each creating one
+static FString _SerializeClockIncrement()
+{
+	return FString("merge (__clock:") + SYNC_CLOCK_LABEL + " {" + SYNC_CLOCK_KEY_PROPERTY + ": 0}) set __clock.value = coalesce(__clock.value, 0) + 1";
+}
+
+FString UNeo4jUtilities::SerializeChangeMarkerStamp(const FString& variable)
+{
+	return _SerializeClockIncrement() + " set " + variable + "." + SYNC_MARKER_PROPERTY + " = __clock.value";
+}
+
+FString UNeo4jUtilities::SerializeTombstone(const FString& variable)
+{
+	//detach delete drops the relationships without a trace, so each gets its own tombstone first
+	return _SerializeClockIncrement() + " create (:" + SYNC_TOMBSTONE_LABEL + " {nodeId: id(" + variable + "), "
+		+ SYNC_MARKER_PROPERTY + ": __clock.value})"
+		+ " with " + variable + ", __clock optional match (" + variable + ")-[__r]-()"
+		+ " with " + variable + ", __clock, collect(distinct __r) as __removed"
+		+ " foreach (__d in __removed | create (:" + SYNC_TOMBSTONE_LABEL + " {relationshipId: id(__d), "
+		+ SYNC_MARKER_PROPERTY + ": __clock.value}))";
+}
+
+FString UNeo4jUtilities::SerializeLabelRemovalTombstone(const FString& variable, const FString& removedLabelsExpression)
+{
+	return "foreach (_ in case when size(" + removedLabelsExpression + ") > 0 then [1] else [] end | create (:" + SYNC_TOMBSTONE_LABEL
+		+ " {nodeId: id(" + variable + "), removedLabels: " + removedLabelsExpression + ", " + SYNC_MARKER_PROPERTY + ": __clock.value}))";
+}
+
+void UNeo4jUtilities::SerializeSyncIndexCreation(const TArray<FString>& syncedLabels, TArray<FString>& outStatements)
+{
+	FNeo4jIndexDefinition clockKey;
+	clockKey.label = SYNC_CLOCK_LABEL;
+	clockKey.property = SYNC_CLOCK_KEY_PROPERTY;
+	clockKey.type = ENeo4jIndexType::Unique;
+	outStatements.Add(SerializeIndexCreation(clockKey));
+
+	//Sync looks tombstones up by marker on every call
+	FNeo4jIndexDefinition tombstoneIndex;
+	tombstoneIndex.label = SYNC_TOMBSTONE_LABEL;
+	tombstoneIndex.property = SYNC_MARKER_PROPERTY;
+	outStatements.Add(SerializeIndexCreation(tombstoneIndex));
+
+	//and changed nodes by marker within the view's labels
+	for (auto& label : syncedLabels)
+	{
+		FNeo4jIndexDefinition markerIndex;
+		markerIndex.label = label;
+		markerIndex.property = SYNC_MARKER_PROPERTY;
+		outStatements.Add(SerializeIndexCreation(markerIndex));
+	}
+}
+
+FString UNeo4jUtilities::SerializeClockAdoption()
+{
+	//legacy clocks lack the key, so they never conflict with the constraint and can be folded in at any time
+	return FString("match (c:") + SYNC_CLOCK_LABEL + ") where c." + SYNC_CLOCK_KEY_PROPERTY + " is null"
+		+ " with collect(c) as legacy, max(c.value) as legacyValue where size(legacy) > 0"
+		+ " merge (__clock:" + SYNC_CLOCK_LABEL + " {" + SYNC_CLOCK_KEY_PROPERTY + ": 0})"
+		+ " set __clock.value = case when coalesce(__clock.value, 0) > coalesce(legacyValue, 0) then __clock.value else legacyValue end"
+		+ " foreach (c in legacy | delete c)";
+}
+
+void UNeo4jUtilities::SerializeNodeChanges(const TArray<FNeo4jNodeChanges>& changes, const FString& variable, TArray<FString>& outQueryArray,
+	TArray<uint8>& outParameters)
+{
+	//every label any row adds or removes, Enemy and enemy are different labels
+	TArray<FString> labels;
+	TSet<FString, FNeo4jCaseSensitiveKeyFuncs> labelSet;
+
+	FNeo4jJsonWriter writer(outParameters);
+	writer.BeginObject();
+	writer.WriteKey(TEXT("rows"));
+	writer.BeginArray();
+
+	auto writeLabels = [&labels, &labelSet, &writer](const TArray<FString>& rowLabels)
+	{
+		writer.BeginArray();
+		for (auto& label : rowLabels)
+		{
+			bool bAlreadyInSet = false;
+			labelSet.Add(label, &bAlreadyInSet);
+			if (!bAlreadyInSet)
+				labels.Add(label);
+			writer.WriteString(label);
+		}
+		writer.EndArray();
+	};
+
+	for (auto& nodeChanges : changes)
+	{
+		writer.BeginObject();
+		writer.WriteKey(TEXT("id"));
+		writer.WriteInt(nodeChanges.id);
+
+		writer.WriteKey(TEXT("properties"));
+		writer.BeginObject();
+		for (auto& property : nodeChanges.setProperties)
+		{
+			writer.WriteKey(property.Key);
+			if (property.Value.IsValid() && property.Value->Type == EJson::Number && nodeChanges.floatProperties.Contains(property.Key))
+				writer.WriteNumber(property.Value->AsNumber());
+			else
+				writer.WriteValue(property.Value);
+		}
+		for (auto& key : nodeChanges.removedProperties)
+		{
+			writer.WriteKey(key);
+			writer.WriteNull();
+		}
+		writer.EndObject();
+
+		writer.WriteKey(TEXT("addLabels"));
+		writeLabels(nodeChanges.addedLabels);
+		writer.WriteKey(TEXT("removeLabels"));
+		writeLabels(nodeChanges.removedLabels);
+		writer.EndObject();
+	}
+
+	writer.EndArray();
+
+	writer.WriteKey(TEXT("labels"));
+	writer.BeginArray();
+	for (auto& label : labels)
+		writer.WriteString(label);
+	writer.EndArray();
+
+	writer.EndObject();
+
+	outQueryArray.Add("unwind $rows as row");
+	outQueryArray.Add("match(" + variable + ") where id(" + variable + ") = row.id");
+	outQueryArray.Add("set " + variable + " += row.properties");
+
+	for (int i = 0; i < labels.Num(); i++)
+	{
+		FString label = EscapeIdentifier(labels[i]);
+		outQueryArray.Add(FString::Printf(TEXT("foreach (_ in case when $labels[%d] in row.addLabels then [1] else [] end | set %s:%s)"),
+			i, *variable, *label));
+		outQueryArray.Add(FString::Printf(TEXT("foreach (_ in case when $labels[%d] in row.removeLabels then [1] else [] end | remove %s:%s)"),
+			i, *variable, *label));
+	}
+}
+
 //FNeo4jNode -> {labelName:labelValue...propertyName:PropertyValue}
 FString UNeo4jUtilities::SerializeNode(FNeo4jNode inNode)
 {
@@ -155,20 +808,19 @@ TArray<FNeo4jNode> UNeo4jUtilities::DeserializeNodeQueryResult(FString resultStr
 				TArray<TSharedPtr<FJsonValue>> rowArray = dataElement->AsObject()->GetArrayField("row");
 				TArray<TSharedPtr<FJsonValue>> metaArray = dataElement->AsObject()->GetArrayField("meta");
 
-				//foreach object in row array
-				for (auto& rowElement : rowArray)
-				{
-					TSharedPtr<FJsonObject> rowObj = rowElement->AsObject();
-					newNode.properties = rowObj->Values;
+				//the node is the first column, queries that return labels(m) have them in the second
+				if (rowArray.Num() > 0 && rowArray[0]->Type == EJson::Object)
+					newNode.properties = rowArray[0]->AsObject()->Values;
 
+				if (rowArray.Num() > 1 && rowArray[1]->Type == EJson::Array)
+				{
+					for (auto& label : rowArray[1]->AsArray())
+						newNode.labels.Add(label->AsString());
 				}
 
-				//foreach object in meta array
-				for (auto& metaElement : metaArray)
-				{
-					TSharedPtr<FJsonObject> metaObj = metaElement->AsObject();
-					newNode.id = metaObj->GetIntegerField("id");
-				}
+				//meta has one entry per column, null for the labels
+				if (metaArray.Num() > 0 && metaArray[0]->Type == EJson::Object)
+					newNode.id = metaArray[0]->AsObject()->GetIntegerField("id");
 
 				outArray.Add(newNode);
 			}
@@ -180,3 +832,733 @@ TArray<FNeo4jNode> UNeo4jUtilities::DeserializeNodeQueryResult(FString resultStr
 	return outArray;
 }
 
+
+
+
+FString UNeo4jUtilities::SerializeNumber(double value)
+{
+	//same form as request parameters, 1 written as an integer would stop comparing equal to 1.0 in range predicates
+	TArray<uint8> text;
+	FNeo4jJsonWriter writer(text);
+	writer.WriteNumber(value);
+
+	return FString(text.Num(), (const ANSICHAR*)text.GetData());
+}
+
+FString UNeo4jUtilities::SerializeNumber(float value)
+{
+	TArray<uint8> text;
+	FNeo4jJsonWriter writer(text);
+	writer.WriteFloat(value);
+
+	return FString(text.Num(), (const ANSICHAR*)text.GetData());
+}
+
+FString UNeo4jUtilities::SerializePoint(const FNeo4jPoint& point)
+{
+	FString outString = "point({x:" + SerializeNumber(point.location.X) + ", y:" + SerializeNumber(point.location.Y);
+	if (point.b3D)
+		outString = outString + ", z:" + SerializeNumber(point.location.Z);
+
+	return outString + "})";
+}
+
+FString UNeo4jUtilities::SerializeSpatialPropertiesIntoQuery(const TMap<FString, float>& floatProps, const TMap<FString, FNeo4jPoint>& pointProps)
+{
+	TArray<FString> members;
+	members.Reserve(floatProps.Num() + pointProps.Num());
+
+	for (auto& floatProp : floatProps)
+		members.Add(EscapeIdentifier(floatProp.Key) + ":" + SerializeNumber(floatProp.Value));
+
+	for (auto& pointProp : pointProps)
+		members.Add(EscapeIdentifier(pointProp.Key) + ":" + SerializePoint(pointProp.Value));
+
+	if (members.Num() == 0)
+		return "";
+
+	return "{" + FString::Join(members, TEXT(",")) + "}";
+}
+
+bool UNeo4jUtilities::GetPointProperty(const FNeo4jNode& node, const FString& property, FNeo4jPoint& outPoint)
+{
+	const TSharedPtr<FJsonValue>* value = node.properties.Find(property);
+	if (!value || !value->IsValid() || (*value)->Type != EJson::Object)
+		return false;
+
+	TSharedPtr<FJsonObject> pointObj = (*value)->AsObject();
+	FString type;
+	const TArray<TSharedPtr<FJsonValue>>* coordinates;
+	if (!pointObj->TryGetStringField("type", type) || type != "Point" || !pointObj->TryGetArrayField("coordinates", coordinates)
+		|| coordinates->Num() < 2)
+		return false;
+
+	outPoint.b3D = coordinates->Num() > 2;
+	outPoint.location.X = (*coordinates)[0]->AsNumber();
+	outPoint.location.Y = (*coordinates)[1]->AsNumber();
+	outPoint.location.Z = outPoint.b3D ? (*coordinates)[2]->AsNumber() : 0.f;
+	return true;
+}
+
+TArray<FNeo4jSpatialMatch> UNeo4jUtilities::DeserializeSpatialQueryResult(const FString& resultString)
+{
+	TArray<FNeo4jSpatialMatch> outMatches;
+
+	TSharedPtr<FJsonObject> jsonObjectResult = MakeShareable(new FJsonObject());
+	TSharedRef<TJsonReader<TCHAR>> jsonReader = TJsonReaderFactory<TCHAR>::Create(resultString);
+	if (!FJsonSerializer::Deserialize(jsonReader, jsonObjectResult))
+		return outMatches;
+
+	for (auto& result : jsonObjectResult->GetArrayField("results"))
+	{
+		const TArray<TSharedPtr<FJsonValue>>& dataArray = result->AsObject()->GetArrayField("data");
+		outMatches.Reserve(outMatches.Num() + dataArray.Num());
+
+		for (auto& dataElement : dataArray)
+		{
+			const TArray<TSharedPtr<FJsonValue>>& rowArray = dataElement->AsObject()->GetArrayField("row");
+			if (rowArray.Num() < 4)
+				continue;
+
+			FNeo4jSpatialMatch& match = outMatches.AddDefaulted_GetRef();
+			match.node.id = (int)rowArray[0]->AsNumber();
+			for (auto& label : rowArray[1]->AsArray())
+				match.node.labels.Add(label->AsString());
+			if (rowArray[2]->Type == EJson::Object)
+				match.node.properties = rowArray[2]->AsObject()->Values;
+
+			//box queries return null
+			if (rowArray[3]->Type == EJson::Number)
+				match.distance = rowArray[3]->AsNumber();
+		}
+	}
+
+	return outMatches;
+}
+
+//takes in raw output from a projected query and splits it into id, label and value columns
+FNeo4jProjectedResult UNeo4jUtilities::DeserializeProjectedQueryResult(const FString& resultString)
+{
+	FNeo4jProjectedResult outResult;
+
+	TSharedPtr<FJsonObject> jsonObjectResult = MakeShareable(new FJsonObject());
+	TSharedRef<TJsonReader<TCHAR>> jsonReader = TJsonReaderFactory<TCHAR>::Create(resultString);
+	if (!FJsonSerializer::Deserialize(jsonReader, jsonObjectResult))
+		return outResult;
+
+	for (auto& result : jsonObjectResult->GetArrayField("results"))
+	{
+		TSharedPtr<FJsonObject> resultObj = result->AsObject();
+
+		//map response columns onto id/labels/value slots
+		int idColumn = INDEX_NONE;
+		int labelsColumn = INDEX_NONE;
+		TArray<int> valueColumns;
+
+		TArray<TSharedPtr<FJsonValue>> columnArray = resultObj->GetArrayField("columns");
+		for (int i = 0; i < columnArray.Num(); i++)
+		{
+			FString column = columnArray[i]->AsString();
+
+			if (column.Equals(PROJECTION_ID_COLUMN, ESearchCase::CaseSensitive))
+				idColumn = i;
+			else if (column.Equals(PROJECTION_LABELS_COLUMN, ESearchCase::CaseSensitive))
+				labelsColumn = i;
+			else
+			{
+				valueColumns.Add(i);
+				if (outResult.columns.Num() < valueColumns.Num())
+					outResult.columns.Add(column);
+			}
+		}
+
+		TArray<TSharedPtr<FJsonValue>> dataArray = resultObj->GetArrayField("data");
+		outResult.ids.Reserve(outResult.ids.Num() + dataArray.Num());
+		outResult.values.Reserve(outResult.values.Num() + dataArray.Num() * valueColumns.Num());
+
+		for (auto& dataElement : dataArray)
+		{
+			TArray<TSharedPtr<FJsonValue>> rowArray = dataElement->AsObject()->GetArrayField("row");
+
+			outResult.ids.Add(rowArray.IsValidIndex(idColumn) ? (int)rowArray[idColumn]->AsNumber() : INDEX_NONE);
+
+			for (int column : valueColumns)
+			{
+				TSharedPtr<FJsonValue> value = rowArray.IsValidIndex(column) ? rowArray[column] : TSharedPtr<FJsonValue>();
+				outResult.values.Add(value.IsValid() && !value->IsNull() ? value : TSharedPtr<FJsonValue>());
+			}
+
+			if (labelsColumn != INDEX_NONE)
+			{
+				TArray<FString>& rowLabels = outResult.labels.AddDefaulted_GetRef();
+				if (rowArray.IsValidIndex(labelsColumn))
+				{
+					for (auto& label : rowArray[labelsColumn]->AsArray())
+						rowLabels.Add(label->AsString());
+				}
+			}
+		}
+	}
+
+	return outResult;
+}
+
+
+
+
+//rows are [name, type, labelsOrTypes, properties, state, owningConstraint]
+TArray<FNeo4jIndexInfo> UNeo4jUtilities::DeserializeIndexQueryResult(const FString& resultString)
+{
+	TArray<FNeo4jIndexInfo> outIndexes;
+
+	TSharedPtr<FJsonObject> jsonObjectResult = MakeShareable(new FJsonObject());
+	TSharedRef<TJsonReader<TCHAR>> jsonReader = TJsonReaderFactory<TCHAR>::Create(resultString);
+	if (!FJsonSerializer::Deserialize(jsonReader, jsonObjectResult))
+		return outIndexes;
+
+	for (auto& result : jsonObjectResult->GetArrayField("results"))
+	{
+		for (auto& dataElement : result->AsObject()->GetArrayField("data"))
+		{
+			TArray<TSharedPtr<FJsonValue>> rowArray = dataElement->AsObject()->GetArrayField("row");
+			if (rowArray.Num() < 6)
+				continue;
+
+			FNeo4jIndexInfo& index = outIndexes.AddDefaulted_GetRef();
+			rowArray[0]->TryGetString(index.name);
+			rowArray[1]->TryGetString(index.type);
+			rowArray[4]->TryGetString(index.state);
+			rowArray[5]->TryGetString(index.owningConstraint);
+
+			//lookup indexes report null here
+			const TArray<TSharedPtr<FJsonValue>>* values;
+			if (rowArray[2]->TryGetArray(values))
+			{
+				for (auto& value : *values)
+					index.labelsOrTypes.Add(value->AsString());
+			}
+			if (rowArray[3]->TryGetArray(values))
+			{
+				for (auto& value : *values)
+					index.properties.Add(value->AsString());
+			}
+		}
+	}
+
+	return outIndexes;
+}
+
+bool UNeo4jUtilities::DeserializeSchemaCatalog(const FString& resultString, TArray<FString>& outLabels, TArray<FString>& outRelationshipTypes,
+	TArray<FString>& outPropertyKeys)
+{
+	TSharedPtr<FJsonObject> jsonObjectResult = MakeShareable(new FJsonObject());
+	TSharedRef<TJsonReader<TCHAR>> jsonReader = TJsonReaderFactory<TCHAR>::Create(resultString);
+	if (!FJsonSerializer::Deserialize(jsonReader, jsonObjectResult))
+		return false;
+
+	const TArray<TSharedPtr<FJsonValue>>& resultsArray = jsonObjectResult->GetArrayField("results");
+	if (resultsArray.Num() < 3)
+		return false;
+
+	TArray<FString>* outLists[] = { &outLabels, &outRelationshipTypes, &outPropertyKeys };
+	for (int i = 0; i < 3; i++)
+	{
+		outLists[i]->Reset();
+
+		const TArray<TSharedPtr<FJsonValue>>& dataArray = resultsArray[i]->AsObject()->GetArrayField("data");
+		if (dataArray.Num() == 0)
+			continue;
+
+		const TArray<TSharedPtr<FJsonValue>>& rowArray = dataArray[0]->AsObject()->GetArrayField("row");
+		if (rowArray.Num() == 0 || rowArray[0]->Type != EJson::Array)
+			continue;
+
+		for (auto& name : rowArray[0]->AsArray())
+			outLists[i]->Add(name->AsString());
+	}
+
+	return true;
+}
+
+//plan operators name their counters differently between server versions and between plan/profile
+static double _GetPlanNumber(const TSharedPtr<FJsonObject>& planObj, const TCHAR* lowerName, const TCHAR* upperName)
+{
+	double value = 0.0;
+	if (planObj->TryGetNumberField(lowerName, value) || planObj->TryGetNumberField(upperName, value))
+		return value;
+
+	const TSharedPtr<FJsonObject>* arguments;
+	if (planObj->TryGetObjectField("arguments", arguments) || planObj->TryGetObjectField("args", arguments))
+	{
+		if ((*arguments)->TryGetNumberField(lowerName, value) || (*arguments)->TryGetNumberField(upperName, value))
+			return value;
+	}
+
+	return 0.0;
+}
+
+//flattens the operator tree depth first
+static void _DeserializePlanOperator(const TSharedPtr<FJsonObject>& planObj, int parentIndex, int depth, FNeo4jQueryPlan& outPlan)
+{
+	int index = outPlan.operators.AddDefaulted();
+	{
+		FNeo4jPlanOperator& planOperator = outPlan.operators[index];
+		planOperator.parentIndex = parentIndex;
+		planOperator.depth = depth;
+
+		if (!planObj->TryGetStringField("operatorType", planOperator.operatorType))
+			planObj->TryGetStringField("name", planOperator.operatorType);
+
+		planObj->TryGetStringArrayField("identifiers", planOperator.identifiers);
+
+		planOperator.estimatedRows = _GetPlanNumber(planObj, TEXT("estimatedRows"), TEXT("EstimatedRows"));
+		planOperator.rows = (int64)_GetPlanNumber(planObj, TEXT("rows"), TEXT("Rows"));
+		planOperator.dbHits = (int64)_GetPlanNumber(planObj, TEXT("dbHits"), TEXT("DbHits"));
+
+		outPlan.totalDbHits += planOperator.dbHits;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* children;
+	if (planObj->TryGetArrayField("children", children))
+	{
+		for (auto& child : *children)
+		{
+			if (child->Type == EJson::Object)
+				_DeserializePlanOperator(child->AsObject(), index, depth + 1, outPlan);
+		}
+	}
+}
+
+bool UNeo4jUtilities::DeserializeQueryPlan(const FString& resultString, FNeo4jQueryPlan& outPlan)
+{
+	TSharedPtr<FJsonObject> jsonObjectResult = MakeShareable(new FJsonObject());
+	TSharedRef<TJsonReader<TCHAR>> jsonReader = TJsonReaderFactory<TCHAR>::Create(resultString);
+	if (!FJsonSerializer::Deserialize(jsonReader, jsonObjectResult))
+		return false;
+
+	for (auto& result : jsonObjectResult->GetArrayField("results"))
+	{
+		const TSharedPtr<FJsonObject>* planObj;
+		if (!result->AsObject()->TryGetObjectField("profile", planObj) && !result->AsObject()->TryGetObjectField("plan", planObj))
+			continue;
+
+		//EXPLAIN wraps the tree in a root object, PROFILE reports the root directly
+		const TSharedPtr<FJsonObject>* rootObj;
+		if ((*planObj)->TryGetObjectField("root", rootObj))
+			planObj = rootObj;
+
+		_DeserializePlanOperator(*planObj, INDEX_NONE, 0, outPlan);
+		return true;
+	}
+
+	return false;
+}
+
+//rows are [node or null, marker, deleted id or null]
+void UNeo4jUtilities::DeserializeSyncResult(const FString& resultString, TArray<FNeo4jNode>& outChangedNodes, TArray<int>& outDeletedIDs,
+	int64& inOutMarker)
+{
+	outChangedNodes.Reset();
+	outDeletedIDs.Reset();
+
+	TSharedPtr<FJsonObject> jsonObjectResult = MakeShareable(new FJsonObject());
+	TSharedRef<TJsonReader<TCHAR>> jsonReader = TJsonReaderFactory<TCHAR>::Create(resultString);
+	if (!FJsonSerializer::Deserialize(jsonReader, jsonObjectResult))
+		return;
+
+	for (auto& result : jsonObjectResult->GetArrayField("results"))
+	{
+		for (auto& dataElement : result->AsObject()->GetArrayField("data"))
+		{
+			TArray<TSharedPtr<FJsonValue>> rowArray = dataElement->AsObject()->GetArrayField("row");
+			TArray<TSharedPtr<FJsonValue>> metaArray = dataElement->AsObject()->GetArrayField("meta");
+
+			if (rowArray.Num() < 4)
+				continue;
+
+			double marker;
+			if (rowArray[2]->TryGetNumber(marker))
+				inOutMarker = FMath::Max(inOutMarker, (int64)marker);
+
+			if (rowArray[0]->Type == EJson::Object && metaArray.Num() > 0 && metaArray[0]->Type == EJson::Object)
+			{
+				FNeo4jNode& node = outChangedNodes.AddDefaulted_GetRef();
+				node.properties = rowArray[0]->AsObject()->Values;
+				node.id = metaArray[0]->AsObject()->GetIntegerField("id");
+				if (rowArray[1]->Type == EJson::Array)
+				{
+					for (auto& label : rowArray[1]->AsArray())
+						node.labels.Add(label->AsString());
+				}
+			}
+			else if (rowArray[3]->Type == EJson::Number)
+			{
+				outDeletedIDs.Add((int)rowArray[3]->AsNumber());
+			}
+		}
+	}
+}
+
+
+
+
+bool UNeo4jUtilities::DeserializeSubgraphQueryResult(const FString& resultString, FNeo4jSubgraph& outSubgraph)
+{
+	outSubgraph = FNeo4jSubgraph();
+
+	TSharedPtr<FJsonObject> jsonObjectResult = MakeShareable(new FJsonObject());
+	TSharedRef<TJsonReader<TCHAR>> jsonReader = TJsonReaderFactory<TCHAR>::Create(resultString);
+	if (!FJsonSerializer::Deserialize(jsonReader, jsonObjectResult))
+		return false;
+
+	const TArray<TSharedPtr<FJsonValue>>& resultsArray = jsonObjectResult->GetArrayField("results");
+	if (resultsArray.Num() < 3)
+		return false;
+
+	//nodes: row is [properties, labels], meta carries the id
+	for (auto& dataElement : resultsArray[0]->AsObject()->GetArrayField("data"))
+	{
+		const TArray<TSharedPtr<FJsonValue>>& rowArray = dataElement->AsObject()->GetArrayField("row");
+		const TArray<TSharedPtr<FJsonValue>>& metaArray = dataElement->AsObject()->GetArrayField("meta");
+		if (rowArray.Num() < 2 || metaArray.Num() < 1 || metaArray[0]->Type != EJson::Object)
+			continue;
+
+		FNeo4jNode& node = outSubgraph.nodes.AddDefaulted_GetRef();
+		node.id = metaArray[0]->AsObject()->GetIntegerField("id");
+		node.properties = rowArray[0]->AsObject()->Values;
+		for (auto& label : rowArray[1]->AsArray())
+			node.labels.Add(label->AsString());
+	}
+
+	//relationships: row is [id, type, start id, end id, properties]
+	for (auto& dataElement : resultsArray[1]->AsObject()->GetArrayField("data"))
+	{
+		const TArray<TSharedPtr<FJsonValue>>& rowArray = dataElement->AsObject()->GetArrayField("row");
+		if (rowArray.Num() < 5)
+			continue;
+
+		FNeo4jRelationship& relationship = outSubgraph.relationships.AddDefaulted_GetRef();
+		relationship.id = (int)rowArray[0]->AsNumber();
+		relationship.type = rowArray[1]->AsString();
+		relationship.startNode = (int)rowArray[2]->AsNumber();
+		relationship.endNode = (int)rowArray[3]->AsNumber();
+		if (rowArray[4]->Type == EJson::Object)
+			relationship.properties = rowArray[4]->AsObject()->Values;
+	}
+
+	for (auto& dataElement : resultsArray[2]->AsObject()->GetArrayField("data"))
+	{
+		const TArray<TSharedPtr<FJsonValue>>& rowArray = dataElement->AsObject()->GetArrayField("row");
+		double clock;
+		if (rowArray.Num() > 0 && rowArray[0]->TryGetNumber(clock))
+			outSubgraph.dataVersion = (int64)clock;
+	}
+
+	return true;
+}
+
+TMap<int, FNeo4jNeighbourList> UNeo4jUtilities::DeserializeNeighbourBatchResult(const FString& resultString)
+{
+	TMap<int, FNeo4jNeighbourList> outNeighbours;
+
+	TSharedPtr<FJsonObject> jsonObjectResult = MakeShareable(new FJsonObject());
+	TSharedRef<TJsonReader<TCHAR>> jsonReader = TJsonReaderFactory<TCHAR>::Create(resultString);
+	if (!FJsonSerializer::Deserialize(jsonReader, jsonObjectResult))
+		return outNeighbours;
+
+	for (auto& result : jsonObjectResult->GetArrayField("results"))
+	{
+		for (auto& dataElement : result->AsObject()->GetArrayField("data"))
+		{
+			const TArray<TSharedPtr<FJsonValue>>& rowArray = dataElement->AsObject()->GetArrayField("row");
+			if (rowArray.Num() < 2 || rowArray[1]->Type != EJson::Array)
+				continue;
+
+			//sources without neighbours still get an empty list so callers can tell them from missing ones
+			FNeo4jNeighbourList& neighbourList = outNeighbours.FindOrAdd((int)rowArray[0]->AsNumber());
+			const TArray<TSharedPtr<FJsonValue>>& neighbourArray = rowArray[1]->AsArray();
+			neighbourList.neighbours.Reserve(neighbourList.neighbours.Num() + neighbourArray.Num());
+
+			for (auto& neighbourValue : neighbourArray)
+			{
+				const TArray<TSharedPtr<FJsonValue>>& neighbourRow = neighbourValue->AsArray();
+				if (neighbourRow.Num() < 6)
+					continue;
+
+				FNeo4jNeighbour& neighbour = neighbourList.neighbours.AddDefaulted_GetRef();
+				neighbour.node.id = (int)neighbourRow[0]->AsNumber();
+				for (auto& label : neighbourRow[1]->AsArray())
+					neighbour.node.labels.Add(label->AsString());
+				if (neighbourRow[2]->Type == EJson::Object)
+					neighbour.node.properties = neighbourRow[2]->AsObject()->Values;
+
+				neighbour.relationshipType = neighbourRow[3]->AsString();
+				neighbour.relationshipID = (int)neighbourRow[4]->AsNumber();
+				neighbour.direction = neighbourRow[5]->AsBool() ? ENeo4jDirection::Outgoing : ENeo4jDirection::Incoming;
+			}
+		}
+	}
+
+	return outNeighbours;
+}
+
+TArray<FNeo4jPath> UNeo4jUtilities::DeserializePathQueryResult(const FString& resultString)
+{
+	TArray<FNeo4jPath> outPaths;
+
+	TSharedPtr<FJsonObject> jsonObjectResult = MakeShareable(new FJsonObject());
+	TSharedRef<TJsonReader<TCHAR>> jsonReader = TJsonReaderFactory<TCHAR>::Create(resultString);
+	if (!FJsonSerializer::Deserialize(jsonReader, jsonObjectResult))
+		return outPaths;
+
+	for (auto& result : jsonObjectResult->GetArrayField("results"))
+	{
+		for (auto& dataElement : result->AsObject()->GetArrayField("data"))
+		{
+			const TArray<TSharedPtr<FJsonValue>>& rowArray = dataElement->AsObject()->GetArrayField("row");
+			if (rowArray.Num() < 2 || rowArray[0]->Type != EJson::Array || rowArray[1]->Type != EJson::Array)
+				continue;
+
+			FNeo4jPath& path = outPaths.AddDefaulted_GetRef();
+
+			for (auto& nodeValue : rowArray[0]->AsArray())
+			{
+				const TArray<TSharedPtr<FJsonValue>>& nodeRow = nodeValue->AsArray();
+				if (nodeRow.Num() < 3)
+					continue;
+
+				FNeo4jNode& node = path.nodes.AddDefaulted_GetRef();
+				node.id = (int)nodeRow[0]->AsNumber();
+				for (auto& label : nodeRow[1]->AsArray())
+					node.labels.Add(label->AsString());
+				if (nodeRow[2]->Type == EJson::Object)
+					node.properties = nodeRow[2]->AsObject()->Values;
+			}
+
+			for (auto& relationshipValue : rowArray[1]->AsArray())
+			{
+				const TArray<TSharedPtr<FJsonValue>>& relationshipRow = relationshipValue->AsArray();
+				if (relationshipRow.Num() < 5)
+					continue;
+
+				FNeo4jRelationship& relationship = path.relationships.AddDefaulted_GetRef();
+				relationship.id = (int)relationshipRow[0]->AsNumber();
+				relationship.type = relationshipRow[1]->AsString();
+				relationship.startNode = (int)relationshipRow[2]->AsNumber();
+				relationship.endNode = (int)relationshipRow[3]->AsNumber();
+				if (relationshipRow[4]->Type == EJson::Object)
+					relationship.properties = relationshipRow[4]->AsObject()->Values;
+			}
+
+			path.cost = path.relationships.Num();
+		}
+	}
+
+	return outPaths;
+}
+
+bool UNeo4jUtilities::DeserializeSyncClock(const FString& resultString, int64& outClock)
+{
+	TSharedPtr<FJsonObject> jsonObjectResult = MakeShareable(new FJsonObject());
+	TSharedRef<TJsonReader<TCHAR>> jsonReader = TJsonReaderFactory<TCHAR>::Create(resultString);
+	if (!FJsonSerializer::Deserialize(jsonReader, jsonObjectResult))
+		return false;
+
+	const TArray<TSharedPtr<FJsonValue>>& resultsArray = jsonObjectResult->GetArrayField("results");
+	if (resultsArray.Num() < 1)
+		return false;
+
+	for (auto& dataElement : resultsArray[0]->AsObject()->GetArrayField("data"))
+	{
+		const TArray<TSharedPtr<FJsonValue>>& rowArray = dataElement->AsObject()->GetArrayField("row");
+		double clock;
+		if (rowArray.Num() > 0 && rowArray[0]->TryGetNumber(clock))
+		{
+			outClock = (int64)clock;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+
+//gzip wraps the deflate stream so the server can decode it with Content-Encoding: gzip
+bool UNeo4jUtilities::CompressPayload(const TArray<uint8>& inPayload, TArray<uint8>& outCompressed)
+{
+	outCompressed.Reset();
+
+	z_stream stream;
+	FMemory::Memzero(stream);
+
+	//15 window bits + 16 selects the gzip header instead of the zlib one
+	if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+		return false;
+
+	outCompressed.SetNumUninitialized(deflateBound(&stream, inPayload.Num()));
+
+	stream.next_in = (Bytef*)inPayload.GetData();
+	stream.avail_in = inPayload.Num();
+	stream.next_out = outCompressed.GetData();
+	stream.avail_out = outCompressed.Num();
+
+	int result = deflate(&stream, Z_FINISH);
+	deflateEnd(&stream);
+
+	if (result != Z_STREAM_END)
+	{
+		outCompressed.Reset();
+		return false;
+	}
+
+	outCompressed.SetNum(stream.total_out, false);
+	return true;
+}
+
+//inflates gzip/zlib/raw deflate bodies without knowing the decoded size up front
+bool UNeo4jUtilities::DecompressPayload(const TArray<uint8>& inPayload, const FString& contentEncoding, int64 maxDecompressedBytes,
+	TFunctionRef<bool(const uint8* chunk, int32 chunkSize)> onChunk)
+{
+	if (inPayload.Num() == 0)
+		return false;
+
+	//the header says which wrapper to expect. Some servers send "deflate" without the zlib header, so that alone is
+	//retried as a raw stream, gzip never is
+	TArray<int, TInlineAllocator<2>> windowBitsToTry;
+	if (contentEncoding.Equals("gzip", ESearchCase::IgnoreCase) || contentEncoding.Equals("x-gzip", ESearchCase::IgnoreCase))
+	{
+		windowBitsToTry.Add(15 + 16);
+	}
+	else if (contentEncoding.Equals("deflate", ESearchCase::IgnoreCase))
+	{
+		windowBitsToTry.Add(15);
+		windowBitsToTry.Add(-15);
+	}
+	else
+	{
+		return false;
+	}
+
+	TArray<uint8> chunk;
+	chunk.SetNumUninitialized(ZLIB_CHUNK_SIZE);
+
+	for (int windowBits : windowBitsToTry)
+	{
+		z_stream stream;
+		FMemory::Memzero(stream);
+
+		if (inflateInit2(&stream, windowBits) != Z_OK)
+			return false;
+
+		stream.next_in = (Bytef*)inPayload.GetData();
+		stream.avail_in = inPayload.Num();
+
+		int64 inflatedBytes = 0;
+		int result = Z_OK;
+		while (result == Z_OK)
+		{
+			stream.next_out = chunk.GetData();
+			stream.avail_out = ZLIB_CHUNK_SIZE;
+
+			result = inflate(&stream, Z_NO_FLUSH);
+			if (result != Z_OK && result != Z_STREAM_END)
+				break;
+
+			int32 chunkSize = ZLIB_CHUNK_SIZE - stream.avail_out;
+			inflatedBytes += chunkSize;
+
+			//a small body that inflates without end is a decompression bomb, stop before it is held anywhere
+			if (inflatedBytes > maxDecompressedBytes)
+			{
+				UE_LOG(LogTemp, Error, TEXT("Response inflates to more than %lld bytes"), maxDecompressedBytes);
+				inflateEnd(&stream);
+				return false;
+			}
+
+			if (chunkSize > 0 && !onChunk(chunk.GetData(), chunkSize))
+			{
+				inflateEnd(&stream);
+				return false;
+			}
+		}
+
+		inflateEnd(&stream);
+
+		if (result == Z_STREAM_END)
+			return true;
+
+		//whatever was handed out already cannot be taken back, so only a stream that failed at its start is retried
+		if (inflatedBytes > 0)
+			return false;
+	}
+
+	return false;
+}
+
+//bytes at the end of data that begin a utf-8 sequence the next chunk finishes
+static int32 _IncompleteUTF8Tail(const uint8* data, int32 size)
+{
+	//a sequence is at most 4 bytes, so only the last 3 can start one that is cut off
+	for (int32 back = 1; back <= FMath::Min(3, size); back++)
+	{
+		uint8 byte = data[size - back];
+		if ((byte & 0xC0) == 0x80)
+			continue;
+
+		int32 length = (byte & 0xE0) == 0xC0 ? 2 : (byte & 0xF0) == 0xE0 ? 3 : (byte & 0xF8) == 0xF0 ? 4 : 1;
+		return length > back ? back : 0;
+	}
+
+	return 0;
+}
+
+bool UNeo4jUtilities::DecompressPayloadToString(const TArray<uint8>& inPayload, const FString& contentEncoding, int64 maxDecompressedBytes,
+	FString& outContent, bool& outInflatedAny)
+{
+	outContent.Reset();
+	outInflatedAny = false;
+
+	//at most a cut off utf-8 sequence waits here for the rest of it
+	TArray<uint8, TInlineAllocator<4>> pending;
+
+	auto appendUTF8 = [&outContent](const uint8* data, int32 size)
+	{
+		FUTF8ToTCHAR converter((const ANSICHAR*)data, size);
+		outContent.AppendChars(converter.Get(), converter.Length());
+	};
+
+	bool bDecompressed = DecompressPayload(inPayload, contentEncoding, maxDecompressedBytes,
+		[&](const uint8* chunk, int32 chunkSize)
+		{
+			outInflatedAny = true;
+
+			int32 offset = 0;
+			if (pending.Num() > 0)
+			{
+				//finish the sequence left over from the previous chunk first
+				while (offset < chunkSize && pending.Num() < 4 && _IncompleteUTF8Tail(pending.GetData(), pending.Num()) > 0)
+					pending.Add(chunk[offset++]);
+
+				appendUTF8(pending.GetData(), pending.Num());
+				pending.Reset();
+			}
+
+			int32 tail = _IncompleteUTF8Tail(chunk + offset, chunkSize - offset);
+			appendUTF8(chunk + offset, chunkSize - offset - tail);
+			pending.Append(chunk + chunkSize - tail, tail);
+
+			return true;
+		});
+
+	if (!bDecompressed)
+	{
+		outContent.Reset();
+		return false;
+	}
+
+	if (pending.Num() > 0)
+		appendUTF8(pending.GetData(), pending.Num());
+
+	return true;
+}
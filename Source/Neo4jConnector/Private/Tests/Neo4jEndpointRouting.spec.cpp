@@ -0,0 +1,255 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Neo4jDatabase.h"
+
+#include "Containers/Ticker.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "HttpPath.h"
+#include "HttpServerRequest.h"
+#include "HttpServerModule.h"
+#include "HttpServerResponse.h"
+#include "IHttpRouter.h"
+
+BEGIN_DEFINE_SPEC(FNeo4jEndpointRoutingSpec, "Neo4jConnector.Endpoints", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+	//stub servers answering the health probe, nothing listens on the closed port
+	static constexpr uint32 HEALTHY_PORT = 19474;
+	static constexpr uint32 FAILING_PORT = 19475;
+	static constexpr uint32 CLOSED_PORT = 19476;
+
+	UNeo4jDatabase* database = nullptr;
+
+	TArray<TPair<TSharedPtr<IHttpRouter>, FHttpRouteHandle>> stubRoutes;
+
+	FDelegateHandle waitHandle;
+
+	static FNeo4jEndpoint _MakeEndpoint(uint32 port, ENeo4jEndpointRole role)
+	{
+		FNeo4jEndpoint endpoint;
+		endpoint.IP = TEXT("127.0.0.1");
+		endpoint.HTTPport = FString::FromInt(port);
+		endpoint.role = role;
+		return endpoint;
+	}
+
+	//unhealthy, and not due for a probe while the test runs
+	void _MarkUnhealthy(int32 index)
+	{
+		database->endpoints[index].bHealthy = false;
+		database->endpoints[index].nextProbeTime = FPlatformTime::Seconds() + 3600.0;
+	}
+
+	void _BindStub(uint32 port, EHttpServerResponseCodes code)
+	{
+		TSharedPtr<IHttpRouter> router = FHttpServerModule::Get().GetHttpRouter(port);
+		if (!TestTrue(FString::Printf(TEXT("router on port %u"), port), router.IsValid()))
+			return;
+
+		FHttpRouteHandle route = router->BindRoute(FHttpPath(TEXT("/")), EHttpServerRequestVerbs::VERB_GET,
+			[code](const FHttpServerRequest& request, const FHttpResultCallback& onComplete)
+		{
+			TUniquePtr<FHttpServerResponse> response = FHttpServerResponse::Create(TEXT("{}"), TEXT("application/json"));
+			response->Code = code;
+			onComplete(MoveTemp(response));
+			return true;
+		});
+
+		stubRoutes.Emplace(router, route);
+	}
+
+	//calls done on the first tick condition holds
+	void _WaitUntil(TFunction<bool()> condition, const FDoneDelegate& done)
+	{
+		waitHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([condition, done](float deltaTime)
+		{
+			if (!condition())
+				return true;
+
+			done.Execute();
+			return false;
+		}));
+	}
+
+END_DEFINE_SPEC(FNeo4jEndpointRoutingSpec)
+
+void FNeo4jEndpointRoutingSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		database = NewObject<UNeo4jDatabase>();
+		database->AddToRoot();
+		database->bEnsureIndexesOnInitialize = false;
+		database->failuresBeforeUnhealthy = 2;
+		database->unhealthyRetrySeconds = 60.f;
+	});
+
+	AfterEach([this]()
+	{
+		//a timed out wait would otherwise keep polling a database that is gone
+		FTicker::GetCoreTicker().RemoveTicker(waitHandle);
+		waitHandle.Reset();
+
+		for (auto& route : stubRoutes)
+			route.Key->UnbindRoute(route.Value);
+		stubRoutes.Reset();
+
+		database->RemoveFromRoot();
+		database = nullptr;
+	});
+
+	Describe("_PickEndpoint", [this]()
+	{
+		BeforeEach([this]()
+		{
+			database->InitializeCluster({ _MakeEndpoint(CLOSED_PORT, ENeo4jEndpointRole::Reader), _MakeEndpoint(CLOSED_PORT, ENeo4jEndpointRole::Writer),
+				_MakeEndpoint(CLOSED_PORT, ENeo4jEndpointRole::Reader) }, TEXT("neo4j"), TEXT("test"));
+		});
+
+		It("routes writes to the writer", [this]()
+		{
+			TestEqual(TEXT("endpoint"), database->_PickEndpoint(false), 1);
+		});
+
+		It("routes reads to the least loaded healthy reader", [this]()
+		{
+			database->endpoints[0].outstandingRequests = 2;
+			database->endpoints[2].outstandingRequests = 1;
+			TestEqual(TEXT("endpoint"), database->_PickEndpoint(true), 2);
+
+			database->endpoints[2].outstandingRequests = 3;
+			TestEqual(TEXT("endpoint"), database->_PickEndpoint(true), 0);
+		});
+
+		It("takes turns between equally loaded readers", [this]()
+		{
+			int32 first = database->_PickEndpoint(true);
+			int32 second = database->_PickEndpoint(true);
+
+			TestTrue(TEXT("first is a reader"), first == 0 || first == 2);
+			TestTrue(TEXT("second is the other reader"), (second == 0 || second == 2) && second != first);
+		});
+
+		It("skips unhealthy readers", [this]()
+		{
+			_MarkUnhealthy(2);
+			for (int32 i = 0; i < 3; i++)
+				TestEqual(TEXT("endpoint"), database->_PickEndpoint(true), 0);
+		});
+
+		It("falls back to the writer when no reader is healthy", [this]()
+		{
+			_MarkUnhealthy(0);
+			_MarkUnhealthy(2);
+			TestEqual(TEXT("endpoint"), database->_PickEndpoint(true), 1);
+		});
+
+		It("still routes writes to an unhealthy writer so the caller sees the failure", [this]()
+		{
+			_MarkUnhealthy(1);
+			TestEqual(TEXT("endpoint"), database->_PickEndpoint(false), 1);
+		});
+
+		It("returns INDEX_NONE without endpoints", [this]()
+		{
+			database->InitializeCluster({}, TEXT("neo4j"), TEXT("test"));
+			TestEqual(TEXT("endpoint"), database->_PickEndpoint(true), (int32)INDEX_NONE);
+			TestEqual(TEXT("endpoint"), database->_PickEndpoint(false), (int32)INDEX_NONE);
+		});
+	});
+
+	Describe("_ReportEndpointResult", [this]()
+	{
+		BeforeEach([this]()
+		{
+			database->InitializeCluster({ _MakeEndpoint(CLOSED_PORT, ENeo4jEndpointRole::Writer) }, TEXT("neo4j"), TEXT("test"));
+		});
+
+		It("marks an endpoint unhealthy after failuresBeforeUnhealthy failures in a row", [this]()
+		{
+			AddExpectedError(TEXT("marked unhealthy"), EAutomationExpectedErrorFlags::Contains, 1);
+
+			database->_ReportEndpointResult(0, false);
+			TestTrue(TEXT("healthy after one failure"), database->endpoints[0].bHealthy);
+
+			database->_ReportEndpointResult(0, false);
+			TestFalse(TEXT("healthy after two failures"), database->endpoints[0].bHealthy);
+			TestTrue(TEXT("probe scheduled"), database->endpoints[0].nextProbeTime > FPlatformTime::Seconds());
+		});
+
+		It("starts counting again after a success", [this]()
+		{
+			database->_ReportEndpointResult(0, false);
+			database->_ReportEndpointResult(0, true);
+			database->_ReportEndpointResult(0, false);
+			TestTrue(TEXT("healthy"), database->endpoints[0].bHealthy);
+		});
+	});
+
+	Describe("_OnEndpointProbe", [this]()
+	{
+		BeforeEach([this]()
+		{
+			_BindStub(HEALTHY_PORT, EHttpServerResponseCodes::Ok);
+			_BindStub(FAILING_PORT, EHttpServerResponseCodes::ServiceUnavail);
+			FHttpServerModule::Get().StartAllListeners();
+
+			database->failuresBeforeUnhealthy = 1;
+			database->InitializeCluster({ _MakeEndpoint(HEALTHY_PORT, ENeo4jEndpointRole::Writer), _MakeEndpoint(FAILING_PORT, ENeo4jEndpointRole::Reader),
+				_MakeEndpoint(CLOSED_PORT, ENeo4jEndpointRole::Reader) }, TEXT("neo4j"), TEXT("test"));
+		});
+
+		LatentIt("marks endpoints that answer with a server error or not at all unhealthy", FTimespan::FromSeconds(10.0), [this](const FDoneDelegate& done)
+		{
+			AddExpectedError(TEXT("marked unhealthy"), EAutomationExpectedErrorFlags::Contains, 2);
+
+			database->CheckEndpointHealth();
+			_WaitUntil([this]()
+			{
+				return !database->endpoints[1].bHealthy && !database->endpoints[2].bHealthy;
+			}, done);
+		});
+
+		LatentIt("routes reads to the writer once every reader failed its probe", FTimespan::FromSeconds(10.0), [this](const FDoneDelegate& done)
+		{
+			AddExpectedError(TEXT("marked unhealthy"), EAutomationExpectedErrorFlags::Contains, 2);
+
+			database->CheckEndpointHealth();
+			_WaitUntil([this]()
+			{
+				if (database->endpoints[1].bHealthy || database->endpoints[2].bHealthy)
+					return false;
+
+				TestTrue(TEXT("writer healthy"), database->endpoints[0].bHealthy);
+				TestEqual(TEXT("endpoint"), database->_PickEndpoint(true), 0);
+				return true;
+			}, done);
+		});
+
+		LatentIt("makes an endpoint healthy again once its probe succeeds", FTimespan::FromSeconds(10.0), [this](const FDoneDelegate& done)
+		{
+			_MarkUnhealthy(0);
+			database->_ProbeEndpoint(0);
+			_WaitUntil([this]()
+			{
+				return database->endpoints[0].bHealthy;
+			}, done);
+		});
+
+		It("ignores answers for endpoints that are no longer configured", [this]()
+		{
+			database->_OnEndpointProbe(nullptr, nullptr, false, TEXT("http://127.0.0.1:1"));
+
+			for (auto& state : database->endpoints)
+			{
+				TestTrue(TEXT("healthy"), state.bHealthy);
+				TestEqual(TEXT("failures"), state.consecutiveFailures, 0);
+			}
+		});
+	});
+}
+
+#endif
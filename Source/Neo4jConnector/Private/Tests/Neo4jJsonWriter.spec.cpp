@@ -0,0 +1,184 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Neo4jJsonWriter.h"
+
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FNeo4jJsonWriterSpec, "Neo4jConnector.JsonWriter", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+	TArray<uint8> buffer;
+
+	FString _Written() const
+	{
+		FUTF8ToTCHAR converter((const ANSICHAR*)buffer.GetData(), buffer.Num());
+		return FString(converter.Length(), converter.Get());
+	}
+
+END_DEFINE_SPEC(FNeo4jJsonWriterSpec)
+
+void FNeo4jJsonWriterSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		buffer.Reset();
+	});
+
+	Describe("containers", [this]()
+	{
+		It("places commas between members and values only", [this]()
+		{
+			FNeo4jJsonWriter writer(buffer);
+			writer.BeginObject();
+			writer.WriteKey(TEXT("a"));
+			writer.WriteInt(1);
+			writer.WriteKey(TEXT("b"));
+			writer.BeginArray();
+			writer.WriteBool(true);
+			writer.WriteNull();
+			writer.WriteString(TEXT("x"));
+			writer.EndArray();
+			writer.WriteKey(TEXT("c"));
+			writer.BeginObject();
+			writer.EndObject();
+			writer.EndObject();
+
+			TestEqual(TEXT("json"), _Written(), TEXT("{\"a\":1,\"b\":[true,null,\"x\"],\"c\":{}}"));
+		});
+
+		It("appends to what is already in the buffer", [this]()
+		{
+			buffer.Add('[');
+
+			FNeo4jJsonWriter writer(buffer);
+			writer.WriteInt(-7);
+
+			TestEqual(TEXT("json"), _Written(), TEXT("[-7"));
+		});
+
+		It("writes the transactional request body", [this]()
+		{
+			FNeo4jJsonWriter writer(buffer);
+			writer.BeginStatements();
+			writer.WriteStatement(TEXT("match (m) return m"));
+			writer.WriteStatement(TEXT("return 1"), true);
+			writer.EndStatements();
+
+			TestEqual(TEXT("json"), _Written(), TEXT("{\"statements\":[{\"statement\":\"match (m) return m\"},")
+				TEXT("{\"statement\":\"return 1\",\"resultDataContents\":[\"row\"]}]}"));
+		});
+	});
+
+	Describe("strings", [this]()
+	{
+		It("escapes quotes, backslashes and control characters", [this]()
+		{
+			FNeo4jJsonWriter writer(buffer);
+			writer.WriteString(TEXT("a\"b\\c\nd\te\x01"));
+
+			TestEqual(TEXT("json"), _Written(), TEXT("\"a\\\"b\\\\c\\nd\\te\\u0001\""));
+		});
+
+		It("encodes non-ascii text as utf-8", [this]()
+		{
+			FNeo4jJsonWriter writer(buffer);
+			writer.WriteString(TEXT("\u00e9\u20ac"));
+
+			const uint8 expected[] = { '"', 0xC3, 0xA9, 0xE2, 0x82, 0xAC, '"' };
+			TestTrue(TEXT("bytes"), buffer == TArray<uint8>(expected, UE_ARRAY_COUNT(expected)));
+		});
+
+		It("writes keys already quoted by a previous writer as they are", [this]()
+		{
+			TArray<uint8> quotedKey;
+			FNeo4jJsonWriter keyWriter(quotedKey);
+			keyWriter.WriteString(TEXT("na\"me"));
+
+			FNeo4jJsonWriter writer(buffer);
+			writer.BeginObject();
+			writer.WriteRawKey(quotedKey);
+			writer.WriteInt(1);
+			writer.EndObject();
+
+			TestEqual(TEXT("json"), _Written(), TEXT("{\"na\\\"me\":1}"));
+		});
+	});
+
+	Describe("numbers", [this]()
+	{
+		It("keeps a fraction on whole floats", [this]()
+		{
+			FNeo4jJsonWriter writer(buffer);
+			writer.BeginArray();
+			writer.WriteNumber(2.0);
+			writer.WriteNumber(-0.5);
+			writer.EndArray();
+
+			TestEqual(TEXT("json"), _Written(), TEXT("[2.0,-0.5]"));
+		});
+
+		It("writes floats with only the digits the float has", [this]()
+		{
+			FNeo4jJsonWriter writer(buffer);
+			writer.BeginArray();
+			writer.WriteFloat(0.1f);
+			writer.WriteFloat(2.f);
+			writer.WriteFloat(1.f / 3.f);
+			writer.EndArray();
+
+			TestEqual(TEXT("json"), _Written(), TEXT("[0.1,2.0,0.33333334]"));
+		});
+
+		It("writes non finite numbers as null", [this]()
+		{
+			//volatile so the compiler doesn't warn about the division
+			volatile double zero = 0.0;
+
+			FNeo4jJsonWriter writer(buffer);
+			writer.BeginArray();
+			writer.WriteNumber(1.0 / zero);
+			writer.WriteNumber(zero / zero);
+			writer.EndArray();
+
+			TestEqual(TEXT("json"), _Written(), TEXT("[null,null]"));
+		});
+
+		It("round-trips doubles exactly", [this]()
+		{
+			const double values[] = { 0.1, 1.0 / 3.0, 123456789.123456789, 1e-300 };
+
+			FNeo4jJsonWriter writer(buffer);
+			writer.BeginArray();
+			for (double value : values)
+				writer.WriteNumber(value);
+			writer.EndArray();
+
+			TArray<TSharedPtr<FJsonValue>> parsed;
+			TSharedRef<TJsonReader<TCHAR>> reader = TJsonReaderFactory<TCHAR>::Create(_Written());
+			TestTrue(TEXT("parsed"), FJsonSerializer::Deserialize(reader, parsed));
+			TestEqual(TEXT("count"), parsed.Num(), (int32)UE_ARRAY_COUNT(values));
+
+			for (int32 i = 0; i < parsed.Num() && i < (int32)UE_ARRAY_COUNT(values); i++)
+				TestTrue(FString::Printf(TEXT("value %d"), i), parsed[i]->AsNumber() == values[i]);
+		});
+
+		It("writes parsed whole numbers as integers", [this]()
+		{
+			FNeo4jJsonWriter writer(buffer);
+			writer.BeginArray();
+			writer.WriteValue(MakeShared<FJsonValueNumber>(3.0));
+			writer.WriteValue(MakeShared<FJsonValueNumber>(3.25));
+			writer.EndArray();
+
+			TestEqual(TEXT("json"), _Written(), TEXT("[3,3.25]"));
+		});
+	});
+}
+
+#endif
@@ -0,0 +1,227 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Neo4jMappedGraph.h"
+
+#include "Dom/JsonValue.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FNeo4jMappedGraphSpec, "Neo4jConnector.MappedGraph", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+	FString filePath;
+	FNeo4jMappedGraph graph;
+
+	static FNeo4jNode _MakeNode(int id, const FString& label, const FString& name, double age)
+	{
+		FNeo4jNode node;
+		node.id = id;
+		node.labels.Add(label);
+		node.properties.Add(TEXT("name"), MakeShared<FJsonValueString>(name));
+		node.properties.Add(TEXT("age"), MakeShared<FJsonValueNumber>(age));
+		return node;
+	}
+
+	static FNeo4jRelationship _MakeRelationship(int id, const FString& type, int startNode, int endNode)
+	{
+		FNeo4jRelationship relationship;
+		relationship.id = id;
+		relationship.type = type;
+		relationship.startNode = startNode;
+		relationship.endNode = endNode;
+		return relationship;
+	}
+
+	//rewrites the exported file with one part of it broken
+	void _Corrupt(TFunctionRef<void(TArray<uint8>& bytes, FNeo4jMappedGraphHeader& header)> corrupt)
+	{
+		TArray<uint8> bytes;
+		FFileHelper::LoadFileToArray(bytes, *filePath);
+		corrupt(bytes, *(FNeo4jMappedGraphHeader*)bytes.GetData());
+		FFileHelper::SaveArrayToFile(bytes, *filePath);
+	}
+
+	void _TestRejected(bool bValidateIndices = false)
+	{
+		AddExpectedError(TEXT("is not a valid mapped graph file"), EAutomationExpectedErrorFlags::Contains, 1);
+		TestFalse(TEXT("opened"), graph.Open(filePath, bValidateIndices));
+		TestFalse(TEXT("left open"), graph.IsOpen());
+	}
+
+END_DEFINE_SPEC(FNeo4jMappedGraphSpec)
+
+void FNeo4jMappedGraphSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		filePath = FPaths::AutomationTransientDir() / TEXT("Neo4jMappedGraphSpec.graph");
+		IFileManager::Get().MakeDirectory(*FPaths::AutomationTransientDir(), true);
+
+		FNeo4jSubgraph subgraph;
+		subgraph.nodes.Add(_MakeNode(10, TEXT("Person"), TEXT("Ada"), 36.0));
+		subgraph.nodes.Add(_MakeNode(20, TEXT("City"), TEXT("London"), 2000.0));
+		subgraph.nodes.Add(_MakeNode(30, TEXT("Person"), TEXT("Charles"), 79.0));
+		subgraph.relationships.Add(_MakeRelationship(1, TEXT("LIVES_IN"), 10, 20));
+		subgraph.relationships.Add(_MakeRelationship(2, TEXT("LIVES_IN"), 30, 20));
+
+		TestTrue(TEXT("exported"), UNeo4jMappedGraph::ExportMappedGraph(subgraph, filePath));
+	});
+
+	AfterEach([this]()
+	{
+		//a mapped file can't be deleted or rewritten while it is open
+		graph.Close();
+		IFileManager::Get().Delete(*filePath);
+	});
+
+	Describe("Open", [this]()
+	{
+		It("reads back what ExportMappedGraph wrote", [this]()
+		{
+			if (!TestTrue(TEXT("opened"), graph.Open(filePath)))
+				return;
+
+			TestEqual(TEXT("nodes"), graph.Num(), 3);
+			TestEqual(TEXT("missing id"), graph.FindNode(99), (int32)INDEX_NONE);
+
+			int32 city = graph.FindNode(20);
+			if (!TestTrue(TEXT("city found"), city != INDEX_NONE))
+				return;
+
+			TestEqual(TEXT("city id"), graph.GetNodeID(city), 20);
+			TestEqual(TEXT("people living there"), graph.GetIncomingEdges(city).Num(), 2);
+			TestEqual(TEXT("city's own relationships"), graph.GetOutgoingEdges(city).Num(), 0);
+			TestEqual(TEXT("people"), graph.GetNodesWithLabel(TEXT("Person")).Num(), 2);
+
+			FString name;
+			TestTrue(TEXT("has name"), graph.GetStringProperty(city, TEXT("name"), name));
+			TestEqual(TEXT("name"), name, FString(TEXT("London")));
+
+			double age = 0.0;
+			TestTrue(TEXT("has age"), graph.GetNumberProperty(graph.FindNode(10), TEXT("age"), age));
+			TestEqual(TEXT("age"), age, 36.0);
+		});
+
+		It("rejects a truncated file", [this]()
+		{
+			_Corrupt([](TArray<uint8>& bytes, FNeo4jMappedGraphHeader& header)
+			{
+				bytes.SetNum(bytes.Num() / 2);
+			});
+			_TestRejected();
+		});
+
+		It("rejects another format", [this]()
+		{
+			_Corrupt([](TArray<uint8>& bytes, FNeo4jMappedGraphHeader& header)
+			{
+				header.formatVersion++;
+			});
+			_TestRejected();
+		});
+
+		It("rejects an edge to a node past the last one when validating indices", [this]()
+		{
+			_Corrupt([](TArray<uint8>& bytes, FNeo4jMappedGraphHeader& header)
+			{
+				((FNeo4jMappedEdge*)(bytes.GetData() + header.outEdgesOffset))[0].node = header.numNodes;
+			});
+			_TestRejected(true);
+		});
+
+		It("rejects a node label outside the string table when validating indices", [this]()
+		{
+			_Corrupt([](TArray<uint8>& bytes, FNeo4jMappedGraphHeader& header)
+			{
+				((uint32*)(bytes.GetData() + header.nodeLabelsOffset))[0] = header.numStrings;
+			});
+			_TestRejected(true);
+		});
+
+		It("rejects a string property outside the string table when validating indices", [this]()
+		{
+			_Corrupt([](TArray<uint8>& bytes, FNeo4jMappedGraphHeader& header)
+			{
+				FNeo4jMappedColumn* columns = (FNeo4jMappedColumn*)(bytes.GetData() + header.columnsOffset);
+				for (uint32 i = 0; i < header.numColumns; i++)
+				{
+					//every node has a name, so the first value is present
+					if (columns[i].type == ENeo4jMappedColumnType::String)
+						((uint32*)(bytes.GetData() + columns[i].valuesOffset))[0] = header.numStrings;
+				}
+			});
+			_TestRejected(true);
+		});
+
+		It("skips an edge to a node past the last one when only bounds are checked", [this]()
+		{
+			_Corrupt([](TArray<uint8>& bytes, FNeo4jMappedGraphHeader& header)
+			{
+				((FNeo4jMappedEdge*)(bytes.GetData() + header.outEdgesOffset))[0].node = header.numNodes;
+			});
+
+			if (!TestTrue(TEXT("opened"), graph.Open(filePath)))
+				return;
+
+			TArray<int32> neighbours;
+			graph.GetNeighbours(graph.FindNode(10), ENeo4jDirection::Outgoing, TArray<FString>(), neighbours);
+			TestEqual(TEXT("neighbours"), neighbours.Num(), 0);
+		});
+	});
+
+	Describe("FNeo4jMappedGraphBuilder", [this]()
+	{
+		It("writes pages added one at a time like a single subgraph", [this]()
+		{
+			FNeo4jMappedGraphBuilder builder;
+			builder.SetDataVersion(7);
+			builder.AddNodes({ _MakeNode(30, TEXT("Person"), TEXT("Charles"), 79.0) });
+			builder.AddRelationships({ _MakeRelationship(2, TEXT("LIVES_IN"), 30, 20) });
+			builder.AddNodes({ _MakeNode(20, TEXT("City"), TEXT("London"), 2000.0) });
+			TestTrue(TEXT("written"), builder.Write(filePath));
+
+			if (!TestTrue(TEXT("opened"), graph.Open(filePath, true)))
+				return;
+
+			TestEqual(TEXT("data version"), graph.GetDataVersion(), (int64)7);
+			TestEqual(TEXT("nodes"), graph.Num(), 2);
+			TestEqual(TEXT("ids sorted"), graph.GetNodeID(0), 20);
+			TestEqual(TEXT("people living in the city"), graph.GetIncomingEdges(graph.FindNode(20)).Num(), 1);
+		});
+
+		It("keeps keys and values that differ only in case apart", [this]()
+		{
+			FNeo4jNode node;
+			node.id = 1;
+			node.labels.Add(TEXT("Person"));
+			node.properties.Add(TEXT("name"), MakeShared<FJsonValueString>(TEXT("ada")));
+
+			FNeo4jNode otherNode;
+			otherNode.id = 2;
+			otherNode.labels.Add(TEXT("person"));
+			otherNode.properties.Add(TEXT("Name"), MakeShared<FJsonValueString>(TEXT("Ada")));
+
+			FNeo4jMappedGraphBuilder builder;
+			builder.AddNodes({ node, otherNode });
+			TestTrue(TEXT("written"), builder.Write(filePath));
+
+			if (!TestTrue(TEXT("opened"), graph.Open(filePath, true)))
+				return;
+
+			FString name;
+			TestTrue(TEXT("lower case key"), graph.GetStringProperty(graph.FindNode(1), TEXT("name"), name));
+			TestEqual(TEXT("lower case value"), name, FString(TEXT("ada")));
+			TestFalse(TEXT("other node has no lower case key"), graph.GetStringProperty(graph.FindNode(2), TEXT("name"), name));
+			TestTrue(TEXT("upper case key"), graph.GetStringProperty(graph.FindNode(2), TEXT("Name"), name));
+			TestEqual(TEXT("upper case value"), name, FString(TEXT("Ada")));
+			TestEqual(TEXT("Person"), graph.GetNodesWithLabel(TEXT("Person")).Num(), 1);
+			TestEqual(TEXT("person"), graph.GetNodesWithLabel(TEXT("person")).Num(), 1);
+		});
+	});
+}
+
+#endif
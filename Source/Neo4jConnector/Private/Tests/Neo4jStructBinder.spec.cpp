@@ -0,0 +1,125 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Neo4jStructBinder.h"
+
+#include "Misc/AutomationTest.h"
+#include "Neo4jJsonWriter.h"
+#include "Neo4jStructBinderTestStruct.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FNeo4jStructBinderSpec, "Neo4jConnector.StructBinder", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+	static FString _ToString(const TArray<uint8>& buffer)
+	{
+		FUTF8ToTCHAR converter((const ANSICHAR*)buffer.GetData(), buffer.Num());
+		return FString(converter.Length(), converter.Get());
+	}
+
+	//one node row the way the transactional endpoint returns it
+	static FString _MakeResponse(const FString& properties, int id)
+	{
+		return FString::Printf(TEXT("{\"results\":[{\"columns\":[\"m\"],\"data\":[{\"row\":[%s],")
+			TEXT("\"meta\":[{\"id\":%d,\"type\":\"node\",\"deleted\":false}]}]}],\"errors\":[]}"), *properties, id);
+	}
+
+END_DEFINE_SPEC(FNeo4jStructBinderSpec)
+
+void FNeo4jStructBinderSpec::Define()
+{
+	Describe("Get", [this]()
+	{
+		It("builds one binder per struct type", [this]()
+		{
+			const FNeo4jStructBinder& binder = FNeo4jStructBinder::Get<FNeo4jStructBinderTestStruct>();
+			TestTrue(TEXT("same binder"), &binder == &FNeo4jStructBinder::Get(FNeo4jStructBinderTestStruct::StaticStruct()));
+			TestTrue(TEXT("struct"), binder.GetStruct() == FNeo4jStructBinderTestStruct::StaticStruct());
+		});
+
+		It("binds every supported field but the id", [this]()
+		{
+			TestEqual(TEXT("fields"), FNeo4jStructBinder::Get<FNeo4jStructBinderTestStruct>().Num(), 6);
+		});
+	});
+
+	Describe("WriteProperties", [this]()
+	{
+		It("writes every bound field, enums by name", [this]()
+		{
+			FNeo4jStructBinderTestStruct value;
+			value.id = 5;
+			value.count = 3;
+			value.weight = 1.5f;
+			value.bEnabled = true;
+			value.name = TEXT("a\"b");
+			value.tag = TEXT("t");
+			value.role = ENeo4jEndpointRole::Reader;
+			value.unbound.Add(1);
+
+			TArray<uint8> buffer;
+			FNeo4jJsonWriter writer(buffer);
+			FNeo4jStructBinder::Get<FNeo4jStructBinderTestStruct>().WriteProperties(&value, writer);
+
+			TestEqual(TEXT("json"), _ToString(buffer),
+				TEXT("{\"count\":3,\"weight\":1.5,\"bEnabled\":true,\"name\":\"a\\\"b\",\"tag\":\"t\",\"role\":\"Reader\"}"));
+		});
+	});
+
+	Describe("ParseQueryResult", [this]()
+	{
+		It("fills fields by name and the id from meta", [this]()
+		{
+			TArray<FNeo4jStructBinderTestStruct> values;
+			bool bParsed = FNeo4jStructBinder::Get<FNeo4jStructBinderTestStruct>().ParseQueryResult(_MakeResponse(
+				TEXT("{\"role\":\"Reader\",\"name\":\"x\",\"extra\":{\"nested\":[1,2]},\"count\":7,\"bEnabled\":true,\"weight\":2.5}"), 42), values);
+
+			TestTrue(TEXT("parsed"), bParsed);
+			if (!TestEqual(TEXT("rows"), values.Num(), 1))
+				return;
+
+			TestEqual(TEXT("id"), values[0].id, 42);
+			TestEqual(TEXT("count"), values[0].count, 7);
+			TestEqual(TEXT("weight"), values[0].weight, 2.5f);
+			TestTrue(TEXT("bEnabled"), values[0].bEnabled);
+			TestEqual(TEXT("name"), values[0].name, FString(TEXT("x")));
+			TestTrue(TEXT("role"), values[0].role == ENeo4jEndpointRole::Reader);
+		});
+
+		It("matches keys case-sensitively", [this]()
+		{
+			TArray<FNeo4jStructBinderTestStruct> values;
+			FNeo4jStructBinder::Get<FNeo4jStructBinderTestStruct>().ParseQueryResult(_MakeResponse(
+				TEXT("{\"Count\":7,\"NAME\":\"x\",\"count\":1}"), 1), values);
+
+			if (!TestEqual(TEXT("rows"), values.Num(), 1))
+				return;
+
+			TestEqual(TEXT("count"), values[0].count, 1);
+			TestTrue(TEXT("name left at its default"), values[0].name.IsEmpty());
+		});
+
+		It("leaves fields with values of the wrong type at their default", [this]()
+		{
+			TArray<FNeo4jStructBinderTestStruct> values;
+			FNeo4jStructBinder::Get<FNeo4jStructBinderTestStruct>().ParseQueryResult(_MakeResponse(
+				TEXT("{\"count\":\"seven\",\"bEnabled\":1,\"role\":\"NoSuchRole\",\"name\":null}"), 1), values);
+
+			if (!TestEqual(TEXT("rows"), values.Num(), 1))
+				return;
+
+			TestEqual(TEXT("count"), values[0].count, 0);
+			TestFalse(TEXT("bEnabled"), values[0].bEnabled);
+			TestTrue(TEXT("role"), values[0].role == ENeo4jEndpointRole::Writer);
+			TestTrue(TEXT("name"), values[0].name.IsEmpty());
+		});
+
+		It("returns false for invalid json", [this]()
+		{
+			TArray<FNeo4jStructBinderTestStruct> values;
+			TestFalse(TEXT("parsed"), FNeo4jStructBinder::Get<FNeo4jStructBinderTestStruct>().ParseQueryResult(TEXT("{\"results\":[{"), values));
+		});
+	});
+}
+
+#endif
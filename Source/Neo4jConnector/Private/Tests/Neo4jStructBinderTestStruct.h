@@ -0,0 +1,42 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "Neo4jEndpoint.h"
+#include "Neo4jStructBinderTestStruct.generated.h"
+
+
+//one field of every kind FNeo4jStructBinder binds, and one it doesn't
+USTRUCT()
+struct FNeo4jStructBinderTestStruct
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY()
+		int32 id = INDEX_NONE;
+
+	UPROPERTY()
+		int32 count = 0;
+
+	UPROPERTY()
+		float weight = 0.f;
+
+	UPROPERTY()
+		bool bEnabled = false;
+
+	UPROPERTY()
+		FString name;
+
+	UPROPERTY()
+		FName tag;
+
+	UPROPERTY()
+		ENeo4jEndpointRole role = ENeo4jEndpointRole::Writer;
+
+	UPROPERTY()
+		TArray<int32> unbound;
+
+};
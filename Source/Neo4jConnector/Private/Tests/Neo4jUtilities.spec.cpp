@@ -0,0 +1,107 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Neo4jUtilities.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FNeo4jUtilitiesSpec, "Neo4jConnector.Utilities", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+	static FNeo4jIndexDefinition _MakeIndex(const FString& label, const FString& property, ENeo4jIndexType type = ENeo4jIndexType::Range)
+	{
+		FNeo4jIndexDefinition definition;
+		definition.label = label;
+		definition.property = property;
+		definition.type = type;
+		return definition;
+	}
+
+END_DEFINE_SPEC(FNeo4jUtilitiesSpec)
+
+void FNeo4jUtilitiesSpec::Define()
+{
+	Describe("MakeFullTextQuery", [this]()
+	{
+		It("quotes every word for AllTerms", [this]()
+		{
+			TestEqual(TEXT("query"), UNeo4jUtilities::MakeFullTextQuery(TEXT("  rock   roll "), ENeo4jFullTextMode::AllTerms),
+				TEXT("\"rock\" AND \"roll\""));
+		});
+
+		It("keeps operators and syntax literal inside AllTerms quotes", [this]()
+		{
+			TestEqual(TEXT("query"), UNeo4jUtilities::MakeFullTextQuery(TEXT("NOT a\"b c\\ (d)"), ENeo4jFullTextMode::AllTerms),
+				TEXT("\"NOT\" AND \"a\\\"b\" AND \"c\\\\\" AND \"(d)\""));
+		});
+
+		It("turns every word into a prefix for AllPrefixes", [this]()
+		{
+			TestEqual(TEXT("query"), UNeo4jUtilities::MakeFullTextQuery(TEXT("neo graph"), ENeo4jFullTextMode::AllPrefixes),
+				TEXT("neo* AND graph*"));
+		});
+
+		It("escapes lucene syntax in AllPrefixes words", [this]()
+		{
+			TestEqual(TEXT("query"), UNeo4jUtilities::MakeFullTextQuery(TEXT("a+b c:d e*"), ENeo4jFullTextMode::AllPrefixes),
+				TEXT("a\\+b* AND c\\:d* AND e\\**"));
+		});
+
+		It("lowercases bare operators in AllPrefixes", [this]()
+		{
+			TestEqual(TEXT("query"), UNeo4jUtilities::MakeFullTextQuery(TEXT("rock AND OR NOT TO And"), ENeo4jFullTextMode::AllPrefixes),
+				TEXT("rock* AND and* AND or* AND not* AND to* AND And*"));
+		});
+
+		It("passes Lucene text through trimmed", [this]()
+		{
+			TestEqual(TEXT("query"), UNeo4jUtilities::MakeFullTextQuery(TEXT(" title:neo~ "), ENeo4jFullTextMode::Lucene),
+				TEXT("title:neo~"));
+		});
+
+		It("returns nothing for text without words", [this]()
+		{
+			TestTrue(TEXT("AllTerms"), UNeo4jUtilities::MakeFullTextQuery(TEXT(" \t "), ENeo4jFullTextMode::AllTerms).IsEmpty());
+			TestTrue(TEXT("AllPrefixes"), UNeo4jUtilities::MakeFullTextQuery(TEXT(""), ENeo4jFullTextMode::AllPrefixes).IsEmpty());
+		});
+	});
+
+	Describe("MakeIndexName", [this]()
+	{
+		It("is stable for the same definition", [this]()
+		{
+			TestEqual(TEXT("name"), UNeo4jUtilities::MakeIndexName(_MakeIndex(TEXT("Person"), TEXT("name"))),
+				UNeo4jUtilities::MakeIndexName(_MakeIndex(TEXT("Person"), TEXT("name"))));
+		});
+
+		It("only uses characters that never need escaping", [this]()
+		{
+			FString name = UNeo4jUtilities::MakeIndexName(_MakeIndex(TEXT("My Label"), TEXT("a-b.c`d")));
+
+			TestTrue(TEXT("prefix"), name.StartsWith(TEXT("neo4jconnector_"), ESearchCase::CaseSensitive));
+			for (TCHAR character : name)
+				TestTrue(FString::Printf(TEXT("'%c' is plain"), character), FChar::IsAlnum(character) || character == '_');
+		});
+
+		It("tells apart pairs that sanitize to the same text", [this]()
+		{
+			TestNotEqual(TEXT("a-b and a_b"), UNeo4jUtilities::MakeIndexName(_MakeIndex(TEXT("a-b"), TEXT("c"))),
+				UNeo4jUtilities::MakeIndexName(_MakeIndex(TEXT("a_b"), TEXT("c"))));
+		});
+
+		It("tells apart pairs split differently", [this]()
+		{
+			TestNotEqual(TEXT("a_b/c and a/b_c"), UNeo4jUtilities::MakeIndexName(_MakeIndex(TEXT("a_b"), TEXT("c"))),
+				UNeo4jUtilities::MakeIndexName(_MakeIndex(TEXT("a"), TEXT("b_c"))));
+		});
+
+		It("tells apart index types on the same property", [this]()
+		{
+			TestNotEqual(TEXT("range and unique"), UNeo4jUtilities::MakeIndexName(_MakeIndex(TEXT("Person"), TEXT("name"))),
+				UNeo4jUtilities::MakeIndexName(_MakeIndex(TEXT("Person"), TEXT("name"), ENeo4jIndexType::Unique)));
+		});
+	});
+}
+
+#endif
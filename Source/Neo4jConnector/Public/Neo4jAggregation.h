@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "Neo4jAggregation.generated.h"
+
+
+UENUM(BlueprintType)
+enum class ENeo4jAggregateFunction : uint8
+{
+	Count,
+	Sum,
+	Avg,
+	Min,
+	Max
+};
+
+UENUM(BlueprintType)
+enum class ENeo4jAggregateGrouping : uint8
+{
+	//a single row for every matched node
+	None,
+	//one row per label, nodes with several labels count towards each
+	Label,
+	//one row per distinct value of groupProperty
+	Property
+};
+
+//what to compute over the matched nodes, runs on the server
+USTRUCT(BlueprintType)
+struct FNeo4jAggregation
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		ENeo4jAggregateFunction function = ENeo4jAggregateFunction::Count;
+
+	//property the function reads. Count with an empty property counts nodes, otherwise nodes that have it
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		FString property;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		ENeo4jAggregateGrouping grouping = ENeo4jAggregateGrouping::None;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		FString groupProperty;
+
+};
+
+USTRUCT(BlueprintType)
+struct FNeo4jAggregateRow
+{
+	GENERATED_BODY()
+public:
+
+	//label or property value the row was grouped by, empty when ungrouped or the property was missing
+	UPROPERTY(BlueprintReadOnly)
+		FString group;
+
+	//float copy of value for Blueprint, which has no doubles
+	UPROPERTY(BlueprintReadOnly, meta = (DisplayName = "Value"))
+		float blueprintValue = 0.f;
+
+	//false when the function had nothing to work on, e.g. the average of no values
+	UPROPERTY(BlueprintReadOnly)
+		bool bHasValue = false;
+
+	//counts and sums beyond float precision stay exact
+	double value = 0.0;
+};
+
+USTRUCT(BlueprintType)
+struct FNeo4jAggregateResult
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(BlueprintReadOnly)
+		TArray<FNeo4jAggregateRow> rows;
+
+	//value of the first row, handy for ungrouped aggregations
+	double GetValue() const { return rows.Num() > 0 ? rows[0].value : 0.0; }
+
+};
@@ -0,0 +1,132 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/Queue.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Neo4jNode.h"
+
+
+//outcome of one client query
+struct FNeo4jClientResult
+{
+	//false on transport failures, http errors and cypher errors
+	bool bSucceeded = false;
+
+	int32 responseCode = 0;
+
+	//raw response body
+	FString content;
+
+	//filled when the query asked for nodes
+	TArray<FNeo4jNode> nodes;
+};
+
+typedef TFunction<void(FNeo4jClientResult& result)> FNeo4jClientCallback;
+
+//picks the base url of each query as it is sent, on the game thread. bReadOnly is what the query was submitted with,
+//so reads can go to a replica and writes to the writer. An empty url fails the query.
+//outOnResponse may be set to run on the game thread once that query's response arrives
+typedef TFunction<FString(bool bReadOnly, TFunction<void()>& outOnResponse)> FNeo4jClientRouter;
+
+
+/**
+* Native database client that can be used from any thread.
+* Queries go into a lock-free queue and are sent from the game thread, which is where UE4's http requests run.
+* Responses are parsed on the task graph and handed to the callback on the thread the caller picked,
+* or returned through a future. Nothing here touches UObjects, so no game thread marshalling is needed by callers.
+*/
+class NEO4JCONNECTOR_API FNeo4jClient : public TSharedFromThis<FNeo4jClient, ESPMode::ThreadSafe>
+{
+public:
+
+	//baseURL is http://ip:port, authorization the full Authorization header value. Can be called from any thread
+	static TSharedRef<FNeo4jClient, ESPMode::ThreadSafe> Create(const FString& baseURL, const FString& authorization, int32 maxRequestsInFlight = 32);
+
+	//routes every query through router instead of a fixed url
+	static TSharedRef<FNeo4jClient, ESPMode::ThreadSafe> Create(FNeo4jClientRouter router, const FString& authorization, int32 maxRequestsInFlight = 32);
+
+	static TSharedRef<FNeo4jClient, ESPMode::ThreadSafe> Create(const FString& IP, const FString& HTTPport, const FString& user,
+		const FString& pass, int32 maxRequestsInFlight = 32);
+
+	~FNeo4jClient();
+
+	//joins the strings into one statement like UNeo4jDatabase::QueryStrings. Thread safe.
+	//bReadOnly lets a routed client send the query to a reader, writes must leave it false
+	void Query(const TArray<FString>& queryStrings, bool bParseNodes, FNeo4jClientCallback onComplete,
+		ENamedThreads::Type completionThread = ENamedThreads::AnyBackgroundThreadNormalTask, bool bReadOnly = false);
+
+	TFuture<FNeo4jClientResult> Query(const TArray<FString>& queryStrings, bool bParseNodes, bool bReadOnly = false);
+
+	TFuture<FNeo4jClientResult> GetNodesByID(const TArray<int>& elementIDs);
+
+	TFuture<FNeo4jClientResult> GetNodesByLabels(const TArray<FString>& labels);
+
+	TFuture<FNeo4jClientResult> GetNeighbours(int nodeID, const TArray<FString>& relationTypes, ENeo4jDirection direction);
+
+	//queries waiting to be sent plus those in flight
+	int32 GetNumPending() const { return numPending.GetValue(); }
+
+	//stops sending. Queued queries complete as failed, queries in flight still complete normally
+	void Shutdown();
+
+private:
+
+	struct FSubmission
+	{
+		//utf-8 request body, built on the submitting thread
+		TArray<uint8> body;
+
+		bool bParseNodes = false;
+
+		bool bReadOnly = false;
+
+		FNeo4jClientCallback onComplete;
+
+		ENamedThreads::Type completionThread = ENamedThreads::AnyBackgroundThreadNormalTask;
+
+		//set instead of onComplete for future based queries
+		TSharedPtr<TPromise<FNeo4jClientResult>, ESPMode::ThreadSafe> promise;
+	};
+
+	typedef TSharedPtr<FSubmission, ESPMode::ThreadSafe> FSubmissionPtr;
+
+	FNeo4jClient(const FString& inBaseURL, FNeo4jClientRouter inRouter, const FString& inAuthorization, int32 inMaxRequestsInFlight);
+
+	static TSharedRef<FNeo4jClient, ESPMode::ThreadSafe> _Create(FNeo4jClient* client);
+
+	void _Submit(const TArray<FString>& queryStrings, FSubmissionPtr submission);
+
+	//game thread: sends queued queries while fewer than maxRequestsInFlight are outstanding
+	bool _Pump(float deltaTime);
+
+	//game thread: fails everything queued, once the client is shut down
+	void _Drain();
+
+	void _Send(FSubmissionPtr submission);
+
+	//parses on the task graph, then completes on the submission's thread
+	static void _Complete(FSubmissionPtr submission, FNeo4jClientResult&& result);
+
+	static void _Finish(FSubmissionPtr submission, FNeo4jClientResult& result);
+
+	const FString baseURL;
+	const FNeo4jClientRouter router;
+	const FString authorization;
+	const int32 maxRequestsInFlight;
+
+	//lock-free, any thread enqueues and only the game thread dequeues
+	TQueue<FSubmissionPtr, EQueueMode::Mpsc> submissions;
+
+	FThreadSafeCounter numPending;
+
+	//only touched on the game thread
+	int32 numInFlight = 0;
+	FDelegateHandle pumpHandle;
+
+	FThreadSafeBool bShutdown;
+};
@@ -6,10 +6,130 @@
 #include "Http.h"
 #include "UObject/NoExportTypes.h"
 #include "Neo4jNode.h"
+#include "Neo4jClient.h"
+#include "Neo4jEditableNode.h"
+#include "Neo4jEndpoint.h"
+#include "Neo4jFullText.h"
+#include "Neo4jMappedGraph.h"
+#include "Neo4jResultSet.h"
+#include "Neo4jSchema.h"
+#include "Neo4jSnapshot.h"
+#include "Neo4jQueryPlan.h"
+#include "Neo4jQueryTemplate.h"
+#include "Neo4jRequestOptions.h"
+#include "Neo4jSpatial.h"
+#include "Neo4jStructBinder.h"
 #include "Neo4jDatabase.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnRequestCompletedDelegate);
 
+//identifies which node output array a result set belongs to
+UENUM(BlueprintType)
+enum class ENeo4jResultSlot : uint8
+{
+	StringQuery,
+	GetNode,
+	GetNeighbours,
+	CreateNode,
+	UpdateNode,
+	MergeNode,
+	MAX UMETA(Hidden)
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnNodeDeliveredDelegate, ENeo4jResultSlot, slot, const FNeo4jNode&, node);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnDeliveryProgressDelegate, ENeo4jResultSlot, slot, int, delivered, int, total);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnRequestCancelledDelegate, int, requestID, const FString&, operation, bool, bTimedOut);
+
+//bookkeeping for a request that has been sent but not answered yet
+struct FNeo4jPendingRequest
+{
+	//name of the database function that issued the request
+	FString operation;
+
+	//cypher text as sent, for plan reports
+	FString query;
+
+	double startTime = 0.0;
+
+	bool bProfiled = false;
+
+	//index into the database's endpoints the request was routed to
+	int32 endpoint = INDEX_NONE;
+
+	//kept so the request can be cancelled
+	TSharedPtr<IHttpRequest, ESPMode::NotThreadSafe> request;
+
+	int32 requestID = 0;
+
+	FString supersedeKey;
+
+	//FPlatformTime::Seconds() the request is cancelled at, 0 for none
+	double deadline = 0.0;
+};
+
+//cancellation reported a tick late, see UNeo4jDatabase::_TrackRequest
+struct FNeo4jCancelledRequest
+{
+	int32 requestID = 0;
+
+	FString operation;
+
+	bool bTimedOut = false;
+};
+
+//changes taken from an editable node by a save that hasn't been answered yet
+struct FNeo4jPendingSave
+{
+	TWeakObjectPtr<UNeo4jEditableNode> node;
+
+	FNeo4jNodeChanges changes;
+};
+
+//a full-text search waiting out the debounce delay
+struct FNeo4jFullTextSearch
+{
+	FString index;
+
+	FString text;
+
+	ENeo4jFullTextMode mode = ENeo4jFullTextMode::AllPrefixes;
+
+	int offset = 0;
+
+	int limit = 0;
+};
+
+//a node result being handed out a slice per frame
+struct FNeo4jNodeDelivery
+{
+	ENeo4jResultSlot slot = ENeo4jResultSlot::StringQuery;
+
+	int32 nextRow = 0;
+
+	int32 numRows = 0;
+
+	//tells a delivery apart from a newer one for the same slot
+	uint32 serial = 0;
+};
+
+//routing bookkeeping for one configured endpoint
+struct FNeo4jEndpointState
+{
+	FNeo4jEndpoint endpoint;
+
+	//http://ip:port
+	FString baseURL;
+
+	int outstandingRequests = 0;
+
+	int consecutiveFailures = 0;
+
+	bool bHealthy = true;
+
+	//unhealthy endpoints are probed again once this time has passed
+	double nextProbeTime = 0.0;
+};
+
 /**
 * An abstraction of a neo4j database. This is the main class through which queries can be processed.
 * Database must first be initialized.
@@ -42,6 +162,63 @@ public:
 	UPROPERTY(BlueprintAssignable)
 		FOnRequestCompletedDelegate OnCreateNodeCompleteDelegate;
 
+	UPROPERTY(BlueprintAssignable, meta = (Tooltip = "Delegate fires when a projected query completes"))
+		FOnRequestCompletedDelegate OnProjectedQueryCompleteDelegate;
+
+	UPROPERTY(BlueprintAssignable, meta = (Tooltip = "Delegate fires when a sync has been applied to the sync view"))
+		FOnRequestCompletedDelegate OnSyncCompleteDelegate;
+
+	UPROPERTY(BlueprintAssignable, meta = (Tooltip = "Delegate fires when an index/constraint change or index listing completes"))
+		FOnRequestCompletedDelegate OnIndexQueryCompleteDelegate;
+
+	UPROPERTY(BlueprintAssignable, meta = (Tooltip = "Delegate fires when an EXPLAIN/PROFILE plan has been captured into lastQueryPlan"))
+		FOnRequestCompletedDelegate OnQueryPlanCapturedDelegate;
+
+	UPROPERTY(BlueprintAssignable, meta = (Tooltip = "Delegate fires when a query template execution completes"))
+		FOnRequestCompletedDelegate OnTemplateQueryCompleteDelegate;
+
+	UPROPERTY(BlueprintAssignable, meta = (Tooltip = "Delegate fires when GetSubgraphByLabels completes"))
+		FOnRequestCompletedDelegate OnSubgraphQueryCompleteDelegate;
+
+	UPROPERTY(BlueprintAssignable, meta = (Tooltip = "Delegate fires when LoadSnapshotAsync finishes, check bSnapshotLoaded"))
+		FOnRequestCompletedDelegate OnSnapshotLoadedDelegate;
+
+	UPROPERTY(BlueprintAssignable, meta = (Tooltip = "Delegate fires when ValidateSnapshot has compared the snapshot against the server, check snapshotState"))
+		FOnRequestCompletedDelegate OnSnapshotValidatedDelegate;
+
+	UPROPERTY(BlueprintAssignable, meta = (Tooltip = "Delegate fires when ExportMappedGraphByLabels has written its file or given up, check bMappedGraphExported"))
+		FOnRequestCompletedDelegate OnMappedGraphExportedDelegate;
+
+	UPROPERTY(BlueprintAssignable, meta = (Tooltip = "Delegate fires when a shortest path query completes"))
+		FOnRequestCompletedDelegate OnPathQueryCompleteDelegate;
+
+	UPROPERTY(BlueprintAssignable, meta = (Tooltip = "Delegate fires when a full-text search completes, check fullTextQueryOutput.text"))
+		FOnRequestCompletedDelegate OnFullTextQueryCompleteDelegate;
+
+	UPROPERTY(BlueprintAssignable, meta = (Tooltip = "Delegate fires when a radius, box or nearest query completes"))
+		FOnRequestCompletedDelegate OnSpatialQueryCompleteDelegate;
+
+	UPROPERTY(BlueprintAssignable, meta = (Tooltip = "Delegate fires when InitializeDatabaseAsync finishes or times out, check bDatabaseReady"))
+		FOnRequestCompletedDelegate OnDatabaseInitializedDelegate;
+
+	UPROPERTY(BlueprintAssignable, meta = (Tooltip = "Delegate fires when GetNeighboursBatch completes"))
+		FOnRequestCompletedDelegate OnNeighbourBatchCompleteDelegate;
+
+	UPROPERTY(BlueprintAssignable, meta = (Tooltip = "Delegate fires when an aggregate query completes"))
+		FOnRequestCompletedDelegate OnAggregateQueryCompleteDelegate;
+
+	UPROPERTY(BlueprintAssignable, meta = (Tooltip = "Delegate fires when SaveChanges completes, check bLastSaveSucceeded"))
+		FOnRequestCompletedDelegate OnSaveChangesCompleteDelegate;
+
+	UPROPERTY(BlueprintAssignable, meta = (Tooltip = "Delegate fires when a request was cancelled, superseded or missed its deadline. Its complete delegate won't fire. Superseded requests are reported on the next tick"))
+		FOnRequestCancelledDelegate OnRequestCancelledDelegate;
+
+	UPROPERTY(BlueprintAssignable, meta = (Tooltip = "Delegate fires once per result row while bSliceNodeDelivery is on"))
+		FOnNodeDeliveredDelegate OnNodeDeliveredDelegate;
+
+	UPROPERTY(BlueprintAssignable, meta = (Tooltip = "Delegate fires after every delivered slice with the rows delivered so far"))
+		FOnDeliveryProgressDelegate OnDeliveryProgressDelegate;
+
 
 	//RELATION DELEGATES
 
@@ -51,6 +228,28 @@ public:
 
 #pragma region OUTPUT_ARRAYS
 
+	//id of the most recently sent request, for CancelRequest
+	UPROPERTY(BlueprintReadOnly)
+		int lastRequestID = 0;
+
+	//set by InitializeDatabaseAsync once credentials were accepted and the schema catalog was fetched
+	UPROPERTY(BlueprintReadOnly)
+		bool bDatabaseReady = false;
+
+	//why the last async initialization failed, empty if it succeeded
+	UPROPERTY(BlueprintReadOnly)
+		FString initializeError;
+
+	//schema catalog fetched by InitializeDatabaseAsync
+	UPROPERTY(BlueprintReadOnly)
+		TArray<FString> knownLabels;
+
+	UPROPERTY(BlueprintReadOnly)
+		TArray<FString> knownRelationshipTypes;
+
+	UPROPERTY(BlueprintReadOnly)
+		TArray<FString> knownPropertyKeys;
+
 	//query outputs will be written to this variable
 	UPROPERTY(BlueprintReadWrite)
 		TArray<FNeo4jNode> stringQueryOutput;
@@ -63,6 +262,10 @@ public:
 	UPROPERTY(BlueprintReadWrite)
 		TArray<FNeo4jNode> getNeighboursQueryOutput;
 
+	//neighbours per source node from GetNeighboursBatch
+	UPROPERTY(BlueprintReadOnly)
+		TMap<int, FNeo4jNeighbourList> neighbourBatchQueryOutput;
+
 	UPROPERTY(BlueprintReadWrite)
 		TArray<FNeo4jNode> createNodeQueryOutput;
 
@@ -72,6 +275,73 @@ public:
 	UPROPERTY(BlueprintReadWrite)
 		TArray<FNeo4jNode> mergeNodeQueryOutput;
 
+	UPROPERTY(BlueprintReadWrite)
+		FNeo4jProjectedResult projectedQueryOutput;
+
+	//rows returned by the aggregate functions, one per group
+	UPROPERTY(BlueprintReadOnly)
+		FNeo4jAggregateResult aggregateQueryOutput;
+
+	//local copy of the nodes with the synced labels, kept current by Sync. Relationships are not synced
+	UPROPERTY(BlueprintReadWrite)
+		FNeo4jSyncView syncView;
+
+	//ids the last sync added/updated or removed from the sync view. Removed covers deleted nodes and nodes that lost
+	//a synced label. A reused id can be in both lists, the changed node is the one in the view
+	UPROPERTY(BlueprintReadOnly)
+		TArray<int> lastSyncChangedIDs;
+
+	UPROPERTY(BlueprintReadOnly)
+		TArray<int> lastSyncDeletedIDs;
+
+	//filled by ListIndexes
+	UPROPERTY(BlueprintReadOnly)
+		TArray<FNeo4jIndexInfo> indexQueryOutput;
+
+	UPROPERTY(BlueprintReadOnly)
+		FNeo4jQueryPlan lastQueryPlan;
+
+	UPROPERTY(BlueprintReadWrite)
+		TArray<FNeo4jNode> templateQueryOutput;
+
+	//nodes and relationships fetched by GetSubgraphByLabels, ready to pass to UNeo4jSnapshot::SaveSnapshot
+	UPROPERTY(BlueprintReadOnly)
+		FNeo4jSubgraph subgraphQueryOutput;
+
+	//filled by LoadSnapshotAsync
+	UPROPERTY(BlueprintReadOnly)
+		FNeo4jSubgraph snapshotOutput;
+
+	UPROPERTY(BlueprintReadOnly)
+		bool bSnapshotLoaded = false;
+
+	UPROPERTY(BlueprintReadOnly)
+		bool bMappedGraphExported = false;
+
+	//set by ValidateSnapshot, only true when snapshotState is Current
+	UPROPERTY(BlueprintReadOnly)
+		bool bSnapshotCurrent = false;
+
+	//set by ValidateSnapshot. Unknown while both clocks are 0, unstamped writes can't be told apart from none
+	UPROPERTY(BlueprintReadOnly)
+		ENeo4jSnapshotState snapshotState = ENeo4jSnapshotState::Unknown;
+
+	//paths found by ShortestPath/AllShortestPaths, empty if the nodes aren't connected
+	UPROPERTY(BlueprintReadOnly)
+		TArray<FNeo4jPath> pathQueryOutput;
+
+	//latest page of full-text matches
+	UPROPERTY(BlueprintReadOnly)
+		FNeo4jFullTextResult fullTextQueryOutput;
+
+	//nodes found by the spatial queries, nearest first except for box queries
+	UPROPERTY(BlueprintReadOnly)
+		TArray<FNeo4jSpatialMatch> spatialQueryOutput;
+
+	//false if the last SaveChanges failed, its nodes are dirty again
+	UPROPERTY(BlueprintReadOnly)
+		bool bLastSaveSucceeded = false;
+
 
 	//returning from relation functions
 
@@ -81,10 +351,144 @@ public:
 #pragma endregion OUTPUT_ARRAYS
 
 
+#pragma region SETTINGS
+
+	//asks the server for gzip/deflate encoded responses and inflates them before parsing
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Neo4j|Compression")
+		bool bAcceptCompressedResponses = false;
+
+	//request bodies larger than this many bytes are gzipped before sending. 0 disables request compression
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Neo4j|Compression")
+		int compressRequestsAboveBytes = 0;
+
+	//compressed responses that inflate to more than this many bytes are dropped instead of parsed
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Neo4j|Compression")
+		int maxDecompressedResponseBytes = 256 * 1024 * 1024;
+
+	//node responses are parsed into pooled result sets instead of the output arrays. Read them with GetResultSet
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Neo4j|Memory")
+		bool bUseResultSets = false;
+
+	//writes stamp a server side change marker on every node/relation they touch and leave tombstones for deletes.
+	//Required for Sync to pick up changes
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Neo4j|Sync")
+		bool bStampChangeMarkers = false;
+
+	//indexes the workload relies on. Created by EnsureIndexes
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Neo4j|Schema")
+		TArray<FNeo4jIndexDefinition> declaredSchema;
+
+	//full-text indexes the workload relies on. Created by EnsureIndexes
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Neo4j|Schema")
+		TArray<FNeo4jFullTextIndexDefinition> declaredFullTextIndexes;
+
+	//runs EnsureIndexes at the end of InitializeDatabase
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Neo4j|Schema")
+		bool bEnsureIndexesOnInitialize = false;
+
+	//prefixes every query with EXPLAIN or PROFILE and captures the returned plan. Explained queries return no rows
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Neo4j|Profiling")
+		ENeo4jProfileMode profileMode = ENeo4jProfileMode::None;
+
+	//how many of the slowest plans are kept per operation
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Neo4j|Profiling")
+		int maxPlansPerOperation = 5;
+
+	//failed requests or probes in a row before an endpoint stops getting traffic
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Neo4j|Routing")
+		int failuresBeforeUnhealthy = 2;
+
+	//how long an unhealthy endpoint is left alone before it is probed again
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Neo4j|Routing")
+		float unhealthyRetrySeconds = 5.f;
+
+	//node results are handed to OnNodeDeliveredDelegate a slice per frame, the query's complete delegate fires
+	//after the last row. The output arrays are still filled up front
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Neo4j|Delivery")
+		bool bSliceNodeDelivery = false;
+
+	//time per frame spent delivering rows, shared by every pending delivery. At least one row goes out per frame
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Neo4j|Delivery")
+		float deliveryBudgetMs = 2.f;
+
+	//connections InitializeDatabaseAsync opens to every endpoint up front, so the first queries don't pay for the handshake
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Neo4j|Warmup")
+		int warmupConnections = 4;
+
+	//queries InitializeDatabaseAsync has every endpoint EXPLAIN so their plans are cached before they are first run.
+	//Each is sent on its own, one that doesn't plan only costs a warning
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Neo4j|Warmup")
+		TArray<FString> warmupQueries;
+
+	//InitializeDatabaseAsync gives up and reports failure after this long
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Neo4j|Warmup")
+		float initializeTimeoutSeconds = 10.f;
+
+	//seconds until a request without its own timeout is cancelled. 0 lets requests run until the http timeout
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Neo4j|Timeouts")
+		float requestTimeoutSeconds = 0.f;
+
+	//also sends the timeout as the transaction's max-execution-time, so the server stops work nobody waits for anymore
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Neo4j|Timeouts")
+		bool bServerSideTimeouts = true;
+
+	//SearchFullTextDebounced waits this long after the last call before sending
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Neo4j|Search")
+		float fullTextDebounceSeconds = 0.25f;
+
+#pragma endregion SETTINGS
+
+
 private:
-	FString URL;
 	FString b64Auth;
 
+	TArray<FNeo4jEndpointState> endpoints;
+
+	//where the next reader scan starts, so equally loaded readers take turns
+	int32 nextReader = 0;
+
+	//oldest first, only the front one is delivered until it finishes
+	TArray<FNeo4jNodeDelivery> deliveries;
+	uint32 nextDeliverySerial = 0;
+	FDelegateHandle deliveryTickerHandle;
+
+	FNeo4jResultSetPool resultSetPool;
+
+	//async initialization, responses carrying an older serial are ignored
+	uint32 initializeSerial = 0;
+	int32 pendingInitializeSteps = 0;
+	bool bCredentialsVerified = false;
+	bool bCatalogFetched = false;
+	FDelegateHandle initializeTimeoutHandle;
+
+	TMap<const IHttpRequest*, FNeo4jPendingRequest> pendingRequests;
+
+	//used up by the next tracked request
+	FNeo4jRequestOptions nextRequestOptions;
+	int32 nextRequestID = 0;
+	FDelegateHandle deadlineTickerHandle;
+
+	//cancellations of superseded requests waiting to be broadcast
+	TArray<FNeo4jCancelledRequest> deferredCancellations;
+	FDelegateHandle cancelBroadcastHandle;
+
+	FNeo4jFullTextSearch debouncedSearch;
+	FDelegateHandle fullTextDebounceHandle;
+
+	//request bodies are written here and then moved into the http request, so the body is never copied
+	TArray<uint8> requestBody;
+
+	TMap<const IHttpRequest*, TArray<FNeo4jPendingSave>> pendingSaves;
+
+	TMap<FString, FNeo4jQueryTemplate> queryTemplates;
+
+	//pages of the running ExportMappedGraphByLabels, null when none is running
+	TSharedPtr<FNeo4jMappedGraphBuilder> mappedGraphBuilder;
+
+	//slowest captured plans per operation, slowest first
+	TMap<FString, TArray<FNeo4jQueryPlan>> slowestPlans;
+	TSharedPtr<FNeo4jResultSet> resultSets[(int)ENeo4jResultSlot::MAX];
+
 public:
 
 #pragma region GENERAL_FUNCTIONS
@@ -92,16 +496,93 @@ public:
 	//same functionality as QueryStrings but we can override the delegate function
 	void QueryStrings(TArray<FString> inStrings, TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> HttpRequest);
 
+	//native client using this database's credentials. Each query is routed when it is sent, to a healthy writer or, if it
+	//was submitted as read only, a reader, like the database's own requests. Usable from any thread
+	TSharedRef<FNeo4jClient, ESPMode::ThreadSafe> CreateThreadSafeClient();
+
 	UFUNCTION(BlueprintCallable, Category = "Neo4j")
 		void InitializeDatabase(FString IP, FString HTTPport, FString user, FString pass);
 
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Connects to several servers. Writes go to the writer, read-only operations are spread over healthy readers. Replicas may lag behind the writer"))
+		void InitializeCluster(TArray<FNeo4jEndpoint> clusterEndpoints, FString user, FString pass);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Initializes, then opens warm-up connections, verifies credentials, fetches the schema catalog and primes warmupQueries in the background. Fires OnDatabaseInitializedDelegate when done"))
+		void InitializeDatabaseAsync(FString IP, FString HTTPport, FString user, FString pass);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "InitializeDatabaseAsync for a cluster, every endpoint is warmed up"))
+		void InitializeClusterAsync(TArray<FNeo4jEndpoint> clusterEndpoints, FString user, FString pass);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Probes every endpoint now instead of waiting for failed requests"))
+		void CheckEndpointHealth();
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j")
+		TArray<FNeo4jEndpointStatus> GetEndpointStatus() const;
+
 	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Posts array of strings as seperate queries"))
 		void QueryStrings(TArray<FString> queries);
 
 
 
+	//result set of the last response written to slot, invalid unless bUseResultSets is on
+	TSharedPtr<const FNeo4jResultSet> GetResultSet(ENeo4jResultSlot slot) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Copies a result set out into nodes"))
+		TArray<FNeo4jNode> GetResultSetNodes(ENeo4jResultSlot slot) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Frees the result set and output array of a slot"))
+		void ReleaseResults(ENeo4jResultSlot slot);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Frees every result set and output array. Pooled buffers are kept unless bTrimPool is set"))
+		void ReleaseAllResults(bool bTrimPool);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Returns the slowest captured plans of an operation, slowest first"))
+		TArray<FNeo4jQueryPlan> GetSlowestPlans(FString operation) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Logs the slowest captured plans of every operation with their operator trees"))
+		void LogSlowestPlans();
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j")
+		void ClearQueryPlans();
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Stops handing out rows of a slot. Its complete delegate won't fire"))
+		void CancelDelivery(ENeo4jResultSlot slot);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Supersede key and timeout for the next request sent, they apply to that request only"))
+		void SetNextRequestOptions(FNeo4jRequestOptions options);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Aborts a request by its id, see lastRequestID. Its response isn't parsed and its complete delegate won't fire. Returns false if it already completed"))
+		bool CancelRequest(int requestID);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Aborts every request sent with this supersede key, returns how many were cancelled"))
+		int CancelRequestsByKey(FString supersedeKey);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Aborts every request in flight, returns how many were cancelled"))
+		int CancelAllRequests();
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j")
+		int GetNumPendingRequests() const;
+
+	virtual void BeginDestroy() override;
+
 #pragma endregion GENERAL_FUNCTIONS
 
+
+#pragma region TEMPLATE_FUNCTIONS
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Registers a named query using $parameters. Returns false if the name is taken"))
+		bool RegisterQueryTemplate(FString name, FString statement, TArray<FNeo4jParameterDeclaration> parameters);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j")
+		void UnregisterQueryTemplate(FString name);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Runs a registered query template. Results are written to templateQueryOutput"))
+		void ExecuteQueryTemplate(FString name, const FNeo4jQueryParameters& parameters);
+
+	//same as above but we can override the delegate function
+	bool ExecuteQueryTemplate(const FString& name, const FNeo4jQueryParameters& parameters, TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> httpRequest);
+
+#pragma endregion TEMPLATE_FUNCTIONS
+
 #pragma region NODE_FUNCTIONS
 
 	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Adds node to graph database then returns node. Maps the property name to the property value"))
@@ -156,9 +637,44 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Gets a list of relationships containing the input relation types going into input node"))
 		void GetIncomingNeighboursByTypes(int nodeID, TArray<FString> relationTypes);
 
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Gets the neighbours of many nodes in one query, grouped per source node. Empty relation types matches any type"))
+		void GetNeighboursBatch(TArray<int> nodeIDs, TArray<FString> relationTypes, ENeo4jDirection direction);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Writes only what changed on the input nodes in a single statement. Nodes without changes are skipped"))
+		void SaveChanges(TArray<UNeo4jEditableNode*> nodes);
+
 #pragma endregion NODE_FUNCTIONS
 
 
+#pragma region PROJECTION_FUNCTIONS
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Retrieves only the projected properties of nodes by their IDs"))
+		void GetNodesByIDProjected(TArray<int> elementIDs, FNeo4jProjection projection);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Retrieves only the projected properties of all nodes matching the input labels"))
+		void GetNodesByLabelsProjected(TArray<FString> Labels, FNeo4jProjection projection);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Retrieves only the projected properties of a node's neighbours. Empty relation types matches any type"))
+		void GetNeighboursProjected(int nodeID, TArray<FString> relationTypes, ENeo4jDirection direction, FNeo4jProjection projection);
+
+#pragma endregion PROJECTION_FUNCTIONS
+
+
+#pragma region AGGREGATE_FUNCTIONS
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Aggregates over every node with the input labels on the server and returns only the result rows"))
+		void AggregateByLabels(TArray<FString> labels, FNeo4jAggregation aggregation);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Aggregates over the nodes with the input labels whose properties match the input values"))
+		void AggregateByProperties(TArray<FString> labels, TMap<FString, FString> stringProperties, TMap<FString, int> intProperties,
+			TMap<FString, bool> boolProperties, FNeo4jAggregation aggregation);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Aggregates over a node's neighbours, each neighbour counted once. Empty relation types matches any type"))
+		void AggregateNeighbours(int nodeID, TArray<FString> relationTypes, ENeo4jDirection direction, FNeo4jAggregation aggregation);
+
+#pragma endregion AGGREGATE_FUNCTIONS
+
+
 #pragma region RELATION_FUNCTIONS
 
 	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Adds relationships from root node to other nodes. Other nodes denoted by node ID"))
@@ -173,14 +689,265 @@ public:
 #pragma endregion RELATION_FUNCTIONS
 
 
+#pragma region SCHEMA_FUNCTIONS
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Creates a range index or uniqueness constraint on label.property if it doesn't exist yet"))
+		void CreateIndex(FString label, FString property, ENeo4jIndexType type);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Lists every index on the server into indexQueryOutput"))
+		void ListIndexes();
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Drops an index by name. Indexes backing a constraint are removed by dropping the constraint"))
+		void DropIndex(FString name, bool bIsConstraint);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Creates every index in the declared schema that doesn't exist yet, in one request. With bStampChangeMarkers also the sync clock constraint and marker indexes"))
+		void EnsureIndexes();
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Creates a full-text index over string properties of nodes with any of the labels if it doesn't exist yet"))
+		void CreateFullTextIndex(FString name, TArray<FString> labels, TArray<FString> properties);
+
+#pragma endregion SCHEMA_FUNCTIONS
+
+
+#pragma region SEARCH_FUNCTIONS
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Searches a full-text index, best matches first. Returns limit matches starting at offset into fullTextQueryOutput, limit <= 0 returns all"))
+		void SearchFullText(FString index, FString text, ENeo4jFullTextMode mode, int offset, int limit);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "SearchFullText for typing. Waits fullTextDebounceSeconds for the text to settle and cancels the search in flight, so only the latest text is ever searched"))
+		void SearchFullTextDebounced(FString index, FString text, ENeo4jFullTextMode mode, int offset, int limit);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Drops a waiting debounced search and cancels the one in flight"))
+		void CancelFullTextSearch();
+
+#pragma endregion SEARCH_FUNCTIONS
+
+
+#pragma region SYNC_FUNCTIONS
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Loads every node with the input labels into the sync view. Later Sync calls only fetch what changed"))
+		void StartSync(TArray<FString> labels);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Fetches nodes changed, deleted or no longer labelled since the sync view's marker and applies them"))
+		void Sync();
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Fetches nodes changed or deleted since the input marker and applies them to the sync view"))
+		void SyncSince(int64 marker);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Deletes tombstones older than the input marker. Only purge markers every client has synced past"))
+		void PurgeTombstones(int64 olderThanMarker);
+
+#pragma endregion SYNC_FUNCTIONS
+
+
+#pragma region SNAPSHOT_FUNCTIONS
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Fetches every node with the input labels and the relationships between them into subgraphQueryOutput, tagged with the current sync clock"))
+		void GetSubgraphByLabels(TArray<FString> labels);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Reads a snapshot file off the game thread into snapshotOutput. Optionally validates it against the server once loaded"))
+		void LoadSnapshotAsync(FString filePath, bool bValidateAfterLoad);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Compares snapshotOutput's data version with the server's sync clock. Needs bStampChangeMarkers on every writer"))
+		void ValidateSnapshot();
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Seeds the sync view with snapshotOutput so the next Sync only fetches changes made after the snapshot"))
+		void ApplySnapshotToSyncView(TArray<FString> labels);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Writes every node with the input labels and the relationships between them to a mapped graph file, fetched pageSize nodes at a time so the whole graph is never held as nodes. Tagged with the sync clock read before the first page"))
+		void ExportMappedGraphByLabels(TArray<FString> labels, FString filePath, int pageSize = 10000);
+
+#pragma endregion SNAPSHOT_FUNCTIONS
+
+
+#pragma region PATH_FUNCTIONS
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Finds one shortest path between two nodes in a single query. maxDepth <= 0 means unbounded, empty relationTypes matches any type. The same node twice gives a path of just that node"))
+		void ShortestPath(int startNodeID, int endNodeID, TArray<FString> relationTypes, ENeo4jDirection direction, int maxDepth);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Finds every shortest path between two nodes in a single query. maxDepth <= 0 means unbounded, empty relationTypes matches any type. The same node twice gives a path of just that node"))
+		void AllShortestPaths(int startNodeID, int endNodeID, TArray<FString> relationTypes, ENeo4jDirection direction, int maxDepth);
+
+#pragma endregion PATH_FUNCTIONS
+
+
+#pragma region SPATIAL_FUNCTIONS
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "CreateNode that can also set float and point properties"))
+		void CreateNodeWithSpatialProperties(TArray<FString> labels, TMap<FString, FString> stringProperties, TMap<FString, int> intProperties,
+			TMap<FString, bool> boolProperties, TMap<FString, float> floatProperties, TMap<FString, FNeo4jPoint> pointProperties);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Finds elements by ID then sets float and point properties"))
+		void AddSpatialPropertiesToNodes(TArray<int> elementIDs, TMap<FString, float> floatProperties, TMap<FString, FNeo4jPoint> pointProperties);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Finds nodes of a label whose point property is within radius of center, nearest first. Declare a Point index on (label, property) so the server doesn't scan the label"))
+		void GetNodesWithinRadius(FString label, FString property, FNeo4jPoint center, float radius);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Finds nodes of a label whose point property lies inside the box spanned by two corners. Uses a Point index on (label, property)"))
+		void GetNodesWithinBox(FString label, FString property, FNeo4jPoint corner, FNeo4jPoint oppositeCorner);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4j", meta = (Tooltip = "Finds the count nodes nearest to center within maxRadius. maxRadius must be > 0, it is what lets the server use a Point index instead of scanning the whole label"))
+		void GetNearestNodes(FString label, FString property, FNeo4jPoint center, int count, float maxRadius);
+
+#pragma endregion SPATIAL_FUNCTIONS
+
+
+#pragma region STRUCT_FUNCTIONS
+
+	//typed node queries for USTRUCTs, fields map to node properties through FNeo4jStructBinder.
+	//Results go to onComplete instead of the output arrays. onComplete isn't called for cancelled requests
+
+	//creates one node per struct in a single request. created holds the stored structs with their ids filled in
+	template<typename TStruct>
+	void CreateNodes(const TArray<FString>& labels, const TArray<TStruct>& structs,
+		TFunction<void(bool bSucceeded, TArray<TStruct>& created)> onComplete = nullptr)
+	{
+		_CreateStructNodes(labels, FNeo4jStructBinder::Get<TStruct>(), structs.GetData(), structs.Num(), sizeof(TStruct),
+			_MakeStructCallback<TStruct>(MoveTemp(onComplete)));
+	}
+
+	template<typename TStruct>
+	void GetNodesByID(const TArray<int>& elementIDs, TFunction<void(bool bSucceeded, TArray<TStruct>& nodes)> onComplete)
+	{
+		_GetStructNodesByID(elementIDs, _MakeStructCallback<TStruct>(MoveTemp(onComplete)));
+	}
+
+	template<typename TStruct>
+	void GetNodesByLabels(const TArray<FString>& labels, TFunction<void(bool bSucceeded, TArray<TStruct>& nodes)> onComplete)
+	{
+		_GetStructNodesByLabels(labels, _MakeStructCallback<TStruct>(MoveTemp(onComplete)));
+	}
+
+#pragma endregion STRUCT_FUNCTIONS
+
+
 private:
 
+	//drives routing and probing directly against stub endpoints
+	friend class FNeo4jEndpointRoutingSpec;
+
 
 #pragma region HELPERS
 
 
-	//sends string to neo4j as a query.
-	void _SendQuery(FString query, TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> httpRequest);
+	//joins the strings into one statement and sends it, tagged with the issuing operation.
+	//bReadOnly lets the request go to a reader, bRowsOnly skips the meta column for results parsed from rows alone
+	void _QueryStrings(const TArray<FString>& inStrings, TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> httpRequest, const FString& operation,
+		bool bReadOnly = false, bool bRowsOnly = false);
+
+	//same as _QueryStrings for a statement that takes parameters
+	void _QueryWithParameters(const TArray<FString>& inStrings, const TArray<uint8>& parameters, TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> httpRequest,
+		const FString& operation, bool bReadOnly = false);
+
+	//sends each string as a separate statement of one transaction, schema changes can't share a statement
+	void _SendStatements(const TArray<FString>& statements, TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> httpRequest,
+		const FString& operation, bool bReadOnly = false);
+
+	//records the request as pending until its response is read and points it at an endpoint
+	void _TrackRequest(TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> httpRequest, const FString& operation, const FString& query,
+		bool bProfiled, bool bReadOnly = false);
+
+	//sends a body straight to one endpoint, bypassing routing and request tracking. Takes a copy, warm-up sends the same bodies to every endpoint
+	void _SendToEndpoint(int32 index, TArray<uint8> body, TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> httpRequest);
+
+	//aborts a tracked request without parsing it, puts back the changes of a cancelled save.
+	//bDeferBroadcast reports it on the next tick instead of from inside the caller
+	bool _CancelPendingRequest(const IHttpRequest* key, bool bTimedOut, bool bDeferBroadcast = false);
+
+	bool _BroadcastDeferredCancellations(float deltaTime);
+
+	bool _TickDeadlines(float deltaTime);
+
+	bool _OnFullTextDebounce(float deltaTime);
+
+	//one async initialization step answered
+	void _CompleteInitializeStep();
+
+	void _FinishInitialize(bool bSucceeded, const FString& error);
+
+	bool _OnInitializeTimeout(float deltaTime, uint32 serial);
+
+	//least loaded healthy reader for reads, the writer otherwise. INDEX_NONE if nothing is configured
+	int32 _PickEndpoint(bool bReadOnly);
+
+	void _ProbeEndpoint(int32 index);
+
+	//counts failures towards marking the endpoint unhealthy, a success makes it healthy again
+	void _ReportEndpointResult(int32 index, bool bSucceeded);
+
+	//untracks the request and returns its body. Returns false if there is nothing to parse
+	bool _ReadResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, FString& outContent);
+
+	void _CapturePlan(const FNeo4jPendingRequest& pending, const FString& content);
+
+	//sends a utf-8 request body to neo4j. The request takes ownership of body
+	void _SendQuery(TArray<uint8>&& body, TSharedRef<IHttpRequest, ESPMode::NotThreadSafe> httpRequest);
+
+	//returns the response body as a string, inflating it first if the server compressed it
+	FString _GetResponseContent(FHttpResponsePtr Response) const;
+
+	//adds the change marker stamp for variable to a write query
+	void _AppendChangeMarker(TArray<FString>& queryArray, const FString& variable) const;
+
+	//adds tombstones for variable and its relationships to a delete query, must come before the delete
+	void _AppendTombstone(TArray<FString>& queryArray, const FString& variable) const;
+
+	//records the labels a write removed from variable, must come after _AppendChangeMarker
+	void _AppendLabelRemoval(TArray<FString>& queryArray, const FString& variable, const FString& removedLabelsExpression) const;
+
+	//creates the clock key constraint and the marker indexes the sync view's labels need, if stamping is on
+	void _EnsureSyncIndexes();
+
+	//writes a node response into slot's result set or output array depending on bUseResultSets
+	void _StoreNodeResult(const FString& content, ENeo4jResultSlot slot);
+
+	TArray<FNeo4jNode>& _GetOutputArray(ENeo4jResultSlot slot);
+
+	FOnRequestCompletedDelegate& _GetCompleteDelegate(ENeo4jResultSlot slot);
+
+	//broadcasts the slot's complete delegate now, or queues its rows for sliced delivery
+	void _DeliverNodeResult(ENeo4jResultSlot slot);
+
+	int32 _GetNumResultRows(ENeo4jResultSlot slot);
+
+	FNeo4jNode _GetResultRow(ENeo4jResultSlot slot, int32 row);
+
+	bool _TickDeliveries(float deltaTime);
+
+	//match over label filtered by whereClause, returning [id, labels, properties, distanceExpression] rows.
+	//rows are ordered by distance unless distanceExpression is null, limit <= 0 returns them all
+	void _QuerySpatial(const FString& label, const FString& whereClause, const FString& distanceExpression, int limit, const FString& operation);
+
+	//parses the raw response of a struct query into TStruct rows for onComplete
+	template<typename TStruct>
+	static TFunction<void(bool, const FString&)> _MakeStructCallback(TFunction<void(bool, TArray<TStruct>&)> onComplete)
+	{
+		return [onComplete](bool bSucceeded, const FString& content)
+		{
+			TArray<TStruct> structs;
+			if (bSucceeded && !content.IsEmpty())
+				bSucceeded = FNeo4jStructBinder::Get<TStruct>().ParseQueryResult(content, structs);
+
+			if (onComplete)
+				onComplete(bSucceeded, structs);
+		};
+	}
+
+	//unwinds the structs, written straight from their memory, into one create
+	void _CreateStructNodes(const TArray<FString>& labels, const FNeo4jStructBinder& binder, const void* structs, int32 num, int32 stride,
+		TFunction<void(bool, const FString&)> onResponse);
+
+	void _GetStructNodesByID(const TArray<int>& elementIDs, TFunction<void(bool, const FString&)> onResponse);
+
+	void _GetStructNodesByLabels(const TArray<FString>& labels, TFunction<void(bool, const FString&)> onResponse);
+
+	void _QueryPaths(const FString& pathFunction, int startNodeID, int endNodeID, const TArray<FString>& relationTypes,
+		ENeo4jDirection direction, int maxDepth);
+
+	//next page of ExportMappedGraphByLabels: nodes with ids above afterID, their outgoing relationships and the clock
+	void _RequestMappedGraphPage(const TArray<FString>& labels, const FString& filePath, int pageSize, int afterID);
+
+	void _FinishMappedGraphExport(bool bExported);
 
 
 #pragma endregion HELPERS
@@ -202,6 +969,45 @@ private:
 
 	void _OnGetNeighbour(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
 
+	void _OnNeighbourBatch(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
+
+	void _OnProjectedQuery(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
+
+	void _OnAggregateQuery(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
+
+	void _OnSync(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
+
+	void _OnIndexQuery(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, bool bIsListing);
+
+	void _OnTemplateQuery(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
+
+	void _OnSubgraphQuery(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
+
+	void _OnValidateSnapshot(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
+
+	void _OnMappedGraphPage(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, TArray<FString> labels, FString filePath, int pageSize);
+
+	void _OnPathQuery(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
+
+	void _OnSaveChanges(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
+
+	void _OnEndpointProbe(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, FString baseURL);
+
+	void _OnWarmupConnection(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, uint32 serial, int32 endpoint);
+
+	void _OnWarmupQuery(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, uint32 serial, int32 endpoint, FString query);
+
+	void _OnSpatialQuery(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
+
+	void _OnStructQuery(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, TFunction<void(bool, const FString&)> onResponse);
+
+	void _OnFullTextQuery(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, FString text, int offset, int limit);
+
+	void _OnSchemaCatalog(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, uint32 serial);
+
+	//bound to requests sent without a callback so they still get untracked
+	void _OnUntrackedResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
+
 #pragma endregion NODE_DELEGATE_FUNCTIONS
 
 
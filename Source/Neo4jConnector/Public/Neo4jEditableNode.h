@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Neo4jKeyFuncs.h"
+#include "Neo4jNode.h"
+#include "Neo4jNodeChanges.h"
+#include "UObject/NoExportTypes.h"
+#include "Neo4jEditableNode.generated.h"
+
+
+/**
+* Handle to a node that is edited locally and saved with UNeo4jDatabase::SaveChanges.
+* Remembers which properties and labels changed since it was made or last saved, so only those are sent.
+*/
+UCLASS(BlueprintType)
+class NEO4JCONNECTOR_API UNeo4jEditableNode : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jEditableNode", meta = (Tooltip = "Makes an editable handle to a node returned by a query. Starts with no changes"))
+		static UNeo4jEditableNode* EditNode(const FNeo4jNode& node);
+
+	UFUNCTION(BlueprintPure, Category = "Neo4jEditableNode")
+		FNeo4jNode GetNode() const { return node; }
+
+	UFUNCTION(BlueprintPure, Category = "Neo4jEditableNode")
+		int GetID() const { return node.id; }
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jEditableNode")
+		void SetStringProperty(const FString& key, const FString& value);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jEditableNode")
+		void SetIntProperty(const FString& key, int value);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jEditableNode")
+		void SetFloatProperty(const FString& key, float value);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jEditableNode")
+		void SetBoolProperty(const FString& key, bool value);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jEditableNode")
+		void RemoveProperty(const FString& key);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jEditableNode")
+		void AddLabel(const FString& label);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jEditableNode")
+		void RemoveLabel(const FString& label);
+
+	UFUNCTION(BlueprintPure, Category = "Neo4jEditableNode", meta = (Tooltip = "True if anything changed since the node was made or last saved"))
+		bool IsDirty() const;
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jEditableNode", meta = (Tooltip = "Replaces the local copy with a fresh one from the server and forgets unsaved changes"))
+		void ResetNode(const FNeo4jNode& inNode);
+
+	//setting a property to the value it already has doesn't dirty it. bFloat keeps a whole number a float on save
+	void SetProperty(const FString& key, TSharedPtr<FJsonValue> value, bool bFloat = false);
+
+	//moves the pending changes into outChanges and marks the node clean. Returns false if nothing changed
+	bool TakeChanges(FNeo4jNodeChanges& outChanges);
+
+	//marks changes taken by a failed save dirty again, unless they were overwritten since
+	void RestoreChanges(const FNeo4jNodeChanges& changes);
+
+private:
+
+	FNeo4jNode node;
+
+	TSet<FString> dirtyProperties;
+	TSet<FString> removedProperties;
+
+	//properties whose current value was set as a float
+	TSet<FString> floatProperties;
+
+	TSet<FString, FNeo4jCaseSensitiveKeyFuncs> addedLabels;
+	TSet<FString, FNeo4jCaseSensitiveKeyFuncs> removedLabels;
+};
@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "Neo4jEndpoint.generated.h"
+
+
+UENUM(BlueprintType)
+enum class ENeo4jEndpointRole : uint8
+{
+	//takes every write and any read no healthy reader can serve
+	Writer,
+	//read replica, only gets read-only operations
+	Reader
+};
+
+//one server of a cluster
+USTRUCT(BlueprintType)
+struct FNeo4jEndpoint
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		FString IP;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		FString HTTPport;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		ENeo4jEndpointRole role = ENeo4jEndpointRole::Reader;
+
+};
+
+//routing state of an endpoint as seen by the client
+USTRUCT(BlueprintType)
+struct FNeo4jEndpointStatus
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(BlueprintReadOnly)
+		FNeo4jEndpoint endpoint;
+
+	//requests sent to the endpoint that haven't been answered yet
+	UPROPERTY(BlueprintReadOnly)
+		int outstandingRequests = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+		bool bHealthy = true;
+
+};
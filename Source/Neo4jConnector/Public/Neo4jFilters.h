@@ -19,12 +19,52 @@ class NEO4JCONNECTOR_API UNeo4jFilters : public UObject
 public:
 
 	UFUNCTION(BlueprintCallable, Category = "Neo4jFilter")
-		static FString FilterStringProperty(FNeo4jNode inNode, FString property);
+		static FString FilterStringProperty(const FNeo4jNode& inNode, const FString& property);
 
 	UFUNCTION(BlueprintCallable, Category = "Neo4jFilter")
-		static int FilterIntProperty(FNeo4jNode inNode, FString property);
+		static int FilterIntProperty(const FNeo4jNode& inNode, const FString& property);
 
 	UFUNCTION(BlueprintCallable, Category = "Neo4jFilter")
-		static bool FilterBoolProperty(FNeo4jNode inNode, FString property);
+		static bool FilterBoolProperty(const FNeo4jNode& inNode, const FString& property);
+
+
+#pragma region BATCH_FILTERS
+
+	//batch filters read one property out of every node into a flat array. outValid[i] is false when node i
+	//does not have the property or it could not be converted, in which case outValues[i] is left default
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jFilter", meta = (Tooltip = "Reads an int property from every node in one pass"))
+		static void ExtractIntProperty(const TArray<FNeo4jNode>& inNodes, const FString& property, TArray<int>& outValues, TArray<bool>& outValid);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jFilter", meta = (Tooltip = "Reads a float property from every node in one pass"))
+		static void ExtractFloatProperty(const TArray<FNeo4jNode>& inNodes, const FString& property, TArray<float>& outValues, TArray<bool>& outValid);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jFilter", meta = (Tooltip = "Reads a bool property from every node in one pass"))
+		static void ExtractBoolProperty(const TArray<FNeo4jNode>& inNodes, const FString& property, TArray<bool>& outValues, TArray<bool>& outValid);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jFilter", meta = (Tooltip = "Reads a string property from every node in one pass"))
+		static void ExtractStringProperty(const TArray<FNeo4jNode>& inNodes, const FString& property, TArray<FString>& outValues, TArray<bool>& outValid);
+
+	//native only, blueprint has no double type
+	static void ExtractDoubleProperty(const TArray<FNeo4jNode>& inNodes, const FString& property, TArray<double>& outValues, TArray<bool>& outValid);
+
+#pragma endregion BATCH_FILTERS
+
+
+#pragma region PROJECTION_FILTERS
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jFilter")
+		static FString FilterProjectedString(const FNeo4jProjectedResult& inResult, int row, const FString& column);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jFilter")
+		static int FilterProjectedInt(const FNeo4jProjectedResult& inResult, int row, const FString& column);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jFilter")
+		static bool FilterProjectedBool(const FNeo4jProjectedResult& inResult, int row, const FString& column);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jFilter")
+		static TArray<FString> FilterProjectedLabels(const FNeo4jProjectedResult& inResult, int row);
+
+#pragma endregion PROJECTION_FILTERS
 	
 };
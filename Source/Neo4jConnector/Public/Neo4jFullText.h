@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "Neo4jNode.h"
+#include "Neo4jFullText.generated.h"
+
+
+//how search text is turned into a lucene query
+UENUM(BlueprintType)
+enum class ENeo4jFullTextMode : uint8
+{
+	//every word has to match, each is quoted so lucene syntax in the text is taken literally
+	AllTerms,
+	//every word has to match as a word prefix, for search as you type
+	AllPrefixes,
+	//the text is passed to lucene as is
+	Lucene
+};
+
+USTRUCT(BlueprintType)
+struct FNeo4jFullTextMatch
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(BlueprintReadOnly)
+		FNeo4jNode node;
+
+	//lucene relevance, only comparable between matches of the same query
+	UPROPERTY(BlueprintReadOnly)
+		float score = 0.f;
+
+};
+
+//one page of full-text matches, best first
+USTRUCT(BlueprintType)
+struct FNeo4jFullTextResult
+{
+	GENERATED_BODY()
+public:
+
+	//search text the page answers, so stale pages can be told apart
+	UPROPERTY(BlueprintReadOnly)
+		FString text;
+
+	UPROPERTY(BlueprintReadOnly)
+		int offset = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+		TArray<FNeo4jFullTextMatch> matches;
+
+	//true if there are matches past this page
+	UPROPERTY(BlueprintReadOnly)
+		bool bHasMore = false;
+
+};
@@ -0,0 +1,90 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonValue;
+
+
+/**
+* Writes json straight into a utf-8 byte buffer without building a json object first.
+* Commas are placed automatically, callers only open/close containers and write keys and values in order.
+* Also knows the shape of a transactional http request body so query code doesn't repeat it.
+*/
+class NEO4JCONNECTOR_API FNeo4jJsonWriter
+{
+public:
+
+	//appends to outBuffer, which is not cleared, so a buffer can be reset and reused between requests
+	explicit FNeo4jJsonWriter(TArray<uint8>& outBuffer);
+
+	void BeginObject();
+	void EndObject();
+
+	void BeginArray();
+	void EndArray();
+
+	//object member name, the member's value is whatever is written next
+	void WriteKey(const FString& key);
+
+	//same as WriteKey for a name that was already written as a json string, so repeated keys are escaped once
+	void WriteRawKey(const TArray<uint8>& quotedKey);
+
+	void WriteString(const FString& value);
+
+	//for float typed values. Keeps a fraction on whole numbers so the server stores a float, not an integer.
+	//Non finite numbers have no json form and are written as null
+	void WriteNumber(double value);
+
+	//same for values that were floats to begin with. Written with the fewest digits that read back as the same float,
+	//at most 9, so 0.1f goes out as 0.1 instead of the 0.10000000149011612 its double holds
+	void WriteFloat(float value);
+
+	void WriteInt(int64 value);
+
+	void WriteBool(bool value);
+
+	void WriteNull();
+
+	//writes a parsed json value, nested arrays and objects included. A parsed number doesn't know whether it was
+	//an integer, so whole numbers are written as integers; callers that know a value is a float use WriteNumber
+	void WriteValue(const TSharedPtr<FJsonValue>& value);
+
+	//copies json that is already serialized as utf-8 in as one value
+	void WriteRawValue(const TArray<uint8>& json);
+
+	//{"statements":[
+	void BeginStatements();
+
+	//]}
+	void EndStatements();
+
+	//opens {"statement":"..." and leaves it open for a "parameters" member. bRowsOnly drops the meta
+	//column from the response, for queries whose results are read from rows alone
+	void BeginStatement(const FString& statement, bool bRowsOnly = false);
+
+	void EndStatement();
+
+	//a whole statement without parameters
+	void WriteStatement(const FString& statement, bool bRowsOnly = false);
+
+private:
+
+	//comma between members, nothing after a key
+	void _BeforeValue();
+
+	void _WriteEscaped(const FString& string);
+
+	void _Append(const ANSICHAR* text, int32 length);
+
+	//appends a formatted number, adding .0 to whole ones so they stay floats
+	void _AppendNumber(const ANSICHAR* text, int32 length);
+
+	TArray<uint8>& buffer;
+
+	//one entry per open container, true once something was written into it
+	TArray<bool, TInlineAllocator<16>> containerHasMembers;
+
+	bool bAfterKey = false;
+};
@@ -0,0 +1,22 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+//neo4j labels, types and property keys are case-sensitive, FString's default hashing and == are not.
+//TSet<FString, FNeo4jCaseSensitiveKeyFuncs> keeps Enemy and enemy apart
+struct FNeo4jCaseSensitiveKeyFuncs : DefaultKeyFuncs<FString>
+{
+	static bool Matches(const FString& a, const FString& b) { return a.Equals(b, ESearchCase::CaseSensitive); }
+	static uint32 GetKeyHash(const FString& key) { return FCrc::StrCrc32(*key); }
+};
+
+//TMap<FString, ValueType, FDefaultSetAllocator, TNeo4jCaseSensitiveMapKeyFuncs<ValueType>>
+template<typename ValueType>
+struct TNeo4jCaseSensitiveMapKeyFuncs : TDefaultMapKeyFuncs<FString, ValueType, false>
+{
+	static bool Matches(const FString& a, const FString& b) { return a.Equals(b, ESearchCase::CaseSensitive); }
+	static uint32 GetKeyHash(const FString& key) { return FCrc::StrCrc32(*key); }
+};
@@ -0,0 +1,329 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/ArrayView.h"
+#include "Neo4jKeyFuncs.h"
+#include "Neo4jNode.h"
+#include "UObject/NoExportTypes.h"
+#include "Neo4jMappedGraph.generated.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+
+//type of a property column. Lists and maps are stored as condensed json text in string columns
+enum class ENeo4jMappedColumnType : uint8
+{
+	Number,
+	Bool,
+	String
+};
+
+//one adjacency entry. node is an index into the graph's node arrays, type a string table index
+struct FNeo4jMappedEdge
+{
+	uint32 node;
+	uint32 type;
+	int32 relationshipId;
+	uint32 reserved;
+};
+
+//nodes carrying a label are stored contiguously in the label node section
+struct FNeo4jMappedLabel
+{
+	uint32 name;
+	uint32 firstNode;
+	uint32 numNodes;
+	uint32 reserved;
+};
+
+struct FNeo4jMappedColumn
+{
+	uint32 key;
+	ENeo4jMappedColumnType type;
+	uint8 reserved[3];
+
+	//one bit per node, set when the node has a value of the column's type
+	uint64 presentOffset;
+
+	//double, uint8 or uint32 string index per node depending on type
+	uint64 valuesOffset;
+};
+
+//file header, every offset is from the start of the file and 8 byte aligned
+struct FNeo4jMappedGraphHeader
+{
+	uint32 magic;
+	uint32 formatVersion;
+	int64 dataVersion;
+
+	uint32 numNodes;
+	uint32 numRelationships;
+	uint32 numStrings;
+	uint32 numLabels;
+	uint32 numColumns;
+	uint32 reserved;
+
+	//int32[numNodes], ascending so ids are found by binary search
+	uint64 nodeIdsOffset;
+
+	//uint32[numNodes + 1] into nodeLabels, uint32 string indices
+	uint64 nodeLabelStartsOffset;
+	uint64 nodeLabelsOffset;
+
+	//FNeo4jMappedLabel[numLabels] sorted by name, uint32 node indices
+	uint64 labelsOffset;
+	uint64 labelNodesOffset;
+
+	//csr adjacency: uint32[numNodes + 1] into FNeo4jMappedEdge[numRelationships], both directions
+	uint64 outStartsOffset;
+	uint64 outEdgesOffset;
+	uint64 inStartsOffset;
+	uint64 inEdgesOffset;
+
+	//uint64[numStrings + 1] into utf8 data. Strings are unique and sorted bytewise
+	uint64 stringStartsOffset;
+	uint64 stringDataOffset;
+
+	//FNeo4jMappedColumn[numColumns] sorted by key
+	uint64 columnsOffset;
+};
+
+
+/**
+* Collects a graph page by page and writes it as a mapped graph file.
+* Every page is folded into compact per node arrays and an interned string table as it is added, so the json of one
+* page can be freed before the next arrives and the whole graph is never held as FNeo4jNodes.
+*/
+class NEO4JCONNECTOR_API FNeo4jMappedGraphBuilder
+{
+public:
+
+	void SetDataVersion(int64 inDataVersion) { dataVersion = inDataVersion; }
+
+	void AddNodes(const TArray<FNeo4jNode>& nodes);
+
+	//relationships whose ends are never added are dropped when writing
+	void AddRelationships(const TArray<FNeo4jRelationship>& inRelationships);
+
+	int32 Num() const { return nodeIds.Num(); }
+
+	//sections are streamed to a temporary file that replaces filePath once it is complete
+	bool Write(const FString& filePath) const;
+
+	void Reset();
+
+private:
+
+	//number, 0/1 or string id depending on the column type
+	struct FCell
+	{
+		uint32 node;
+		uint32 string;
+		double number;
+	};
+
+	struct FColumn
+	{
+		uint32 key;
+		ENeo4jMappedColumnType type;
+		TArray<FCell> cells;
+	};
+
+	struct FRelationship
+	{
+		int32 id;
+		uint32 type;
+		int32 startNode;
+		int32 endNode;
+	};
+
+	//ids are handed out in the order strings are first seen, Write sorts them
+	uint32 _Intern(const FString& string);
+
+	int64 dataVersion = 0;
+
+	TArray<int32> nodeIds;
+	TArray<uint32> nodeLabelStarts;
+	TArray<uint32> nodeLabels;
+
+	//keys, labels, types and values are case-sensitive in neo4j, so is every lookup here
+	TMap<FString, uint32, FDefaultSetAllocator, TNeo4jCaseSensitiveMapKeyFuncs<uint32>> stringIds;
+	TMap<FString, int32, FDefaultSetAllocator, TNeo4jCaseSensitiveMapKeyFuncs<int32>> columnOfKey;
+	TArray<FColumn> columns;
+
+	TArray<FRelationship> relationships;
+};
+
+
+/**
+* Read-only graph backed by a memory-mapped file written by UNeo4jMappedGraph::ExportMappedGraph.
+* Opening only checks that every section lies inside the file, so no page is touched before it is read. Stored indices
+* are checked where they are followed, bValidateIndices walks all of them up front instead for files that may be corrupt.
+* Everything is read in place without copies and the pages are shared by every process mapping the same file.
+* Nodes are addressed by index, use FindNode to go from a database id to an index.
+*/
+class NEO4JCONNECTOR_API FNeo4jMappedGraph
+{
+public:
+
+	~FNeo4jMappedGraph();
+
+	bool Open(const FString& filePath, bool bValidateIndices = false);
+
+	void Close();
+
+	bool IsOpen() const { return header != nullptr; }
+
+	int64 GetDataVersion() const { return header->dataVersion; }
+
+	int32 Num() const { return header->numNodes; }
+
+	//returns INDEX_NONE if the id is not in the graph
+	int32 FindNode(int nodeID) const;
+
+	bool IsValidIndex(int32 index) const { return index >= 0 && index < (int32)header->numNodes; }
+
+	//returns INDEX_NONE for an index outside the graph
+	int GetNodeID(int32 index) const { return IsValidIndex(index) ? nodeIds[index] : INDEX_NONE; }
+
+	TArrayView<const uint32> GetNodeLabels(int32 index) const;
+
+	TArrayView<const FNeo4jMappedEdge> GetOutgoingEdges(int32 index) const;
+
+	TArrayView<const FNeo4jMappedEdge> GetIncomingEdges(int32 index) const;
+
+	//indices of every node carrying the label, empty if the label is unknown. The indices themselves are as stored, check
+	//them with IsValidIndex unless the graph was opened with bValidateIndices
+	TArrayView<const uint32> GetNodesWithLabel(const FString& label) const;
+
+	//appends neighbour indices, skipping any outside the graph. An empty typeFilter matches every relationship type
+	void GetNeighbours(int32 index, ENeo4jDirection direction, const TArray<FString>& typeFilter, TArray<int32>& outIndices) const;
+
+	bool GetNumberProperty(int32 index, const FString& key, double& outValue) const;
+
+	bool GetBoolProperty(int32 index, const FString& key, bool& outValue) const;
+
+	//also returns numbers and bools as text
+	bool GetStringProperty(int32 index, const FString& key, FString& outValue) const;
+
+	//returns MAX_uint32 if the string is not in the table
+	uint32 FindString(const FString& string) const;
+
+	//empty for an index outside the string table
+	FString GetString(uint32 stringIndex) const;
+
+	//rebuilds a full node for code that needs the TMap representation
+	FNeo4jNode MakeNode(int32 index) const;
+
+private:
+
+	bool _ValidateSections(int64 fileSize) const;
+
+	bool _ValidateIndices() const;
+
+	//utf8 bytes of a string, false if the stored range is broken
+	bool _GetStringBytes(uint32 stringIndex, const uint8*& outBytes, uint64& outLength) const;
+
+	const FNeo4jMappedColumn* _FindColumn(const FString& key) const;
+
+	static bool _IsPresent(const uint8* fileData, const FNeo4jMappedColumn& column, int32 index);
+
+	template<typename T>
+	const T* _Section(uint64 offset) const { return reinterpret_cast<const T*>(data + offset); }
+
+	TUniquePtr<IMappedFileHandle> mappedFile;
+	TUniquePtr<IMappedFileRegion> mappedRegion;
+
+	//used instead of the mapping on platforms that can't map files
+	TArray<uint8> loadedFile;
+
+	const uint8* data = nullptr;
+	const FNeo4jMappedGraphHeader* header = nullptr;
+
+	const int32* nodeIds = nullptr;
+	const uint32* nodeLabelStarts = nullptr;
+	const uint32* nodeLabels = nullptr;
+	const FNeo4jMappedLabel* labels = nullptr;
+	const uint32* labelNodes = nullptr;
+	const uint32* outStarts = nullptr;
+	const FNeo4jMappedEdge* outEdges = nullptr;
+	const uint32* inStarts = nullptr;
+	const FNeo4jMappedEdge* inEdges = nullptr;
+	const uint64* stringStarts = nullptr;
+	const uint8* stringData = nullptr;
+	const FNeo4jMappedColumn* columns = nullptr;
+};
+
+
+/**
+* Blueprint access to a mapped graph, with the neighbour and property queries of UNeo4jDatabase answered locally.
+* Queries return node ids, use GetNodesByID to materialize nodes.
+*/
+UCLASS(BlueprintType)
+class NEO4JCONNECTOR_API UNeo4jMappedGraph : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jMappedGraph", meta = (Tooltip = "Writes a subgraph, e.g. subgraphQueryOutput, to a memory-mappable graph file. UNeo4jDatabase::ExportMappedGraphByLabels pages large graphs straight from the server instead"))
+		static bool ExportMappedGraph(const FNeo4jSubgraph& subgraph, const FString& filePath);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jMappedGraph", meta = (Tooltip = "Maps a graph file. Returns null if it is missing or invalid. bValidateIndices reads the whole file once to reject corrupt indices up front"))
+		static UNeo4jMappedGraph* OpenMappedGraph(const FString& filePath, bool bValidateIndices = false);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jMappedGraph")
+		int GetNumNodes() const;
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jMappedGraph")
+		TArray<FNeo4jNode> GetNodesByID(const TArray<int>& elementIDs) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jMappedGraph", meta = (Tooltip = "Returns ids of nodes carrying every input label"))
+		TArray<int> GetNodesByLabels(const TArray<FString>& labels) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jMappedGraph")
+		TArray<FString> GetNodeLabels(int nodeID) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jMappedGraph")
+		TArray<int> GetNodeNeighbours(int nodeID) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jMappedGraph")
+		TArray<int> GetNodeNeighboursByTypes(int nodeID, const TArray<FString>& relationTypes) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jMappedGraph")
+		TArray<int> GetIncomingNeighboursFromNode(int nodeID) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jMappedGraph")
+		TArray<int> GetOutgoingNeighboursFromNode(int nodeID) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jMappedGraph")
+		TArray<int> GetIncomingNeighboursByTypes(int nodeID, const TArray<FString>& relationTypes) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jMappedGraph")
+		TArray<int> GetOutgoingNeighboursByTypes(int nodeID, const TArray<FString>& relationTypes) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jMappedGraph")
+		bool GetIntProperty(int nodeID, const FString& property, int& outValue) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jMappedGraph")
+		bool GetFloatProperty(int nodeID, const FString& property, float& outValue) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jMappedGraph")
+		bool GetBoolProperty(int nodeID, const FString& property, bool& outValue) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jMappedGraph")
+		bool GetStringProperty(int nodeID, const FString& property, FString& outValue) const;
+
+	const FNeo4jMappedGraph& GetGraph() const { return graph; }
+
+	virtual void BeginDestroy() override;
+
+private:
+
+	TArray<int> _GetNeighbourIDs(int nodeID, ENeo4jDirection direction, const TArray<FString>& relationTypes) const;
+
+	FNeo4jMappedGraph graph;
+};
@@ -49,3 +49,156 @@ public:
 
 
 };
+
+
+//direction of a relationship pattern relative to the source node
+UENUM(BlueprintType)
+enum class ENeo4jDirection : uint8
+{
+	Both,
+	Outgoing,
+	Incoming
+};
+
+//describes which fields a projected query brings back instead of whole nodes
+USTRUCT(BlueprintType)
+struct FNeo4jProjection
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		TArray<FString> properties;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		bool bIncludeLabels = false;
+
+};
+
+//row/column result of a projected query. values are row major: values[row * columns.Num() + column]
+USTRUCT(BlueprintType)
+struct FNeo4jProjectedResult
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(BlueprintReadOnly)
+		TArray<FString> columns;
+
+	UPROPERTY(BlueprintReadOnly)
+		TArray<int> ids;
+
+	TArray<TSharedPtr<FJsonValue>> values;
+
+	//only filled when the projection included labels
+	TArray<TArray<FString>> labels;
+
+	int Num() const { return ids.Num(); }
+
+	//property names are case-sensitive in neo4j, so hp and HP are different columns
+	int FindColumn(const FString& column) const
+	{
+		return columns.IndexOfByPredicate([&column](const FString& name) { return name.Equals(column, ESearchCase::CaseSensitive); });
+	}
+
+	//null if the column doesn't exist or the node had no such property
+	TSharedPtr<FJsonValue> GetValue(int row, int column) const
+	{
+		if (!ids.IsValidIndex(row) || !columns.IsValidIndex(column))
+			return nullptr;
+
+		return values[row * columns.Num() + column];
+	}
+
+};
+
+//client side copy of every node with a set of labels, kept current by UNeo4jDatabase::Sync. Nodes only, relationships are not synced
+USTRUCT(BlueprintType)
+struct FNeo4jSyncView
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(BlueprintReadOnly)
+		TArray<FString> labels;
+
+	//highest change marker applied so far
+	UPROPERTY(BlueprintReadOnly)
+		int64 marker = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+		TMap<int, FNeo4jNode> nodes;
+
+};
+
+//a set of nodes and the relationships between them
+USTRUCT(BlueprintType)
+struct FNeo4jSubgraph
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(BlueprintReadOnly)
+		TArray<FNeo4jNode> nodes;
+
+	UPROPERTY(BlueprintReadOnly)
+		TArray<FNeo4jRelationship> relationships;
+
+	//value of the sync clock when the subgraph was read, 0 if writes aren't stamped
+	UPROPERTY(BlueprintReadOnly)
+		int64 dataVersion = 0;
+
+};
+
+//an ordered walk through the graph. relationships[i] connects nodes[i] and nodes[i + 1]
+USTRUCT(BlueprintType)
+struct FNeo4jPath
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(BlueprintReadOnly)
+		TArray<FNeo4jNode> nodes;
+
+	UPROPERTY(BlueprintReadOnly)
+		TArray<FNeo4jRelationship> relationships;
+
+	//summed relationship weights for local searches, number of hops for server paths
+	UPROPERTY(BlueprintReadOnly)
+		float cost = 0.f;
+
+};
+
+//a neighbour as seen from the node it was queried from
+USTRUCT(BlueprintType)
+struct FNeo4jNeighbour
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(BlueprintReadOnly)
+		FNeo4jNode node;
+
+	UPROPERTY(BlueprintReadOnly)
+		int relationshipID = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+		FString relationshipType;
+
+	//Outgoing if the relationship starts at the source node, Incoming otherwise
+	UPROPERTY(BlueprintReadOnly)
+		ENeo4jDirection direction = ENeo4jDirection::Outgoing;
+
+};
+
+USTRUCT(BlueprintType)
+struct FNeo4jNeighbourList
+{
+	GENERATED_BODY()
+public:
+
+	//one entry per relationship, a node connected twice shows up twice
+	UPROPERTY(BlueprintReadOnly)
+		TArray<FNeo4jNeighbour> neighbours;
+
+};
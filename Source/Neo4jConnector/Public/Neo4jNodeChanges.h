@@ -0,0 +1,26 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonValue;
+
+
+//what changed on one node since it was last saved
+struct FNeo4jNodeChanges
+{
+	int id = 0;
+
+	//new values of set properties
+	TMap<FString, TSharedPtr<FJsonValue>> setProperties;
+
+	//set properties that were set as floats, written with a fraction even when whole
+	TSet<FString> floatProperties;
+
+	TArray<FString> removedProperties;
+
+	TArray<FString> addedLabels;
+
+	TArray<FString> removedLabels;
+};
@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Neo4jNode.h"
+#include "UObject/NoExportTypes.h"
+#include "Neo4jPathfinding.generated.h"
+
+
+/**
+* Weighted adjacency built once from a subgraph so repeated searches don't rebuild it.
+* Keeps a pointer to the subgraph it was built from, which has to outlive it.
+*/
+class NEO4JCONNECTOR_API FNeo4jPathGraph
+{
+public:
+
+	//relationships without a numeric weightProperty cost defaultWeight, negative weights are dropped.
+	//An empty weightProperty makes every hop cost defaultWeight
+	void Build(const FNeo4jSubgraph& inSubgraph, const FString& weightProperty, const TArray<FString>& relationTypes,
+		ENeo4jDirection direction, double defaultWeight = 1.0);
+
+	//returns INDEX_NONE if the node is not in the subgraph
+	int32 FindNode(int nodeID) const;
+
+	//dijkstra when heuristic is unset, A* otherwise. The heuristic gets node indices into the subgraph and has to
+	//underestimate the remaining cost for the path to be optimal. Gives up after maxExpandedNodes when it is > 0
+	bool FindPath(int startNodeID, int endNodeID, FNeo4jPath& outPath, TFunction<double(int32 fromIndex, int32 toIndex)> heuristic = nullptr,
+		int32 maxExpandedNodes = 0) const;
+
+	const FNeo4jSubgraph* GetSubgraph() const { return subgraph; }
+
+private:
+
+	struct FEdge
+	{
+		int32 node;
+		int32 relationship;
+		double weight;
+	};
+
+	const FNeo4jSubgraph* subgraph = nullptr;
+
+	TMap<int, int32> indexOfID;
+
+	//csr adjacency over subgraph node indices
+	TArray<int32> edgeStarts;
+	TArray<FEdge> edges;
+};
+
+
+/**
+* Client side path searches over subgraph data, for searches that have to finish within a frame.
+*/
+UCLASS()
+class NEO4JCONNECTOR_API UNeo4jPathfinding : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jPathfinding", meta = (Tooltip = "Dijkstra over the subgraph using a numeric relationship property as weight. Missing weights count as 1. Returns false if there is no path"))
+		static bool FindWeightedPath(const FNeo4jSubgraph& subgraph, int startNodeID, int endNodeID, const FString& weightProperty,
+			const TArray<FString>& relationTypes, ENeo4jDirection direction, FNeo4jPath& outPath);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jPathfinding", meta = (Tooltip = "A* over the subgraph. The heuristic is the distance between node positions read from up to three numeric positionProperties, so weights must be at least that distance for the path to be optimal"))
+		static bool FindWeightedPathAStar(const FNeo4jSubgraph& subgraph, int startNodeID, int endNodeID, const FString& weightProperty,
+			const TArray<FString>& positionProperties, const TArray<FString>& relationTypes, ENeo4jDirection direction, FNeo4jPath& outPath);
+
+};
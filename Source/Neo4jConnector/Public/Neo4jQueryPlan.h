@@ -0,0 +1,76 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "Neo4jQueryPlan.generated.h"
+
+
+//prefix put in front of queries to capture their plan
+UENUM(BlueprintType)
+enum class ENeo4jProfileMode : uint8
+{
+	None,
+	//plan only, the query is not run and returns no rows
+	Explain,
+	//runs the query and records actual rows and db hits per operator
+	Profile
+};
+
+//one operator of a plan. Operators are stored depth first, children follow their parent
+USTRUCT(BlueprintType)
+struct FNeo4jPlanOperator
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(BlueprintReadOnly)
+		FString operatorType;
+
+	UPROPERTY(BlueprintReadOnly)
+		TArray<FString> identifiers;
+
+	//INDEX_NONE for the root
+	UPROPERTY(BlueprintReadOnly)
+		int parentIndex = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadOnly)
+		int depth = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+		float estimatedRows = 0.f;
+
+	//actual rows and db hits are only reported for PROFILE
+	UPROPERTY(BlueprintReadOnly)
+		int64 rows = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+		int64 dbHits = 0;
+
+};
+
+USTRUCT(BlueprintType)
+struct FNeo4jQueryPlan
+{
+	GENERATED_BODY()
+public:
+
+	//name of the database function that issued the query
+	UPROPERTY(BlueprintReadOnly)
+		FString operation;
+
+	UPROPERTY(BlueprintReadOnly)
+		FString query;
+
+	//request round trip as seen by the client
+	UPROPERTY(BlueprintReadOnly)
+		float elapsedSeconds = 0.f;
+
+	UPROPERTY(BlueprintReadOnly)
+		int64 totalDbHits = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+		TArray<FNeo4jPlanOperator> operators;
+
+};
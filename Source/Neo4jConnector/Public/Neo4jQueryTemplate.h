@@ -0,0 +1,116 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "Neo4jQueryTemplate.generated.h"
+
+
+//type a template parameter slot accepts
+UENUM(BlueprintType)
+enum class ENeo4jParameterType : uint8
+{
+	String,
+	Int,
+	Float,
+	Bool,
+	StringList,
+	IntList,
+	FloatList
+};
+
+//declares one $name parameter of a query template
+USTRUCT(BlueprintType)
+struct FNeo4jParameterDeclaration
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		FString name;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		ENeo4jParameterType type = ENeo4jParameterType::String;
+
+};
+
+//list wrappers, blueprint maps can't hold arrays directly
+USTRUCT(BlueprintType)
+struct FNeo4jStringList
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		TArray<FString> values;
+
+};
+
+USTRUCT(BlueprintType)
+struct FNeo4jIntList
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		TArray<int> values;
+
+};
+
+USTRUCT(BlueprintType)
+struct FNeo4jFloatList
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		TArray<float> values;
+
+};
+
+//parameter values for one template execution, looked up by name in the map matching the declared type
+USTRUCT(BlueprintType)
+struct FNeo4jQueryParameters
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		TMap<FString, FString> stringParameters;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		TMap<FString, int> intParameters;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		TMap<FString, float> floatParameters;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		TMap<FString, bool> boolParameters;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		TMap<FString, FNeo4jStringList> stringListParameters;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		TMap<FString, FNeo4jIntList> intListParameters;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		TMap<FString, FNeo4jFloatList> floatListParameters;
+
+};
+
+//a registered template. The request body around the parameter object is serialized once at registration
+struct FNeo4jQueryTemplate
+{
+	FString name;
+
+	FString statement;
+
+	TArray<FNeo4jParameterDeclaration> parameters;
+
+	//{"statements":[{"statement":"...","parameters": as utf-8
+	TArray<uint8> bodyPrefix;
+
+	//}]}
+	TArray<uint8> bodySuffix;
+};
@@ -0,0 +1,25 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "Neo4jRequestOptions.generated.h"
+
+
+//per request settings, handed to UNeo4jDatabase::SetNextRequestOptions before the query function is called
+USTRUCT(BlueprintType)
+struct FNeo4jRequestOptions
+{
+	GENERATED_BODY()
+public:
+
+	//sending a request with the same key cancels this one if it is still in flight. Empty keys never supersede
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		FString supersedeKey;
+
+	//seconds until the request is cancelled, 0 uses the database's requestTimeoutSeconds
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		float timeoutSeconds = 0.f;
+
+};
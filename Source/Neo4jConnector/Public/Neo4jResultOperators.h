@@ -0,0 +1,115 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "Neo4jNode.h"
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "Neo4jResultOperators.generated.h"
+
+
+//how a property value is compared against a predicate value
+UENUM(BlueprintType)
+enum class ENeo4jComparison : uint8
+{
+	Equal,
+	NotEqual,
+	Less,
+	LessOrEqual,
+	Greater,
+	GreaterOrEqual,
+	Exists,
+	NotExists
+};
+
+//describes a single property test. Numeric property values are compared numerically when value parses as a number,
+//everything else is compared as strings
+USTRUCT(BlueprintType)
+struct FNeo4jPropertyPredicate
+{
+	GENERATED_BODY()
+
+		UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		FString property;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		ENeo4jComparison comparison = ENeo4jComparison::Equal;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		FString value;
+};
+
+//one key of a multi-key sort. Nodes missing the property always sort last
+USTRUCT(BlueprintType)
+struct FNeo4jSortKey
+{
+	GENERATED_BODY()
+
+		UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		FString property;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		bool bDescending = false;
+};
+
+//aggregate of all nodes sharing a group key. sum/min/max only cover nodes with a numeric aggregate property
+USTRUCT(BlueprintType)
+struct FNeo4jGroup
+{
+	GENERATED_BODY()
+
+		UPROPERTY(BlueprintReadOnly)
+		FString key;
+
+	UPROPERTY(BlueprintReadOnly)
+		int count = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+		int numericCount = 0;
+
+	//float copies of sum/min/max for Blueprint, which has no doubles
+	UPROPERTY(BlueprintReadOnly, meta = (DisplayName = "Sum"))
+		float blueprintSum = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, meta = (DisplayName = "Min"))
+		float blueprintMin = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, meta = (DisplayName = "Max"))
+		float blueprintMax = 0.f;
+
+	double sum = 0.0;
+	double min = 0.0;
+	double max = 0.0;
+};
+
+/**
+ * Filter, sort and group query results locally without another round trip to the server.
+ * Large inputs are split across worker threads.
+ */
+UCLASS()
+class NEO4JCONNECTOR_API UNeo4jResultOperators : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jOperators", meta = (Tooltip = "Keeps nodes matching every predicate and carrying every required label. Labels are only known for nodes from queries returning them, e.g. GetNodesByLabels"))
+		static TArray<FNeo4jNode> FilterNodes(const TArray<FNeo4jNode>& inNodes, const TArray<FNeo4jPropertyPredicate>& predicates,
+			const TArray<FString>& requiredLabels);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jOperators", meta = (Tooltip = "Sorts nodes by each key in turn"))
+		static TArray<FNeo4jNode> SortNodes(const TArray<FNeo4jNode>& inNodes, const TArray<FNeo4jSortKey>& sortKeys);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jOperators", meta = (Tooltip = "Returns the first k nodes of the sorted order without sorting the whole array"))
+		static TArray<FNeo4jNode> TopKNodes(const TArray<FNeo4jNode>& inNodes, const TArray<FNeo4jSortKey>& sortKeys, int k);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jOperators", meta = (Tooltip = "Groups nodes by a property value and aggregates a numeric property per group"))
+		static TArray<FNeo4jGroup> GroupByProperty(const TArray<FNeo4jNode>& inNodes, const FString& groupProperty, const FString& aggregateProperty);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jOperators", meta = (Tooltip = "Groups nodes by label, a node with several labels counts towards each. Needs nodes from queries returning labels"))
+		static TArray<FNeo4jGroup> GroupByLabel(const TArray<FNeo4jNode>& inNodes, const FString& aggregateProperty);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jOperators", meta = (Tooltip = "Keeps the first node for every distinct combination of the input properties. Empty properties dedupes by node id"))
+		static TArray<FNeo4jNode> DistinctNodes(const TArray<FNeo4jNode>& inNodes, const TArray<FString>& properties);
+
+};
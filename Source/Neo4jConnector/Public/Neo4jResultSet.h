@@ -0,0 +1,135 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Neo4jNode.h"
+
+
+//type of a property stored in a result set. Lists and maps are kept as condensed json text
+enum class ENeo4jResultValueType : uint8
+{
+	Null,
+	Number,
+	Bool,
+	String,
+	Json
+};
+
+/**
+* Node query result stored in a handful of flat buffers instead of one TMap per node.
+* Property keys are interned once per result set and every string value lives in one shared character arena,
+* so a response costs a few large allocations that are kept and reused when the set is reset.
+*/
+class NEO4JCONNECTOR_API FNeo4jResultSet
+{
+public:
+
+	//parses a raw node query response, appending its rows. The node is the first row column, labels(m) may follow it.
+	//Returns false if the response was not valid json
+	bool ParseQueryResult(const FString& resultString);
+
+	//drops all rows. Buffers keep their capacity unless bReleaseMemory is set
+	void Reset(bool bReleaseMemory = false);
+
+	int32 Num() const { return rows.Num(); }
+
+	int32 GetID(int32 row) const { return rows[row].id; }
+
+	bool HasProperty(int32 row, const FString& key) const;
+
+	bool GetNumber(int32 row, const FString& key, double& outValue) const;
+	bool GetBool(int32 row, const FString& key, bool& outValue) const;
+
+	//also returns numbers, bools and json values as text
+	bool GetString(int32 row, const FString& key, FString& outValue) const;
+
+	//rebuilds a full node for code that still needs the TMap representation
+	FNeo4jNode ToNode(int32 row) const;
+	TArray<FNeo4jNode> ToNodes() const;
+
+	//bytes held by the buffers, including unused capacity
+	SIZE_T GetAllocatedSize() const;
+
+	//adds keys to the intern table ahead of the first response that uses them
+	void InternKeys(const TArray<FString>& inKeys);
+
+private:
+
+	struct FRow
+	{
+		int32 id;
+		int32 firstProperty;
+		int32 numProperties;
+		int32 firstLabel;
+		int32 numLabels;
+	};
+
+	//label text in the string arena
+	struct FLabel
+	{
+		int32 stringOffset;
+		int32 stringLength;
+	};
+
+	struct FResultProperty
+	{
+		int32 keyIndex;
+		ENeo4jResultValueType type;
+		bool boolean;
+		double number;
+		int32 stringOffset;
+		int32 stringLength;
+	};
+
+	const FResultProperty* _FindProperty(int32 row, const FString& key) const;
+
+	int32 _InternKey(const FString& key);
+
+	int32 _AppendString(const FString& string);
+
+	TSharedPtr<FJsonValue> _MakeJsonValue(const FResultProperty& property) const;
+
+	TArray<FRow> rows;
+	TArray<FResultProperty> properties;
+	TArray<FLabel> labels;
+	TArray<TCHAR> stringArena;
+
+	//interned property keys, kept across resets since the same keys come back on every query
+	TArray<FString> keys;
+	TMap<FString, int32> keyIndices;
+
+	friend class FNeo4jResultSetParser;
+};
+
+
+/**
+* Keeps released result sets around so their buffers are reused by the next response.
+*/
+class NEO4JCONNECTOR_API FNeo4jResultSetPool
+{
+public:
+
+	//sets holding more than this are freed on release instead of pooled
+	SIZE_T maxRetainedBytes = 64 * 1024 * 1024;
+
+	//number of idle sets kept
+	int32 maxPooledSets = 4;
+
+	TSharedRef<FNeo4jResultSet> Acquire();
+
+	//resets the set and returns it to the pool. The pointer is cleared
+	void Release(TSharedPtr<FNeo4jResultSet>& resultSet);
+
+	//frees every idle set
+	void Trim();
+
+	//property keys every set, pooled or new, starts out with interned
+	void SetKnownKeys(const TArray<FString>& inKeys);
+
+private:
+
+	TArray<TSharedRef<FNeo4jResultSet>> freeSets;
+
+	TArray<FString> knownKeys;
+};
@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "Neo4jSchema.generated.h"
+
+
+//kind of index backing a (label, property) pair
+UENUM(BlueprintType)
+enum class ENeo4jIndexType : uint8
+{
+	Range,
+	//uniqueness constraint, neo4j backs it with its own range index
+	Unique,
+	//for point properties, used by distance and bounding box predicates
+	Point
+};
+
+//one entry of a declared schema
+USTRUCT(BlueprintType)
+struct FNeo4jIndexDefinition
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		FString label;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		FString property;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		ENeo4jIndexType type = ENeo4jIndexType::Range;
+
+};
+
+//a full-text index over string properties of nodes with any of the labels
+USTRUCT(BlueprintType)
+struct FNeo4jFullTextIndexDefinition
+{
+	GENERATED_BODY()
+public:
+
+	//searches refer to the index by this name
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		FString name;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		TArray<FString> labels;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		TArray<FString> properties;
+
+};
+
+//an index as reported by the server
+USTRUCT(BlueprintType)
+struct FNeo4jIndexInfo
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(BlueprintReadOnly)
+		FString name;
+
+	//RANGE, POINT, FULLTEXT, LOOKUP...
+	UPROPERTY(BlueprintReadOnly)
+		FString type;
+
+	UPROPERTY(BlueprintReadOnly)
+		TArray<FString> labelsOrTypes;
+
+	UPROPERTY(BlueprintReadOnly)
+		TArray<FString> properties;
+
+	//ONLINE, POPULATING or FAILED
+	UPROPERTY(BlueprintReadOnly)
+		FString state;
+
+	//name of the constraint owning this index, empty for plain indexes. Drop the constraint to remove it
+	UPROPERTY(BlueprintReadOnly)
+		FString owningConstraint;
+
+};
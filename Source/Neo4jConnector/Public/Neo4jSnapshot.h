@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Neo4jNode.h"
+#include "UObject/NoExportTypes.h"
+#include "Neo4jSnapshot.generated.h"
+
+//what ValidateSnapshot found out about a snapshot
+UENUM(BlueprintType)
+enum class ENeo4jSnapshotState : uint8
+{
+	//not validated yet, or neither the snapshot nor the server has stamped writes to compare
+	Unknown,
+	//the server has had no stamped writes since the snapshot was taken
+	Current,
+	//the server has had stamped writes since the snapshot was taken
+	Stale
+};
+
+/**
+ * Saves fetched subgraphs to compact versioned binary files and loads them back, so reference data can be
+ * read from disk at startup instead of the database.
+ */
+UCLASS()
+class NEO4JCONNECTOR_API UNeo4jSnapshot : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jSnapshot", meta = (Tooltip = "Writes a subgraph to a snapshot file. Returns false if the file couldn't be written"))
+		static bool SaveSnapshot(const FNeo4jSubgraph& subgraph, const FString& filePath);
+
+	UFUNCTION(BlueprintCallable, Category = "Neo4jSnapshot", meta = (Tooltip = "Reads a snapshot file on the calling thread. Returns false if it is missing, corrupt or from another format version"))
+		static bool LoadSnapshot(const FString& filePath, FNeo4jSubgraph& outSubgraph);
+
+	//reads the snapshot on a pool thread and calls onLoaded on the game thread
+	static void LoadSnapshotAsync(const FString& filePath, TFunction<void(bool bLoaded, FNeo4jSubgraph& subgraph)> onLoaded);
+
+	static bool SerializeSubgraph(const FNeo4jSubgraph& subgraph, TArray<uint8>& outBytes);
+
+	static bool DeserializeSubgraph(const TArray<uint8>& bytes, FNeo4jSubgraph& outSubgraph);
+
+};
@@ -0,0 +1,41 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "Neo4jNode.h"
+#include "Neo4jSpatial.generated.h"
+
+
+//a cartesian point property. Stored and compared as 2D (x, y) or 3D, a 2D point never matches a 3D one
+USTRUCT(BlueprintType)
+struct FNeo4jPoint
+{
+	GENERATED_BODY()
+public:
+
+	//z is ignored for 2D points
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		FVector location = FVector::ZeroVector;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+		bool b3D = false;
+
+};
+
+//a node found by a spatial query
+USTRUCT(BlueprintType)
+struct FNeo4jSpatialMatch
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(BlueprintReadOnly)
+		FNeo4jNode node;
+
+	//distance from the query center, 0 for box queries
+	UPROPERTY(BlueprintReadOnly)
+		float distance = 0.f;
+
+};
@@ -0,0 +1,120 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Class.h"
+
+class FNeo4jJsonWriter;
+class FProperty;
+
+
+/**
+* Maps the UPROPERTY fields of a USTRUCT onto node properties of the same name.
+* The field table is built from reflection once per struct type and cached, so writing a struct or filling one
+* from a response only walks that table: no FNeo4jNode, no property TMap and no FJsonValue per field.
+*
+* Supported fields are integers, floats, bools, FString, FName and enums (stored by name). An int field named id
+* receives the node id and is never written. Other fields are ignored. Names match case-sensitively, like neo4j keys.
+*/
+class NEO4JCONNECTOR_API FNeo4jStructBinder
+{
+public:
+
+	//binder for a struct type, built on first use. Thread safe
+	static const FNeo4jStructBinder& Get(const UScriptStruct* type);
+
+	template<typename TStruct>
+	static const FNeo4jStructBinder& Get()
+	{
+		return Get(TStruct::StaticStruct());
+	}
+
+	const UScriptStruct* GetStruct() const { return structType; }
+
+	//number of bound fields, the id field excluded
+	int32 Num() const { return fields.Num(); }
+
+	//writes the struct as a {"field":value...} object
+	void WriteProperties(const void* structMemory, FNeo4jJsonWriter& writer) const;
+
+	//writes [{...}, {...}] for num structs laid out stride bytes apart
+	void WriteArray(const void* firstStruct, int32 num, int32 stride, FNeo4jJsonWriter& writer) const;
+
+	//parses a node query response, calling addStruct for a default constructed struct to fill per row.
+	//Returns false if the response was not valid json
+	bool ParseQueryResult(const FString& resultString, TFunctionRef<void*()> addStruct) const;
+
+	template<typename TStruct>
+	bool ParseQueryResult(const FString& resultString, TArray<TStruct>& outStructs) const
+	{
+		check(TStruct::StaticStruct() == structType);
+		return ParseQueryResult(resultString, [&outStructs]() -> void* { return &outStructs.AddDefaulted_GetRef(); });
+	}
+
+private:
+
+	enum class EFieldType : uint8
+	{
+		Int,
+		Float,
+		Bool,
+		String,
+		Name,
+		Enum
+	};
+
+	struct FField
+	{
+		const FProperty* property;
+
+		//byte offset into the struct
+		int32 offset;
+
+		EFieldType type;
+
+		FString key;
+
+		//key already escaped and quoted as utf-8 json
+		TArray<uint8> quotedKey;
+
+		//enum of Enum fields
+		const UEnum* enumType;
+
+		//integer holding an enum's value, the enum property itself for byte enums
+		const FProperty* enumValueProperty;
+	};
+
+	//neo4j property keys are case-sensitive, FString's default hashing and == are not
+	struct FCaseSensitiveKeyFuncs : BaseKeyFuncs<TPair<FString, int32>, FString, false>
+	{
+		static const FString& GetSetKey(const TPair<FString, int32>& element) { return element.Key; }
+		static bool Matches(const FString& a, const FString& b) { return a.Equals(b, ESearchCase::CaseSensitive); }
+		static uint32 GetKeyHash(const FString& key) { return FCrc::StrCrc32(*key); }
+	};
+
+	explicit FNeo4jStructBinder(const UScriptStruct* inStructType);
+
+	//false once a reload has changed the struct under the cached field table
+	bool _MatchesLayout() const;
+
+	//index of the field named key, INDEX_NONE if there is none. hint is checked first,
+	//rows tend to list their properties in the same order
+	int32 _FindField(const FString& key, int32 hint) const;
+
+	const UScriptStruct* structType;
+
+	//layout the field table was built from
+	int32 structSize;
+	const FProperty* firstProperty;
+
+	TArray<FField> fields;
+
+	TMap<FString, int32, FDefaultSetAllocator, FCaseSensitiveKeyFuncs> fieldIndices;
+
+	//numeric property receiving the node id, null if the struct has none
+	const FProperty* idProperty = nullptr;
+	int32 idOffset = 0;
+
+	friend class FNeo4jStructParser;
+};
@@ -3,10 +3,27 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Neo4jAggregation.h"
 #include "Neo4jNode.h"
+#include "Neo4jNodeChanges.h"
+#include "Neo4jFullText.h"
+#include "Neo4jSchema.h"
+#include "Neo4jSpatial.h"
+#include "Neo4jQueryPlan.h"
+#include "Neo4jQueryTemplate.h"
 #include "UObject/NoExportTypes.h"
 #include "Neo4jUtilities.generated.h"
 
+class FNeo4jJsonWriter;
+
+//names the change marker sync stores in the graph
+static const TCHAR* const SYNC_MARKER_PROPERTY = TEXT("_syncMarker");
+static const TCHAR* const SYNC_CLOCK_LABEL = TEXT("_Neo4jSyncClock");
+static const TCHAR* const SYNC_TOMBSTONE_LABEL = TEXT("_Neo4jTombstone");
+
+//the clock node is merged on this key, a uniqueness constraint on it keeps concurrent writers on one node
+static const TCHAR* const SYNC_CLOCK_KEY_PROPERTY = TEXT("id");
+
 /**
  * 
  */
@@ -19,17 +36,162 @@ public:
 
 	static FString _ConstructJSONQueryString(FString stringToSerialize);
 
+	//same as above but sends each string as its own statement in one transaction
+	static FString _ConstructJSONQueryString(const TArray<FString>& statementsToSerialize);
+
+	//true if the response's errors array is not empty. Cypher errors come back with a 200
+	static bool HasQueryErrors(const FString& resultString);
+
+	//quotes and escapes a string for direct use in a json document
+	static FString EscapeJsonString(const FString& string);
+
+	//serializes the statement once and keeps the body split around the parameters object
+	static FNeo4jQueryTemplate MakeQueryTemplate(const FString& name, const FString& statement,
+		const TArray<FNeo4jParameterDeclaration>& parameters);
+
+	//writes {"name":value...} for every declared parameter. Returns false if a value is missing, leaving the writer mid object
+	static bool SerializeTemplateParameters(const FNeo4jQueryTemplate& queryTemplate, const FNeo4jQueryParameters& values, FNeo4jJsonWriter& writer);
+
 	static FString SerializeLabelsIntoQuery(TArray<FString> labels);
 
 	static FString SerializePropertiesIntoQuery(TMap<FString, FString> stringProps, TMap<FString, int> intProps,
 		TMap<FString, bool> boolProps);
 
 
+	//node in the first column. labels are filled when the query returns labels(m) as the second
 	static TArray<FNeo4jNode> DeserializeNodeQueryResult(FString resultString);
 
 
+	//cypher float literal, always with a fraction or exponent so the server doesn't store an integer. null if not finite
+	static FString SerializeNumber(double value);
+
+	//same for float typed values, with only as many digits as the float has
+	static FString SerializeNumber(float value);
+
+	//point({x:..., y:...[, z:...]})
+	static FString SerializePoint(const FNeo4jPoint& point);
+
+	//{name:1.5, name:point(...)} for set/create, empty if both maps are empty
+	static FString SerializeSpatialPropertiesIntoQuery(const TMap<FString, float>& floatProps, const TMap<FString, FNeo4jPoint>& pointProps);
+
+	//reads a point property as neo4j returns it, {"type":"Point","coordinates":[...]}. Returns false if it isn't one
+	static bool GetPointProperty(const FNeo4jNode& node, const FString& property, FNeo4jPoint& outPoint);
+
+	//rows of [id, labels, properties, distance]
+	static TArray<FNeo4jSpatialMatch> DeserializeSpatialQueryResult(const FString& resultString);
+
+
+	//[1,2,3]
+	static FString SerializeIDsIntoQuery(const TArray<int>& ids);
+
+	//-[:A|B]-> style pattern between two node patterns, relationVariable may be empty.
+	//lengthRange is appended after the types for variable length patterns, e.g. *..5
+	static FString SerializeRelationPattern(const TArray<FString>& relationTypes, ENeo4jDirection direction, const FString& relationVariable = FString(),
+		const FString& lengthRange = FString());
+
+	//wraps a property or label name in backticks so any name is a valid identifier
+	static FString EscapeIdentifier(const FString& identifier);
+
+	//return clause for a projected query over nodeVariable
+	static FString SerializeProjectionIntoReturn(const FString& nodeVariable, const FNeo4jProjection& projection);
+
+	static FNeo4jProjectedResult DeserializeProjectedQueryResult(const FString& resultString);
+
+
+	//neo4jconnector_<label>_<property>_<type>_<hash>, stable so IF NOT EXISTS can skip existing indexes. Case is kept
+	//and the hash of the raw label and property keeps pairs that sanitize to the same text apart
+	static FString MakeIndexName(const FNeo4jIndexDefinition& definition);
+
+	//CREATE INDEX/CONSTRAINT ... IF NOT EXISTS statement for definition
+	static FString SerializeIndexCreation(const FNeo4jIndexDefinition& definition);
+
+	static TArray<FNeo4jIndexInfo> DeserializeIndexQueryResult(const FString& resultString);
+
+	//CREATE FULLTEXT INDEX ... IF NOT EXISTS statement for definition, empty if it has no name, labels or properties
+	static FString SerializeFullTextIndexCreation(const FNeo4jFullTextIndexDefinition& definition);
+
+	//lucene query string for search text, empty if the text has no words
+	static FString MakeFullTextQuery(const FString& text, ENeo4jFullTextMode mode);
+
+	//rows of [id, labels, properties, score]
+	static TArray<FNeo4jFullTextMatch> DeserializeFullTextQueryResult(const FString& resultString);
+
+	//reads the labels, relationship types and property keys statements sent by InitializeDatabaseAsync, each a single collected list
+	static bool DeserializeSchemaCatalog(const FString& resultString, TArray<FString>& outLabels, TArray<FString>& outRelationshipTypes,
+		TArray<FString>& outPropertyKeys);
+
+
+	//reads the plan/profile section of an EXPLAIN or PROFILE response. Returns false if the response has none
+	static bool DeserializeQueryPlan(const FString& resultString, FNeo4jQueryPlan& outPlan);
+
+
+	//return clause computing aggregation over nodeVariable, as a value column and an optional group column
+	static FString SerializeAggregationIntoReturn(const FString& nodeVariable, const FNeo4jAggregation& aggregation);
+
+	static FNeo4jAggregateResult DeserializeAggregateQueryResult(const FString& resultString);
+
+
+	//bumps the sync clock and stamps its value onto variable
+	static FString SerializeChangeMarkerStamp(const FString& variable);
+
+	//bumps the sync clock and records variable's id and the ids of its relationships as deleted at that marker.
+	//Only variable is kept in scope afterwards, for the detach delete that follows
+	static FString SerializeTombstone(const FString& variable);
+
+	//records that variable lost the labels in removedLabelsExpression, so Sync evicts it from views needing them.
+	//Follows SerializeChangeMarkerStamp, whose clock it reuses
+	static FString SerializeLabelRemovalTombstone(const FString& variable, const FString& removedLabelsExpression);
+
+	//unique clock key, the marker index every synced label needs and the tombstone marker index, as schema statements
+	static void SerializeSyncIndexCreation(const TArray<FString>& syncedLabels, TArray<FString>& outStatements);
+
+	//moves a clock written before it was keyed onto the keyed one, keeping the higher value. A data statement, so it
+	//can't share a transaction with SerializeSyncIndexCreation
+	static FString SerializeClockAdoption();
+
+	//unwind over $rows that applies every node's changes in one statement. Values, removals and label names travel
+	//as parameters, removed properties are set to null. Labels can't be parameterized so each one gets a guarded foreach
+	static void SerializeNodeChanges(const TArray<FNeo4jNodeChanges>& changes, const FString& variable, TArray<FString>& outQueryArray,
+		TArray<uint8>& outParameters);
+
+	//splits a sync response of [node, labels, marker, deleted id] rows into changed nodes and deleted ids.
+	//inOutMarker is raised to the highest marker seen
+	static void DeserializeSyncResult(const FString& resultString, TArray<FNeo4jNode>& outChangedNodes, TArray<int>& outDeletedIDs,
+		int64& inOutMarker);
+
+
+	//paths returned as [[id, labels, properties]...], [[id, type, start id, end id, properties]...] rows
+	static TArray<FNeo4jPath> DeserializePathQueryResult(const FString& resultString);
+
+
+	//rows of [source id, [[id, labels, properties, relationship type, relationship id, outgoing]...]]
+	static TMap<int, FNeo4jNeighbourList> DeserializeNeighbourBatchResult(const FString& resultString);
+
+
+	//reads the three statement response sent by GetSubgraphByLabels: nodes with labels, relationships, clock value
+	static bool DeserializeSubgraphQueryResult(const FString& resultString, FNeo4jSubgraph& outSubgraph);
+
+	//reads the clock value returned by the first statement of a response. Returns false if there is none
+	static bool DeserializeSyncClock(const FString& resultString, int64& outClock);
+
+
 	//returns FNeo4jNode Struct as a string inluding all labels and properties
 	static FString SerializeNode(FNeo4jNode inNode);
 
+
+	//gzips a request body. Returns false if compression failed
+	static bool CompressPayload(const TArray<uint8>& inPayload, TArray<uint8>& outCompressed);
+
+	//inflates a body sent with the given Content-Encoding (gzip or deflate), handing each inflated chunk to onChunk as soon
+	//as zlib produces it. Fails if the body is not encoded that way, decodes to more than maxDecompressedBytes or onChunk
+	//returns false
+	static bool DecompressPayload(const TArray<uint8>& inPayload, const FString& contentEncoding, int64 maxDecompressedBytes,
+		TFunctionRef<bool(const uint8* chunk, int32 chunkSize)> onChunk);
+
+	//DecompressPayload straight into the string the result parsers read, one chunk of utf-8 at a time.
+	//outInflatedAny tells a body that is not encoded apart from one that broke or grew too large part way
+	static bool DecompressPayloadToString(const TArray<uint8>& inPayload, const FString& contentEncoding, int64 maxDecompressedBytes,
+		FString& outContent, bool& outInflatedAny);
+
 	
 };
@@ -0,0 +1,565 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Neo4jBenchmarkCommandlet.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProperties.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformTLS.h"
+#include "Misc/DateTime.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Neo4jFilters.h"
+#include "Neo4jJsonWriter.h"
+#include "Neo4jUtilities.h"
+
+
+#pragma region ALLOCATION_COUNTING
+
+//forwards to the real allocator and counts the allocations the measuring thread makes between BeginCounting and
+//EndCounting. Installed once for the whole run: swapping GMalloc while other threads allocate isn't safe
+class FNeo4jCountingMalloc : public FMalloc
+{
+public:
+
+	explicit FNeo4jCountingMalloc(FMalloc* inInner)
+		: inner(inInner)
+	{
+	}
+
+	virtual void* Malloc(SIZE_T count, uint32 alignment) override
+	{
+		void* result = inner->Malloc(count, alignment);
+		_OnAllocated(result, count);
+		return result;
+	}
+
+	virtual void* Realloc(void* original, SIZE_T count, uint32 alignment) override
+	{
+		_OnFreed(original);
+		void* result = inner->Realloc(original, count, alignment);
+		if (count > 0)
+			_OnAllocated(result, count);
+		return result;
+	}
+
+	virtual void Free(void* original) override
+	{
+		_OnFreed(original);
+		inner->Free(original);
+	}
+
+	virtual bool GetAllocationSize(void* original, SIZE_T& sizeOut) override { return inner->GetAllocationSize(original, sizeOut); }
+	virtual SIZE_T QuantizeSize(SIZE_T count, uint32 alignment) override { return inner->QuantizeSize(count, alignment); }
+	virtual void SetupTLSCachesOnCurrentThread() override { inner->SetupTLSCachesOnCurrentThread(); }
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override { inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+	virtual bool IsInternallyThreadSafe() const override { return inner->IsInternallyThreadSafe(); }
+	virtual const TCHAR* GetDescriptiveName() override { return TEXT("Neo4jCountingMalloc"); }
+
+	//wraps GMalloc on first use and stays installed, blocks may be freed through it long after the last measurement
+	static FNeo4jCountingMalloc& Get()
+	{
+		static FNeo4jCountingMalloc* instance = nullptr;
+		if (!instance)
+		{
+			instance = new FNeo4jCountingMalloc(GMalloc);
+			GMalloc = instance;
+		}
+		return *instance;
+	}
+
+	//starts counting the calling thread's allocations, other threads are never counted
+	void BeginCounting()
+	{
+		numAllocations = 0;
+		liveBytes = 0;
+		peakBytes = 0;
+		countingThreadId = FPlatformTLS::GetCurrentThreadId();
+		bCounting = true;
+	}
+
+	void EndCounting()
+	{
+		bCounting = false;
+		liveBlocks.Empty();
+	}
+
+	int64 GetNumAllocations() const { return numAllocations; }
+
+	//highest total size of blocks allocated since BeginCounting and still alive
+	int64 GetPeakBytes() const { return peakBytes; }
+
+private:
+
+	bool _IsCounting() const
+	{
+		return bCounting && !bTracking && countingThreadId == FPlatformTLS::GetCurrentThreadId();
+	}
+
+	void _OnAllocated(void* pointer, SIZE_T size)
+	{
+		if (!pointer || !_IsCounting())
+			return;
+
+		//the block map allocates through here too
+		TGuardValue<bool> tracking(bTracking, true);
+
+		numAllocations++;
+		liveBlocks.Add(pointer, size);
+		liveBytes += size;
+		peakBytes = FMath::Max(peakBytes, liveBytes);
+	}
+
+	void _OnFreed(void* pointer)
+	{
+		if (!pointer || !_IsCounting())
+			return;
+
+		TGuardValue<bool> tracking(bTracking, true);
+
+		//blocks from before BeginCounting aren't in the map and don't lower the count
+		SIZE_T size = 0;
+		if (liveBlocks.RemoveAndCopyValue(pointer, size))
+			liveBytes -= size;
+	}
+
+	FMalloc* inner;
+
+	//read by every thread, only written by the measuring one
+	volatile bool bCounting = false;
+	volatile uint32 countingThreadId = 0;
+
+	//only touched by the measuring thread
+	bool bTracking = false;
+	int64 numAllocations = 0;
+	int64 liveBytes = 0;
+	int64 peakBytes = 0;
+	TMap<void*, SIZE_T> liveBlocks;
+};
+
+#pragma endregion ALLOCATION_COUNTING
+
+
+#pragma region PAYLOADS
+
+//one input the benchmarks run over
+struct FNeo4jBenchmarkPayload
+{
+	FString name;
+
+	//recorded or synthetic neo4j response, empty for request-only payloads
+	FString response;
+
+	int64 responseBytes = 0;
+
+	int64 rows = 0;
+
+	//properties the filter benchmarks read, picked from the payload's first row
+	FString intProperty;
+	FString stringProperty;
+};
+
+struct FNeo4jBenchmarkResult
+{
+	FString benchmark;
+	FString payload;
+
+	int32 iterations = 0;
+	double bestSeconds = 0.0;
+	double meanSeconds = 0.0;
+
+	int64 inputBytes = 0;
+	int64 rows = 0;
+
+	int64 allocations = 0;
+	int64 peakBytes = 0;
+};
+
+//narrow rows carry an id and a name, wide ones add numbered properties of every type
+static FString _MakeNodeResponse(int64 targetBytes, int32 numProperties, int64& outRows)
+{
+	TArray<uint8> body;
+	body.Reserve(targetBytes + 4096);
+
+	FNeo4jJsonWriter writer(body);
+	writer.BeginObject();
+	writer.WriteKey(TEXT("results"));
+	writer.BeginArray();
+	writer.BeginObject();
+	writer.WriteKey(TEXT("columns"));
+	writer.BeginArray();
+	writer.WriteString(TEXT("m"));
+	writer.EndArray();
+	writer.WriteKey(TEXT("data"));
+	writer.BeginArray();
+
+	outRows = 0;
+	while (body.Num() < targetBytes)
+	{
+		writer.BeginObject();
+		writer.WriteKey(TEXT("row"));
+		writer.BeginArray();
+		writer.BeginObject();
+		writer.WriteKey(TEXT("id"));
+		writer.WriteInt(outRows);
+		writer.WriteKey(TEXT("name"));
+		writer.WriteString(FString::Printf(TEXT("node_%lld"), outRows));
+
+		for (int32 i = 0; i < numProperties - 2; i++)
+		{
+			writer.WriteKey(FString::Printf(TEXT("p%d"), i));
+			switch (i % 4)
+			{
+			case 0:		writer.WriteInt(outRows * 31 + i); break;
+			case 1:		writer.WriteNumber(outRows * 0.5 + i + 0.25); break;
+			case 2:		writer.WriteBool((outRows + i) % 2 == 0); break;
+			default:	writer.WriteString(FString::Printf(TEXT("value_%d_%lld"), i, outRows)); break;
+			}
+		}
+
+		writer.EndObject();
+		writer.EndArray();
+		writer.WriteKey(TEXT("meta"));
+		writer.BeginArray();
+		writer.BeginObject();
+		writer.WriteKey(TEXT("id"));
+		writer.WriteInt(outRows);
+		writer.WriteKey(TEXT("type"));
+		writer.WriteString(TEXT("node"));
+		writer.WriteKey(TEXT("deleted"));
+		writer.WriteBool(false);
+		writer.EndObject();
+		writer.EndArray();
+		writer.EndObject();
+
+		outRows++;
+	}
+
+	writer.EndArray();
+	writer.EndObject();
+	writer.EndArray();
+	writer.WriteKey(TEXT("errors"));
+	writer.BeginArray();
+	writer.EndArray();
+	writer.EndObject();
+
+	FUTF8ToTCHAR converter((const ANSICHAR*)body.GetData(), body.Num());
+	return FString(converter.Length(), converter.Get());
+}
+
+//fills the filter properties from the first parsed row
+static void _PickFilterProperties(FNeo4jBenchmarkPayload& payload, const TArray<FNeo4jNode>& nodes)
+{
+	if (nodes.Num() == 0)
+		return;
+
+	for (auto& property : nodes[0].properties)
+	{
+		if (!property.Value.IsValid())
+			continue;
+
+		if (payload.intProperty.IsEmpty() && property.Value->Type == EJson::Number)
+			payload.intProperty = property.Key;
+		else if (payload.stringProperty.IsEmpty() && property.Value->Type == EJson::String)
+			payload.stringProperty = property.Key;
+	}
+}
+
+static FString _FormatBytes(int64 bytes)
+{
+	if (bytes >= 1024 * 1024)
+		return FString::Printf(TEXT("%lldMB"), bytes / (1024 * 1024));
+
+	return FString::Printf(TEXT("%lldKB"), FMath::Max<int64>(1, bytes / 1024));
+}
+
+#pragma endregion PAYLOADS
+
+
+#pragma region MEASUREMENT
+
+//timed iterations first, then one more with the counting allocator installed so counting doesn't skew the timings
+static FNeo4jBenchmarkResult _Measure(const FString& benchmark, const FString& payload, int64 inputBytes, int64 rows,
+	double minSeconds, int32 minIterations, TFunctionRef<void()> body)
+{
+	FNeo4jBenchmarkResult result;
+	result.benchmark = benchmark;
+	result.payload = payload;
+	result.inputBytes = inputBytes;
+	result.rows = rows;
+	result.bestSeconds = TNumericLimits<double>::Max();
+
+	//warm up caches and lazily built statics
+	body();
+
+	double totalSeconds = 0.0;
+	while ((totalSeconds < minSeconds || result.iterations < minIterations) && result.iterations < 10000)
+	{
+		double start = FPlatformTime::Seconds();
+		body();
+		double elapsed = FPlatformTime::Seconds() - start;
+
+		totalSeconds += elapsed;
+		result.bestSeconds = FMath::Min(result.bestSeconds, elapsed);
+		result.iterations++;
+	}
+
+	result.meanSeconds = totalSeconds / result.iterations;
+
+	FNeo4jCountingMalloc& countingMalloc = FNeo4jCountingMalloc::Get();
+	countingMalloc.BeginCounting();
+	body();
+	countingMalloc.EndCounting();
+
+	result.allocations = countingMalloc.GetNumAllocations();
+	result.peakBytes = countingMalloc.GetPeakBytes();
+
+	double megabytesPerSecond = inputBytes > 0 ? (inputBytes / (1024.0 * 1024.0)) / result.bestSeconds : 0.0;
+	double rowsPerSecond = rows > 0 ? rows / result.bestSeconds : 0.0;
+	UE_LOG(LogTemp, Display, TEXT("%-36s %-20s %10.2f MB/s %14.0f rows/s %8.2f allocs/row %10lld peak bytes"), *benchmark, *payload,
+		megabytesPerSecond, rowsPerSecond, rows > 0 ? (double)result.allocations / rows : 0.0, result.peakBytes);
+
+	return result;
+}
+
+static bool _WriteResults(const FString& outPath, const TArray<FNeo4jBenchmarkResult>& results)
+{
+	TArray<uint8> body;
+	FNeo4jJsonWriter writer(body);
+
+	writer.BeginObject();
+	writer.WriteKey(TEXT("timestamp"));
+	writer.WriteString(FDateTime::UtcNow().ToIso8601());
+	writer.WriteKey(TEXT("engineVersion"));
+	writer.WriteString(FEngineVersion::Current().ToString());
+	writer.WriteKey(TEXT("platform"));
+	writer.WriteString(ANSI_TO_TCHAR(FPlatformProperties::IniPlatformName()));
+
+	writer.WriteKey(TEXT("results"));
+	writer.BeginArray();
+	for (auto& result : results)
+	{
+		writer.BeginObject();
+		writer.WriteKey(TEXT("benchmark"));
+		writer.WriteString(result.benchmark);
+		writer.WriteKey(TEXT("payload"));
+		writer.WriteString(result.payload);
+		writer.WriteKey(TEXT("iterations"));
+		writer.WriteInt(result.iterations);
+		writer.WriteKey(TEXT("bestSeconds"));
+		writer.WriteNumber(result.bestSeconds);
+		writer.WriteKey(TEXT("meanSeconds"));
+		writer.WriteNumber(result.meanSeconds);
+		writer.WriteKey(TEXT("inputBytes"));
+		writer.WriteInt(result.inputBytes);
+		writer.WriteKey(TEXT("rows"));
+		writer.WriteInt(result.rows);
+		writer.WriteKey(TEXT("megabytesPerSecond"));
+		writer.WriteNumber(result.inputBytes > 0 ? (result.inputBytes / (1024.0 * 1024.0)) / result.bestSeconds : 0.0);
+		writer.WriteKey(TEXT("rowsPerSecond"));
+		writer.WriteNumber(result.rows > 0 ? result.rows / result.bestSeconds : 0.0);
+		writer.WriteKey(TEXT("allocations"));
+		writer.WriteInt(result.allocations);
+		writer.WriteKey(TEXT("allocationsPerRow"));
+		writer.WriteNumber(result.rows > 0 ? (double)result.allocations / result.rows : 0.0);
+		writer.WriteKey(TEXT("peakBytes"));
+		writer.WriteInt(result.peakBytes);
+		writer.EndObject();
+	}
+	writer.EndArray();
+	writer.EndObject();
+
+	return FFileHelper::SaveArrayToFile(body, *outPath);
+}
+
+#pragma endregion MEASUREMENT
+
+
+UNeo4jBenchmarkCommandlet::UNeo4jBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UNeo4jBenchmarkCommandlet::Main(const FString& Params)
+{
+	//before anything else runs, so GMalloc never changes under a thread mid-run
+	FNeo4jCountingMalloc::Get();
+
+	FString corpusDirectory;
+	FParse::Value(*Params, TEXT("corpus="), corpusDirectory);
+
+	FString outPath = FPaths::ProjectSavedDir() / TEXT("Neo4jBenchmark") / (FDateTime::Now().ToString() + TEXT(".json"));
+	FParse::Value(*Params, TEXT("out="), outPath);
+
+	int32 maxMegabytes = 100;
+	FParse::Value(*Params, TEXT("maxmb="), maxMegabytes);
+
+	float minSeconds = 0.5f;
+	FParse::Value(*Params, TEXT("mintime="), minSeconds);
+
+	int32 minIterations = 3;
+	FParse::Value(*Params, TEXT("iterations="), minIterations);
+
+	const int64 maxBytes = (int64)maxMegabytes * 1024 * 1024;
+	const int64 sizes[] = { 1024, 64 * 1024, 1024 * 1024, 16 * 1024 * 1024, 100 * 1024 * 1024 };
+	const int32 widths[] = { 2, 64 };
+
+	//synthetic responses, narrow and wide at every size
+	TArray<FNeo4jBenchmarkPayload> payloads;
+	for (int64 size : sizes)
+	{
+		if (size > maxBytes)
+			continue;
+
+		for (int32 width : widths)
+		{
+			FNeo4jBenchmarkPayload& payload = payloads.AddDefaulted_GetRef();
+			payload.name = FString::Printf(TEXT("synthetic_%s_%s"), *_FormatBytes(size), width > 2 ? TEXT("wide") : TEXT("narrow"));
+			payload.response = _MakeNodeResponse(size, width, payload.rows);
+			payload.responseBytes = FTCHARToUTF8(*payload.response).Length();
+		}
+	}
+
+	//recorded responses, rows are counted by parsing them once
+	if (!corpusDirectory.IsEmpty())
+	{
+		TArray<FString> files;
+		IFileManager::Get().FindFiles(files, *(corpusDirectory / TEXT("*.json")), true, false);
+
+		for (auto& file : files)
+		{
+			FNeo4jBenchmarkPayload payload;
+			payload.name = FPaths::GetBaseFilename(file);
+			if (!FFileHelper::LoadFileToString(payload.response, *(corpusDirectory / file)))
+			{
+				UE_LOG(LogTemp, Error, TEXT("Could not read %s"), *file);
+				continue;
+			}
+
+			payload.responseBytes = IFileManager::Get().FileSize(*(corpusDirectory / file));
+			payload.rows = UNeo4jUtilities::DeserializeNodeQueryResult(payload.response).Num();
+			payloads.Add(MoveTemp(payload));
+		}
+	}
+
+	TArray<FNeo4jBenchmarkResult> results;
+
+	for (auto& payload : payloads)
+	{
+		TArray<FNeo4jNode> nodes;
+		results.Add(_Measure(TEXT("DeserializeNodeQueryResult"), payload.name, payload.responseBytes, payload.rows, minSeconds, minIterations, [&]()
+		{
+			nodes = UNeo4jUtilities::DeserializeNodeQueryResult(payload.response);
+		}));
+
+		_PickFilterProperties(payload, nodes);
+
+		if (!payload.intProperty.IsEmpty())
+		{
+			TArray<int> values;
+			TArray<bool> valid;
+			results.Add(_Measure(TEXT("Filters.ExtractIntProperty"), payload.name, 0, nodes.Num(), minSeconds, minIterations, [&]()
+			{
+				UNeo4jFilters::ExtractIntProperty(nodes, payload.intProperty, values, valid);
+			}));
+
+			results.Add(_Measure(TEXT("Filters.FilterIntProperty"), payload.name, 0, nodes.Num(), minSeconds, minIterations, [&]()
+			{
+				int sum = 0;
+				for (auto& node : nodes)
+					sum += UNeo4jFilters::FilterIntProperty(node, payload.intProperty);
+				values.Add(sum);
+			}));
+		}
+
+		if (!payload.stringProperty.IsEmpty())
+		{
+			TArray<FString> values;
+			TArray<bool> valid;
+			results.Add(_Measure(TEXT("Filters.ExtractStringProperty"), payload.name, 0, nodes.Num(), minSeconds, minIterations, [&]()
+			{
+				UNeo4jFilters::ExtractStringProperty(nodes, payload.stringProperty, values, valid);
+			}));
+		}
+	}
+
+	//request side, the same property maps serialized many times per iteration
+	const int32 numRequests = 10000;
+	for (int32 width : widths)
+	{
+		TMap<FString, FString> stringProperties;
+		TMap<FString, int> intProperties;
+		TMap<FString, bool> boolProperties;
+		for (int32 i = 0; i < width; i++)
+		{
+			switch (i % 3)
+			{
+			case 0:		stringProperties.Add(FString::Printf(TEXT("s%d"), i), FString::Printf(TEXT("value_%d"), i)); break;
+			case 1:		intProperties.Add(FString::Printf(TEXT("i%d"), i), i * 31); break;
+			default:	boolProperties.Add(FString::Printf(TEXT("b%d"), i), i % 2 == 0); break;
+			}
+		}
+
+		FString name = width > 2 ? TEXT("properties_wide") : TEXT("properties_narrow");
+		int64 outputBytes = UNeo4jUtilities::SerializePropertiesIntoQuery(stringProperties, intProperties, boolProperties).Len() * (int64)numRequests;
+		results.Add(_Measure(TEXT("SerializePropertiesIntoQuery"), name, outputBytes, numRequests, minSeconds, minIterations, [&]()
+		{
+			for (int32 i = 0; i < numRequests; i++)
+				UNeo4jUtilities::SerializePropertiesIntoQuery(stringProperties, intProperties, boolProperties);
+		}));
+
+		TArray<FString> labels;
+		for (int32 i = 0; i < FMath::Min(width, 8); i++)
+			labels.Add(FString::Printf(TEXT("Label%d"), i));
+
+		results.Add(_Measure(TEXT("SerializeLabelsIntoQuery"), width > 2 ? TEXT("labels_8") : TEXT("labels_2"), 0, numRequests, minSeconds, minIterations, [&]()
+		{
+			for (int32 i = 0; i < numRequests; i++)
+				UNeo4jUtilities::SerializeLabelsIntoQuery(labels);
+		}));
+	}
+
+	//request bodies from 1 KB up, the json dom path against the streaming writer
+	for (int64 size : sizes)
+	{
+		if (size > maxBytes)
+			continue;
+
+		FString statement;
+		statement.Reserve(size);
+		for (int64 i = 0; statement.Len() < size; i++)
+			statement += FString::Printf(TEXT("match (m) where id(m) = %lld set m.\"name\" = 'node_%lld'\n"), i, i);
+
+		FString name = FString::Printf(TEXT("statement_%s"), *_FormatBytes(size));
+		results.Add(_Measure(TEXT("_ConstructJSONQueryString"), name, size, 0, minSeconds, minIterations, [&]()
+		{
+			FString body = UNeo4jUtilities::_ConstructJSONQueryString(statement);
+			FTCHARToUTF8 utf8Body(*body);
+		}));
+
+		TArray<uint8> body;
+		results.Add(_Measure(TEXT("FNeo4jJsonWriter"), name, size, 0, minSeconds, minIterations, [&]()
+		{
+			body.Reset();
+			FNeo4jJsonWriter writer(body);
+			writer.BeginStatements();
+			writer.WriteStatement(statement);
+			writer.EndStatements();
+		}));
+	}
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(outPath), true);
+	if (!_WriteResults(outPath, results))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Could not write benchmark results to %s"), *outPath);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Wrote %d benchmark results to %s"), results.Num(), *outPath);
+	return 0;
+}
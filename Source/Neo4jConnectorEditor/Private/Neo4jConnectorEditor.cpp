@@ -0,0 +1,17 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Neo4jConnectorEditor.h"
+
+#define LOCTEXT_NAMESPACE "FNeo4jConnectorEditorModule"
+
+void FNeo4jConnectorEditorModule::StartupModule()
+{
+}
+
+void FNeo4jConnectorEditorModule::ShutdownModule()
+{
+}
+
+#undef LOCTEXT_NAMESPACE
+
+IMPLEMENT_MODULE(FNeo4jConnectorEditorModule, Neo4jConnectorEditor)
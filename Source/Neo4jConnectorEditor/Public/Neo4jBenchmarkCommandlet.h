@@ -0,0 +1,28 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "Neo4jBenchmarkCommandlet.generated.h"
+
+
+/**
+* Measures the cpu cost of the (de)serialization code without a server.
+* Runs over synthetic responses/requests from 1 KB up to -maxmb and over any recorded *.json responses in -corpus,
+* and writes throughput, allocations per row and peak memory to -out as json so runs can be compared across versions.
+*
+* UE4Editor-Cmd <project> -run=Neo4jBenchmark [-corpus=<dir>] [-out=<file>] [-maxmb=100] [-mintime=0.5] [-iterations=3]
+*/
+UCLASS()
+class NEO4JCONNECTOREDITOR_API UNeo4jBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	UNeo4jBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+};